@@ -0,0 +1,46 @@
+#include <golv/games/deal_generator.hpp>
+#include <golv/games/skat_endgame.hpp>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string>
+
+namespace {
+
+constexpr std::array<std::pair<golv::trump, char const*>, 5> trumps{{{golv::trump::diamonds, "diamonds"},
+                                                                      {golv::trump::hearts, "hearts"},
+                                                                      {golv::trump::spades, "spades"},
+                                                                      {golv::trump::clubs, "clubs"},
+                                                                      {golv::trump::grand, "grand"}}};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::cout << "Usage: skat_endgame_generator <directory> [cards per player = 2] [threads = all]" << std::endl;
+    std::cout << "Writes skat_endgame_<trump>.golv for the full deck and all trumps." << std::endl;
+    return 1;
+  }
+  std::string const directory = argv[1];
+  unsigned const max_cards = argc > 2 ? static_cast<unsigned>(std::stoul(argv[2])) : 2;
+  size_t const threads = argc > 3 ? std::stoul(argv[3]) : 0;
+
+  auto const deck = golv::hand_to_mask(golv::create_skat_deck());
+  size_t positions = 0;
+  for (unsigned k = 1; k <= max_cards; ++k) positions += golv::skat_endgame_table::positions(32, k);
+  std::cout << positions << " positions (bytes) per trump" << std::endl;
+
+  try {
+    for (auto const& [t, name] : trumps) {
+      auto const start = std::chrono::steady_clock::now();
+      auto const table = golv::skat_endgame_table::generate(deck, t, max_cards, threads);
+      auto const path = directory + "/skat_endgame_" + name + ".golv";
+      table.save(path);
+      auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      std::cout << path << " in " << seconds << " s" << std::endl;
+    }
+  } catch (std::exception const& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
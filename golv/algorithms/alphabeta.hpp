@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <golv/algorithms/move_ordering.hpp>
+#include <golv/algorithms/search_stats.hpp>
 #include <golv/algorithms/unordered_table.hpp>
+#include <golv/traits/endgame_table.hpp>
 #include <golv/traits/game.hpp>
 #include <golv/util/logging.hpp>
 #include <iostream>
@@ -18,8 +20,11 @@ namespace golv {
  *  MoveOrderingT is a less-than ordering for GameT::move_type (typically an integer, but can be different as long as
  * either std::less is defined for the type or a user-defined ordering given.
  *  TableT satisfies concept TranspositionTable.
+ *  StatsT is search_stats or no_search_stats (see search_stats.hpp).
+ *  EndgameT satisfies concept EndgameTable, its values replace the search below the root.
  */
-template <Game GameT, typename MoveOrderingT = no_ordering, TranspositionTable<GameT> TableT = no_table<GameT>>
+template <Game GameT, typename MoveOrderingT = no_ordering, TranspositionTable<GameT> TableT = no_table<GameT>,
+          typename StatsT = no_search_stats, EndgameTable<GameT> EndgameT = no_endgame_table<GameT>>
 class alpha_beta {
  public:
   using game_type = GameT;
@@ -27,43 +32,73 @@ class alpha_beta {
   using move_type = typename game_type::move_type;
   using move_ordering_type = MoveOrderingT;
   using table_type = TableT;
+  using stats_type = StatsT;
+  using endgame_type = EndgameT;
 
   constexpr static value_type min_value = std::numeric_limits<value_type>::lowest() / 2;
   constexpr static value_type max_value = std::numeric_limits<value_type>::max() / 2;
 
-  alpha_beta(GameT game, MoveOrderingT move_ordering = no_ordering{}, TableT table = no_table<game_type>{})
-      : game_(game), move_ordering_(move_ordering), table_(table) {}
+  alpha_beta(GameT game, MoveOrderingT move_ordering = no_ordering{}, TableT table = no_table<game_type>{},
+             StatsT stats = no_search_stats{}, EndgameT endgame = no_endgame_table<game_type>{})
+      : game_(game), move_ordering_(move_ordering), table_(table), stats_(stats), endgame_(std::move(endgame)) {}
 
   auto solve() -> value_type {
     best_move_ = move_type{};
-    return _solve(min_value, max_value, 0);
+    stats_.start();
+    auto value = _solve(min_value, max_value, 0);
+    stats_.stop();
+    return value;
   }
 
-  auto mws_solve(value_type b) -> value_type { return _solve(b - 1, b, 0); }
+  auto mws_solve(value_type b) -> value_type {
+    stats_.start();
+    auto value = _solve(b - 1, b, 0);
+    stats_.stop();
+    return value;
+  }
 
   move_type best_move() const { return best_move_; }
 
   TableT const& get_table() const { return table_; }
 
+  StatsT const& stats() const { return stats_; }
+
+  /**
+   * Count a re-search (e. g. by mtd_f).
+   */
+  void re_search() { stats_.re_search(); }
+
  private:
   auto _solve(value_type a, value_type b, int depth) -> value_type {
+    stats_.node(depth);
     if (game_.is_terminal()) {
       return 0;
     }
 
+    if constexpr (with_endgame_table<endgame_type>::value) {
+      if (depth > 0) {
+        if (auto const rest = endgame_.probe(game_)) return *rest;
+      }
+    }
+
     value_type opt = game_.is_max() ? min_value : max_value;
     value_type old_a = a, old_b = b;
 
+    _count_probe();
     auto l = lookup_before<game_type, table_type>(table_, game_, a, b);
-    if (l.first) return l.second;
+    if (l.first) {
+      stats_.tt_cutoff();
+      return l.second;
+    }
 
     auto legal_actions = game_.legal_actions();
 
     if constexpr (with_ordering<move_ordering_type>::value) {
-      std::sort(std::begin(legal_actions), std::end(legal_actions), move_ordering_);
+      sort_moves(legal_actions, move_ordering_);
     }
 
-    for (auto const& move : legal_actions) {
+    for (size_t i = 0; i < legal_actions.size(); ++i) {
+      auto const& move = legal_actions[i];
       value_type prev_value = game_.value();
       game_.apply_action(move);
       value_type move_value = game_.value() - prev_value;
@@ -84,6 +119,7 @@ class alpha_beta {
         b = std::min(b, value);
       }
       if (a >= b) {
+        stats_.cutoff(i);
         if (game_.is_max()) {
           _save_value(lookup_value_type::lower_bound, value);
           return a;
@@ -101,6 +137,12 @@ class alpha_beta {
     return game_.is_max() ? a : b;
   }
 
+  void _count_probe() {
+    if constexpr (with_stats<stats_type>::value && with_table<table_type>::value) {
+      if (table_.is_memorable(game_)) stats_.tt_probe();
+    }
+  }
+
   void _save_value(lookup_value_type type, value_type value) {
     if constexpr (with_table<table_type>::value) {
       if (table_.is_memorable(game_)) {
@@ -112,6 +154,8 @@ class alpha_beta {
   game_type game_;
   move_ordering_type move_ordering_;
   table_type table_;
+  [[no_unique_address]] stats_type stats_;
+  [[no_unique_address]] endgame_type endgame_;
   move_type best_move_;
 };
 
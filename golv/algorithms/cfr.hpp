@@ -1,13 +1,38 @@
 #pragma once
 
+#include <golv/algorithms/search_stats.hpp>
 #include <golv/traits/game.hpp>
+#include <golv/util/exception.hpp>
 #include <golv/util/logging.hpp>
+#include <golv/util/simd.hpp>
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
 #include <numeric>
 #include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace golv {
 
-template <Game GameT>
+namespace detail {
+
+template <class GameT>
+constexpr int num_hands_v = 1;
+
+template <PublicTreeGame GameT>
+constexpr int num_hands_v<GameT> = GameT::num_hands;
+
+}  // namespace detail
+
+/**
+ * cfr is the counterfactual regret minimization solver.
+ *  StatsT is search_stats or no_search_stats (see search_stats.hpp); the nodes are counted over all iterations.
+ */
+template <Game GameT, typename StatsT = no_search_stats>
 class cfr {
   public:
     using game_type = GameT;
@@ -17,40 +42,43 @@ class cfr {
 
     constexpr static double threshold = 1e-6;
 
+    /**
+     * Maximum number of actions per information set (size of the stack buffers of the traversal).
+     */
+    constexpr static size_t max_actions = 64;
+
+    /**
+     * The regret and strategy sums of a node are views into the value arena of the solver,
+     * such that the kernels of golv/util/simd.hpp work on contiguous memory.
+     */
     struct node {
       game_type::move_range actions;
-      strategy_type regret_sum;
-      strategy_type strategy_sum;
+      std::span<double> regret_sum;
+      std::span<double> strategy_sum;
 
-      node(game_type::move_range const& _actions) : actions(_actions) {
-        regret_sum = std::vector<double>(actions.size(), 0.0);
-        strategy_sum = std::vector<double>(actions.size(), 0.0);
-      }
+      node(game_type::move_range const& _actions, std::span<double> _regret_sum, std::span<double> _strategy_sum)
+          : actions(_actions), regret_sum(_regret_sum), strategy_sum(_strategy_sum) {}
 
       size_t size() const { return actions.size(); }
 
+      /**
+       * Write the current (regret matching) strategy into out[0, size()).
+       */
+      void strategy(double* out) const { simd::regret_matching(regret_sum.data(), out, size(), threshold); }
+
+      void avg_strategy(double* out) const { simd::normalize(strategy_sum.data(), out, size(), threshold); }
+
       strategy_type strategy() const {
-        auto strat = regret_sum;
-        std::transform(std::begin(strat), std::end(strat), std::begin(strat), [](auto s) { return std::max(s, 0.0); });
-        auto sum = std::accumulate(std::begin(strat), std::end(strat), 0.0);
-        if (sum > threshold) {
-          std::transform(std::begin(strat), std::end(strat), std::begin(strat), [sum](auto s) { return s / sum; });
-          return strat;
-        } else
-          return _default_strategy();
+        strategy_type strat(size());
+        strategy(strat.data());
+        return strat;
       }
 
       strategy_type avg_strategy() const {
-        auto strat = strategy_sum;
-        auto sum = std::accumulate(std::begin(strategy_sum), std::end(strategy_sum), 0.0);
-        if (sum > threshold) {
-          std::transform(std::begin(strat), std::end(strat), std::begin(strat), [sum](auto s) { return s / sum; });
-          return strat;
-        } else
-          return _default_strategy();
+        strategy_type strat(size());
+        avg_strategy(strat.data());
+        return strat;
       }
-
-      strategy_type _default_strategy() const { return std::vector<double>(size(), 1.0 / size()); }
     };
 
     using map_type = std::map<information_set_type, node>;
@@ -60,7 +88,23 @@ class cfr {
 
     cfr(GameT game) : game_(game) {}
 
+    // nodes point into the arena of this solver
+    cfr(cfr const&) = delete;
+    cfr& operator=(cfr const&) = delete;
+    cfr(cfr&&) = default;
+    cfr& operator=(cfr&&) = default;
+
     auto solve(int iterations = 1000) -> value_type {
+      return solve(iterations, [](cfr const&) {});
+    }
+
+    /**
+     * Run the given number of iterations and call after_iteration(*this) after each of them,
+     * e. g. to take periodic checkpoints (see cfr_checkpoint.hpp).
+     */
+    template <class CallbackT>
+    auto solve(int iterations, CallbackT&& after_iteration) -> value_type {
+      stats_.start();
       strategy_type util(num_players, 0.0);
       for (int i = 0; i < iterations; ++i) {
         GOLV_LOG_TRACE("Iteration = " << i);
@@ -70,19 +114,219 @@ class cfr {
           game_.set_max(j);
           util[j] += _solve();
         }
+        ++iterations_;
+        after_iteration(*this);
         GOLV_LOG_TRACE("/Iteration");
       }
       for (int j = 0; j < num_players; ++j) {
         util[j] /= iterations;
       }
+      stats_.stop();
       return util[0];
     }
 
+    auto solve_public_tree(int iterations = 1000) -> value_type
+      requires PublicTreeGame<GameT>
+    {
+      return solve_public_tree(iterations, [](cfr const&) {});
+    }
+
+    /**
+     * Vector-form cfr: instead of sampling the deal, walk the public tree once per player and iteration and carry the
+     * reach probabilities of all hands, such that every node is updated for all hands at once (with alternating
+     * updates and exact chance weights). Uses the same information sets as solve(), e. g. for checkpoints.
+     */
+    template <class CallbackT>
+    auto solve_public_tree(int iterations, CallbackT&& after_iteration) -> value_type
+      requires PublicTreeGame<GameT>
+    {
+      stats_.start();
+      value_type value = 0.0;
+      for (int i = 0; i < iterations; ++i) {
+        for (int j = 0; j < num_players; ++j) {
+          game_type game;
+          game.begin_public_tree();
+          std::array<hand_vector, num_players> reach;
+          for (auto& r : reach) {
+            for (int h = 0; h < detail::num_hands_v<GameT>; ++h) r[h] = game.hand_possible(h) ? 1.0 : 0.0;
+          }
+          auto cfv = _walk(game, j, reach);
+          if (j == 0) value += std::accumulate(cfv.begin(), cfv.end(), 0.0);
+        }
+        ++iterations_;
+        after_iteration(*this);
+      }
+      stats_.stop();
+      return value / iterations;
+    }
+
     auto const& map() const { return map_; }
 
+    /**
+     * Total number of iterations, including the ones of a restored checkpoint.
+     */
+    size_t iterations() const { return iterations_; }
+
+    void set_iterations(size_t iterations) { iterations_ = iterations; }
+
+    /**
+     * Insert the node of an information set (or return the existing one), e. g. to restore a checkpoint.
+     */
+    node& insert(information_set_type const& info_set, typename game_type::move_range const& actions) {
+      auto it = map_.find(info_set);
+      if (it == map_.end()) it = _emplace(info_set, actions);
+      return it->second;
+    }
+
+    /**
+     * Bytes allocated for regret and strategy sums.
+     */
+    size_t arena_bytes() const { return regrets_.bytes() + strategies_.bytes(); }
+
+    StatsT const& stats() const { return stats_; }
+
    private:
+    using hand_vector = std::array<double, detail::num_hands_v<GameT>>;
+
+    /**
+     * Counterfactual values of all hands of player for the public state of game, given the reach probabilities of
+     * both players (chance is included in the values).
+     */
+    auto _walk(game_type& game, int player, std::array<hand_vector, num_players> const& reach, int depth = 0)
+        -> hand_vector {
+      stats_.node(depth);
+      constexpr int n = detail::num_hands_v<GameT>;
+      hand_vector cfv{};
+      auto const opponent = 1 - player;
+      if (std::all_of(reach[opponent].begin(), reach[opponent].end(), [](auto r) { return r == 0.0; })) return cfv;
+
+      if (game.is_terminal()) {
+        // dense payoff matrix times the reach of the opponent
+        auto const chance = _root_chance();
+        for (int h = 0; h < n; ++h) {
+          if (!game.hand_possible(h)) continue;
+          double v = 0.0;
+          for (int o = 0; o < n; ++o) {
+            if (reach[opponent][o] == 0.0 || !game_type::hands_compatible(h, o)) continue;
+            v += reach[opponent][o] * (player == 0 ? game.payoff(h, o) : -game.payoff(o, h));
+          }
+          cfv[h] = chance * v;
+        }
+        return cfv;
+      }
+
+      if (game.is_chance_node()) {
+        if constexpr (PublicChanceGame<GameT>) {
+          auto const p = game_type::public_outcome_probability();
+          for (auto outcome : game.public_outcomes()) {
+            auto child = game;
+            child.deal_public(outcome);
+            auto child_reach = reach;
+            for (auto& r : child_reach) {
+              for (int h = 0; h < n; ++h) {
+                if (!child.hand_possible(h)) r[h] = 0.0;
+              }
+            }
+            auto v = _walk(child, player, child_reach, depth + 1);
+            for (int h = 0; h < n; ++h) cfv[h] += p * v[h];
+          }
+          return cfv;
+        } else {
+          throw golv::exception("cfr: public chance nodes are not supported by the game");
+        }
+      }
+
+      auto const current = game.current_player();
+      auto const legal = game.legal_actions();
+      auto const k = legal.size();
+      if (k > max_actions) {
+        throw golv::exception("cfr: too many actions (" + std::to_string(k) + ")");
+      }
+
+      // the nodes of the possible hands, once per information set (hands may share one, e. g. the suits of leduc)
+      std::array<node*, n> nodes;
+      std::array<int, n> hands;
+      std::array<size_t, n> slot_of;  // of a hand into nodes
+      size_t count = 0;
+      size_t slots = 0;
+      for (int h = 0; h < n; ++h) {
+        if (!game.hand_possible(h)) continue;
+        hands[count++] = h;
+        auto* node = &insert(game.information_set(h), legal);
+        auto const slot = static_cast<size_t>(std::find(nodes.begin(), nodes.begin() + slots, node) - nodes.begin());
+        if (slot == slots) nodes[slots++] = node;
+        slot_of[h] = slot;
+      }
+
+      // the sums of the nodes are gathered transposed, [a * n + j] for the j-th node, such that the vector lanes of
+      // the kernels span the nodes instead of the few actions
+      std::array<double, n * max_actions> sums;
+      for (size_t j = 0; j < slots; ++j) {
+        for (size_t a = 0; a < k; ++a) sums[a * n + j] = nodes[j]->regret_sum[a];
+      }
+      std::array<double, n * max_actions> strat;
+      simd::regret_matching_soa(sums.data(), strat.data(), k, slots, n, threshold);
+
+      std::array<hand_vector, max_actions> util;
+      for (size_t a = 0; a < k; ++a) {
+        auto child_reach = reach;
+        for (size_t i = 0; i < count; ++i) child_reach[current][hands[i]] *= strat[a * n + slot_of[hands[i]]];
+        game.apply_action(legal[a]);
+        util[a] = _walk(game, player, child_reach, depth + 1);
+        game.undo_action(legal[a]);
+        if (current == player) {
+          for (size_t i = 0; i < count; ++i) cfv[hands[i]] += strat[a * n + slot_of[hands[i]]] * util[a][hands[i]];
+        } else {
+          for (int h = 0; h < n; ++h) cfv[h] += util[a][h];
+        }
+      }
+
+      if (current == player) {
+        // the updates are linear, so the hands of a node are summed up first
+        std::array<double, n * max_actions> node_action_util;
+        std::array<double, n> node_util{};
+        std::array<double, n> weight{};
+        std::fill_n(node_action_util.begin(), k * n, 0.0);
+        for (size_t i = 0; i < count; ++i) {
+          auto const h = hands[i];
+          auto const j = slot_of[h];
+          for (size_t a = 0; a < k; ++a) node_action_util[a * n + j] += util[a][h];
+          node_util[j] += cfv[h];
+          weight[j] += reach[player][h];
+        }
+        // sums still holds the regret sums
+        simd::accumulate_regrets_soa(sums.data(), node_action_util.data(), node_util.data(), k, slots, n);
+        for (size_t j = 0; j < slots; ++j) {
+          for (size_t a = 0; a < k; ++a) nodes[j]->regret_sum[a] = sums[a * n + j];
+        }
+        for (size_t j = 0; j < slots; ++j) {
+          for (size_t a = 0; a < k; ++a) sums[a * n + j] = nodes[j]->strategy_sum[a];
+        }
+        simd::accumulate_strategy_soa(sums.data(), strat.data(), weight.data(), k, slots, n);
+        for (size_t j = 0; j < slots; ++j) {
+          for (size_t a = 0; a < k; ++a) nodes[j]->strategy_sum[a] = sums[a * n + j];
+        }
+      }
+      return cfv;
+    }
+
+    /**
+     * Probability of each compatible pair of hands.
+     */
+    static double _root_chance() {
+      static double const chance = [] {
+        int pairs = 0;
+        for (int h = 0; h < detail::num_hands_v<GameT>; ++h) {
+          for (int o = 0; o < detail::num_hands_v<GameT>; ++o) pairs += game_type::hands_compatible(h, o) ? 1 : 0;
+        }
+        return 1.0 / pairs;
+      }();
+      return chance;
+    }
+
     auto _solve(int depth = 0) -> value_type {
       GOLV_LOG_INFO("depth = " << depth);
+      stats_.node(depth);
       if (game_.is_terminal()) return game_.value();
       if (game_.is_chance_node()) {
         return _handle_chance_node(depth);
@@ -102,71 +346,91 @@ class cfr {
       return _solve(depth + 1);
     }
 
+    /**
+     * Bump allocator for the regret and strategy sums. Blocks are never moved or freed
+     * while the solver lives, so the spans of the nodes stay valid.
+     */
+    class value_arena {
+     public:
+      constexpr static size_t block_size = 512;
+
+      std::span<double> allocate(size_t n) {
+        if (blocks_.empty() || used_ + n > block_capacity_) {
+          block_capacity_ = std::max(block_size, n);
+          blocks_.push_back(std::make_unique<double[]>(block_capacity_));  // zero-initialized
+          capacity_ += block_capacity_;
+          used_ = 0;
+        }
+        std::span<double> values(blocks_.back().get() + used_, n);
+        used_ += n;
+        return values;
+      }
+
+      size_t bytes() const { return capacity_ * sizeof(double); }
+
+     private:
+      std::vector<std::unique_ptr<double[]>> blocks_;
+      size_t block_capacity_ = 0;  // of the last block
+      size_t capacity_ = 0;        // of all blocks
+      size_t used_ = 0;
+    };
+
+    auto _emplace(information_set_type const& info_set, typename game_type::move_range const& actions) {
+      if (actions.size() > max_actions) {
+        throw golv::exception("cfr: too many actions (" + std::to_string(actions.size()) + ")");
+      }
+      return map_.emplace(info_set, node(actions, regrets_.allocate(actions.size()), strategies_.allocate(actions.size())))
+          .first;
+    }
+
     auto _get_node() {
       auto info_set = game_.state();
       auto it = map_.find(info_set);
-      auto legal = game_.legal_actions();
       if (it == map_.end()) {
-        it = map_.insert({info_set, node(legal)}).first;
+        it = _emplace(info_set, game_.legal_actions());
       }
       return it;
     }
 
     auto _traverse_non_max(int depth) -> value_type {
       GOLV_LOG_TRACE("_traverse_non_max");
-      auto it = _get_node();
-      auto strat = it->second.strategy();
-      auto action = _choose_action();  // choose action at random
+      auto& n = _get_node()->second;
+      std::array<double, max_actions> strat;
+      n.strategy(strat.data());
+      auto action = _choose_action(n, strat.data());  // choose action at random
       game_.apply_action(action);
       auto util = _solve(depth + 1);
       game_.undo_action(action);
-      for (size_t i = 0; i < it->second.size(); ++i) {
-        it->second.strategy_sum[i] += strat[i];
-      }
+      simd::accumulate_strategy(n.strategy_sum.data(), strat.data(), 1.0, n.size());
       return util;
     }
 
     auto _traverse_max(int depth) -> value_type {
       GOLV_LOG_TRACE("_traverse_max");
-      auto legal = game_.legal_actions();
-      strategy_type util(legal.size(), 0.0);
+      auto& n = _get_node()->second;
+      std::array<double, max_actions> strat;
+      std::array<double, max_actions> util;
       double node_util = 0.0;
-      auto it = _get_node();
 
-      auto strat = it->second.strategy();
-      for (size_t i = 0; i < legal.size(); ++i) {
-        auto action = legal[i];
+      n.strategy(strat.data());
+      for (size_t i = 0; i < n.size(); ++i) {
+        auto action = n.actions[i];
         game_.apply_action(action);
         util[i] = _solve(depth + 1);
         game_.undo_action(action);
         node_util += strat[i] * util[i];
       }
 
-      for (size_t i = 0; i < it->second.size(); ++i) {
-        double regret = util[i] - node_util;
-        it->second.regret_sum[i] += regret;
-      }
-
+      simd::accumulate_regrets(n.regret_sum.data(), util.data(), node_util, n.size());
       return node_util;
     }
 
     game_type game_;
     map_type map_;
-
-    auto _default_strat() -> strategy_type {
-      auto const _actions = game_.legal_actions();
-      strategy_type default_strat;
-      for (auto& s : default_strat) {
-        s = 1.0 / _actions.size();
-      }
-      return default_strat;
-    }
-
-    auto _accumulated_strat(auto&& strat) -> strategy_type {
-      strategy_type acc;
-      std::partial_sum(std::begin(strat), std::end(strat), std::back_inserter(acc));
-      return acc;
-    }
+    value_arena regrets_;
+    value_arena strategies_;
+    size_t iterations_ = 0;
+    [[no_unique_address]] StatsT stats_;
 
     auto _rnd() -> double {
       static std::random_device rd_;   // Will be used to obtain a seed for the random number engine
@@ -175,23 +439,22 @@ class cfr {
       return dis(gen);
     }
 
-    auto _choose_action() -> move_type {
+    /**
+     * Sample an action of the non-max player according to the (already computed) strategy strat.
+     */
+    auto _choose_action(node const& n, double const* strat) -> move_type {
       GOLV_LOG_TRACE("_choose_action");
-      if (!game_.is_max()) {
-        auto it = _get_node();
-        information_set_type info_set = game_.state();
-        GOLV_LOG_TRACE("info_set = " << info_set);
-        auto const& legal = game_.legal_actions();
-        auto const& strat = it->second.strategy();
-        auto acc = _accumulated_strat(strat);
-        auto choice = _rnd();
-        GOLV_LOG_TRACE("choice = " << choice);
-        auto it2 = std::find_if(std::begin(acc), std::end(acc), [choice](auto s) { return choice < s; });
-        return *(std::begin(legal) + std::distance(std::begin(acc), it2));
-      } else {
+      if (game_.is_max()) {
         throw std::domain_error("Error: Can only choose action for non-max player.");
       }
-      GOLV_LOG_TRACE("/_choose_action");
+      auto choice = _rnd();
+      GOLV_LOG_TRACE("choice = " << choice);
+      double acc = 0.0;
+      for (size_t i = 0; i + 1 < n.size(); ++i) {
+        acc += strat[i];
+        if (choice < acc) return n.actions[i];
+      }
+      return n.actions[n.size() - 1];
     }
 };
 
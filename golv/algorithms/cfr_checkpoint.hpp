@@ -0,0 +1,341 @@
+#pragma once
+
+#include <golv/algorithms/cfr.hpp>
+#include <golv/util/exception.hpp>
+#include <golv/util/logging.hpp>
+#include <golv/util/mapped_file.hpp>
+#include <golv/util/simd.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace golv {
+
+/**
+ * Binary checkpoint format of cfr (all sections are 8-byte aligned, native byte order, readers reject files with a
+ * different byte_order):
+ *
+ *   header
+ *   entry[num_infosets]         sorted by key
+ *   double regret_sum[num_actions]
+ *   double strategy_sum[num_actions]
+ *   move_type actions[num_actions]
+ *
+ * The information sets and moves of the game must be trivially copyable and at most 8 bytes,
+ * e. g. the integer information sets of leduc.
+ */
+struct cfr_checkpoint_header {
+  constexpr static char magic_string[8] = "GOLVCFR";
+  constexpr static std::uint32_t current_version = 2;
+  constexpr static std::uint32_t byte_order_mark = 0x01020304;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t key_size;
+  std::uint32_t move_size;
+  std::uint32_t byte_order;  // byte_order_mark as written
+  std::uint64_t iterations;
+  std::uint64_t num_infosets;
+  std::uint64_t num_actions;
+};
+
+struct cfr_checkpoint_entry {
+  std::uint64_t key;
+  std::uint64_t offset;  // into the action arrays
+  std::uint64_t size;
+};
+
+namespace detail {
+
+inline size_t align8(size_t n) { return (n + 7) & ~size_t{7}; }
+
+template <class T>
+std::uint64_t to_key(T const& t) {
+  std::uint64_t key = 0;
+  std::memcpy(&key, &t, sizeof(T));
+  return key;
+}
+
+template <class T>
+T from_key(std::uint64_t key) {
+  T t;
+  std::memcpy(&t, &key, sizeof(T));
+  return t;
+}
+
+}  // namespace detail
+
+template <class GameT>
+concept CheckpointableGame =
+    std::is_trivially_copyable_v<typename GameT::information_set_type> &&
+    sizeof(typename GameT::information_set_type) <= sizeof(std::uint64_t) &&
+    std::is_trivially_copyable_v<typename GameT::move_type>;
+
+/**
+ * cfr_snapshot is a flat copy of the regret and strategy sums of a cfr solver.
+ * Taking it is a plain copy in the order of the map of the solver; sorting the index and the (slow) file output
+ * happen in save(), i. e. on the writer thread of cfr_checkpointer.
+ */
+template <class GameT>
+struct cfr_snapshot {
+  using move_type = typename GameT::move_type;
+
+  std::uint64_t iterations = 0;
+  std::vector<cfr_checkpoint_entry> entries;
+  std::vector<double> regret_sum;
+  std::vector<double> strategy_sum;
+  std::vector<move_type> actions;
+
+  template <class StatsT>
+  explicit cfr_snapshot(cfr<GameT, StatsT> const& solver) : iterations(solver.iterations()) {
+    auto const values = solver.arena_bytes() / (2 * sizeof(double));  // upper bound, avoids reallocations
+    entries.reserve(solver.map().size());
+    regret_sum.reserve(values);
+    strategy_sum.reserve(values);
+    actions.reserve(values);
+    for (auto const& [info_set, node] : solver.map()) {
+      entries.push_back({detail::to_key(info_set), regret_sum.size(), node.size()});
+      regret_sum.insert(regret_sum.end(), node.regret_sum.begin(), node.regret_sum.end());
+      strategy_sum.insert(strategy_sum.end(), node.strategy_sum.begin(), node.strategy_sum.end());
+      actions.insert(actions.end(), std::begin(node.actions), std::end(node.actions));
+    }
+  }
+
+  /**
+   * Write the snapshot into a temporary file first and rename it afterwards,
+   * such that readers never see a partially written checkpoint.
+   */
+  void save(std::string const& path) const {
+    // the keys need not be ordered like the information sets, the offsets stay valid
+    auto sorted = entries;
+    std::sort(sorted.begin(), sorted.end(), [](auto const& l, auto const& r) { return l.key < r.key; });
+
+    auto const entries_bytes = entries.size() * sizeof(cfr_checkpoint_entry);
+    auto const values_bytes = regret_sum.size() * sizeof(double);
+    auto const actions_bytes = detail::align8(actions.size() * sizeof(move_type));
+    auto const size = sizeof(cfr_checkpoint_header) + entries_bytes + 2 * values_bytes + actions_bytes;
+
+    auto const tmp_path = path + ".tmp";
+    {
+      auto file = mapped_file::create(tmp_path, size);
+      cfr_checkpoint_header header{};
+      std::memcpy(header.magic, cfr_checkpoint_header::magic_string, sizeof(header.magic));
+      header.version = cfr_checkpoint_header::current_version;
+      header.key_size = sizeof(typename GameT::information_set_type);
+      header.move_size = sizeof(move_type);
+      header.byte_order = cfr_checkpoint_header::byte_order_mark;
+      header.iterations = iterations;
+      header.num_infosets = entries.size();
+      header.num_actions = actions.size();
+
+      auto* out = file.data();
+      std::memcpy(out, &header, sizeof(header));
+      out += sizeof(header);
+      std::memcpy(out, sorted.data(), entries_bytes);
+      out += entries_bytes;
+      std::memcpy(out, regret_sum.data(), values_bytes);
+      out += values_bytes;
+      std::memcpy(out, strategy_sum.data(), values_bytes);
+      out += values_bytes;
+      std::memcpy(out, actions.data(), actions.size() * sizeof(move_type));
+      file.flush();
+    }
+    std::filesystem::rename(tmp_path, path);
+  }
+};
+
+/**
+ * cfr_strategy_view gives zero-copy read-only access to a checkpoint, e. g. for serving average strategies.
+ * Opening it maps the file and validates the header and the index; lookups are binary searches on the mapped index.
+ */
+template <CheckpointableGame GameT>
+class cfr_strategy_view {
+ public:
+  using information_set_type = typename GameT::information_set_type;
+  using move_type = typename GameT::move_type;
+  using strategy_type = std::vector<double>;
+
+  struct entry {
+    std::span<move_type const> actions;
+    std::span<double const> regret_sum;
+    std::span<double const> strategy_sum;
+
+    size_t size() const { return actions.size(); }
+
+    strategy_type avg_strategy() const {
+      strategy_type strat(size());
+      simd::normalize(strategy_sum.data(), strat.data(), size(), cfr<GameT>::threshold);
+      return strat;
+    }
+  };
+
+  explicit cfr_strategy_view(std::string const& path) : file_(path) {
+    if (file_.size() < sizeof(cfr_checkpoint_header)) {
+      throw golv::exception("Not a cfr checkpoint: " + path);
+    }
+    std::memcpy(&header_, file_.data(), sizeof(header_));
+    if (std::memcmp(header_.magic, cfr_checkpoint_header::magic_string, sizeof(header_.magic)) != 0) {
+      throw golv::exception("Not a cfr checkpoint: " + path);
+    }
+    if (header_.version != cfr_checkpoint_header::current_version) {
+      throw golv::exception("Unsupported cfr checkpoint version: " + std::to_string(header_.version));
+    }
+    if (header_.byte_order != cfr_checkpoint_header::byte_order_mark) {
+      throw golv::exception("cfr checkpoint written with a different byte order: " + path);
+    }
+    if (header_.key_size != sizeof(information_set_type) || header_.move_size != sizeof(move_type)) {
+      throw golv::exception("cfr checkpoint does not match the game: " + path);
+    }
+    // divisions instead of products, such that corrupt counts cannot overflow
+    auto const available = file_.size() - sizeof(cfr_checkpoint_header);
+    if (header_.num_infosets > available / sizeof(cfr_checkpoint_entry) ||
+        header_.num_actions > (available - header_.num_infosets * sizeof(cfr_checkpoint_entry)) /
+                                  (2 * sizeof(double) + sizeof(move_type))) {
+      throw golv::exception("Truncated cfr checkpoint: " + path);
+    }
+    auto const* base = file_.data() + sizeof(cfr_checkpoint_header);
+    entries_ = reinterpret_cast<cfr_checkpoint_entry const*>(base);
+    base += header_.num_infosets * sizeof(cfr_checkpoint_entry);
+    regret_sum_ = reinterpret_cast<double const*>(base);
+    base += header_.num_actions * sizeof(double);
+    strategy_sum_ = reinterpret_cast<double const*>(base);
+    base += header_.num_actions * sizeof(double);
+    actions_ = reinterpret_cast<move_type const*>(base);
+
+    // _entry() indexes the action arrays and _find() needs unique keys in ascending order
+    for (size_t i = 0; i < size(); ++i) {
+      auto const& e = entries_[i];
+      if (e.offset > header_.num_actions || e.size > header_.num_actions - e.offset) {
+        throw golv::exception("Corrupt cfr checkpoint, entry out of range: " + path);
+      }
+      if (i > 0 && entries_[i - 1].key >= e.key) {
+        throw golv::exception("Corrupt cfr checkpoint, entries not sorted: " + path);
+      }
+    }
+  }
+
+  size_t size() const { return header_.num_infosets; }
+
+  size_t iterations() const { return header_.iterations; }
+
+  bool contains(information_set_type const& info_set) const { return _find(info_set) != nullptr; }
+
+  entry at(information_set_type const& info_set) const {
+    auto const* e = _find(info_set);
+    if (e == nullptr) throw golv::exception("Information set not in checkpoint");
+    return _entry(*e);
+  }
+
+  /**
+   * Visit all information sets in key order.
+   */
+  template <class FunctionT>
+  void for_each(FunctionT&& f) const {
+    for (size_t i = 0; i < size(); ++i) {
+      f(detail::from_key<information_set_type>(entries_[i].key), _entry(entries_[i]));
+    }
+  }
+
+ private:
+  cfr_checkpoint_entry const* _find(information_set_type const& info_set) const {
+    auto const key = detail::to_key(info_set);
+    auto const* end = entries_ + size();
+    auto const* it = std::lower_bound(entries_, end, key, [](auto const& e, auto k) { return e.key < k; });
+    return it != end && it->key == key ? it : nullptr;
+  }
+
+  entry _entry(cfr_checkpoint_entry const& e) const {
+    return {{actions_ + e.offset, e.size}, {regret_sum_ + e.offset, e.size}, {strategy_sum_ + e.offset, e.size}};
+  }
+
+  mapped_file file_;
+  cfr_checkpoint_header header_{};
+  cfr_checkpoint_entry const* entries_ = nullptr;
+  double const* regret_sum_ = nullptr;
+  double const* strategy_sum_ = nullptr;
+  move_type const* actions_ = nullptr;
+};
+
+/**
+ * Save all regret and strategy sums of the solver.
+ */
+template <CheckpointableGame GameT, class StatsT>
+void save_checkpoint(cfr<GameT, StatsT> const& solver, std::string const& path) {
+  cfr_snapshot<GameT>(solver).save(path);
+}
+
+/**
+ * Restore a solver from a checkpoint, such that solving can be resumed.
+ * Unlike opening a cfr_strategy_view (which uses the mapped arrays in place), this is not a cheap cold start: every
+ * information set is inserted into the map of the solver and its sums are copied into the arenas (one map node
+ * per information set).
+ * Serving strategies from a checkpoint should use cfr_strategy_view instead.
+ */
+template <CheckpointableGame GameT, class StatsT>
+void load_checkpoint(cfr<GameT, StatsT>& solver, std::string const& path) {
+  cfr_strategy_view<GameT> view(path);
+  view.for_each([&solver](auto const& info_set, auto const& e) {
+    auto& node = solver.insert(info_set, typename GameT::move_range(e.actions.begin(), e.actions.end()));
+    std::copy(e.regret_sum.begin(), e.regret_sum.end(), std::begin(node.regret_sum));
+    std::copy(e.strategy_sum.begin(), e.strategy_sum.end(), std::begin(node.strategy_sum));
+  });
+  solver.set_iterations(view.iterations());
+}
+
+/**
+ * cfr_checkpointer takes a snapshot every interval iterations and writes it asynchronously.
+ * It is meant as callback of cfr::solve(). If the previous snapshot is still being written,
+ * the current one is skipped instead of stalling the iteration loop.
+ */
+template <CheckpointableGame GameT>
+class cfr_checkpointer {
+ public:
+  cfr_checkpointer(std::string path, size_t interval) : path_(std::move(path)), interval_(interval) {}
+
+  cfr_checkpointer(cfr_checkpointer const&) = delete;
+  cfr_checkpointer& operator=(cfr_checkpointer const&) = delete;
+
+  ~cfr_checkpointer() {
+    if (pending_.valid()) pending_.wait();
+  }
+
+  template <class StatsT>
+  void operator()(cfr<GameT, StatsT> const& solver) {
+    if (interval_ == 0 || solver.iterations() % interval_ != 0) return;
+    if (pending_.valid() && pending_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      GOLV_LOG_DEBUG("skipping checkpoint at iteration " << solver.iterations());
+      ++skipped_;
+      return;
+    }
+    if (pending_.valid()) pending_.get();
+    pending_ = std::async(std::launch::async,
+                          [snapshot = cfr_snapshot<GameT>(solver), path = path_]() { snapshot.save(path); });
+    ++written_;
+  }
+
+  /**
+   * Wait for the last snapshot to be written. Rethrows errors of the writer.
+   */
+  void wait() {
+    if (pending_.valid()) pending_.get();
+  }
+
+  size_t written() const { return written_; }
+  size_t skipped() const { return skipped_; }
+
+ private:
+  std::string path_;
+  size_t interval_;
+  std::future<void> pending_;
+  size_t written_ = 0;
+  size_t skipped_ = 0;
+};
+
+}  // namespace golv
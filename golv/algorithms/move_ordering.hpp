@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <iterator>
 #include <type_traits>
 
 namespace golv {
@@ -15,4 +17,22 @@ template<>
 struct with_ordering<no_ordering> : std::false_type
 {};
 
+/**
+ *   std::sort of a move range. The heap sort fallback of std::sort is never reached for the few moves of a
+ *   position, but GCC 12 warns about it (-Warray-bounds) if the range is stored in a small static_vector.
+ */
+template<class RangeT, class CompareT>
+void
+sort_moves(RangeT& moves, CompareT comp)
+{
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+    std::sort(std::begin(moves), std::end(moves), comp);
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+}
+
 } // namespace golv
\ No newline at end of file
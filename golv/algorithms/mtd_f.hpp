@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <golv/algorithms/alphabeta.hpp>
+#include <golv/algorithms/search_stats.hpp>
 #include <golv/traits/game.hpp>
 #include <golv/traits/transposition_table.hpp>
 #include <iostream>
@@ -11,7 +12,12 @@
 
 namespace golv {
 
-template <Game GameT, typename MoveOrderingT = no_ordering, TranspositionTable<GameT> TableT = no_table<GameT>>
+/**
+ * mtd_f solves by a sequence of minimal window alpha-beta searches sharing one table.
+ *  StatsT is search_stats or no_search_stats (see search_stats.hpp); every search after the first counts as re-search.
+ */
+template <Game GameT, typename MoveOrderingT = no_ordering, TranspositionTable<GameT> TableT = no_table<GameT>,
+          typename StatsT = no_search_stats>
 class mtd_f {
  public:
   using game_type = GameT;
@@ -23,18 +29,24 @@ class mtd_f {
 
  private:
   game_type game_;
+  [[no_unique_address]] StatsT stats_;
 
  public:
   mtd_f(GameT game) : game_(game) {}
 
+  StatsT const& stats() const { return stats_; }
+
   value_type solve(value_type first_guess, value_type lower_bound = min_value, value_type upper_bound = max_value) {
     value_type g = first_guess;
 
     unordered_table<game_type> table;
-    alpha_beta solver(game_, std::less<move_type>{}, table);
+    alpha_beta solver(game_, std::less<move_type>{}, table, stats_);
+    bool first = true;
     while (lower_bound < upper_bound) {
       GOLV_LOG_DEBUG("lower_bound = " << lower_bound << ", upper_bound = " << upper_bound);
       value_type beta = g > lower_bound + 1 ? g : (lower_bound + 1);
+      if (!first) solver.re_search();
+      first = false;
       g = solver.mws_solve(beta);
       if (g < beta)
         upper_bound = g;
@@ -43,6 +55,7 @@ class mtd_f {
       GOLV_LOG_DEBUG("table size = " << solver.get_table().size());
       GOLV_LOG_TRACE("table = " << solver.get_table());
     }
+    stats_ = solver.stats();
 
     return g;
   }
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <golv/traits/endgame_table.hpp>
 #include <golv/traits/game.hpp>
 #include <golv/algorithms/mws_unordered_table.hpp>
 #include <golv/algorithms/move_ordering.hpp>
+#include <golv/algorithms/search_stats.hpp>
 #include <golv/util/logging.hpp>
 
 #include <algorithm>
@@ -10,17 +12,27 @@
 template <class T>
 struct opp_value_wrapper : public T {
   template <class U>
-  static auto check(U const& t) -> decltype(t.opp_value(), std::true_type());
+  static auto check(U const& t) -> decltype(t.opp_value(), t.total_value(), std::true_type());
 
   static auto check(...) -> decltype(std::false_type());
 };
 
+/**
+ * Games reporting the value of the opponents and the total value (e. g. skat and bridge) let
+ * minimal_window_search fail early once the bound cannot be exceeded anymore.
+ */
 template <class T>
 struct has_opp_value : decltype(opp_value_wrapper<T>::check(std::declval<opp_value_wrapper<T>>())){};
 
 namespace golv {
+/**
+ * minimal_window_search decides whether the value of the game exceeds a bound.
+ *  StatsT is search_stats or no_search_stats (see search_stats.hpp).
+ *  EndgameT satisfies concept EndgameTable, its values replace the search below the root.
+ */
 template <Game GameT, TranspositionTable<GameT> TableT = no_table<GameT>,
-          typename MoveOrderingT = no_ordering>
+          typename MoveOrderingT = no_ordering, typename StatsT = no_search_stats,
+          EndgameTable<GameT> EndgameT = no_endgame_table<GameT>>
 class minimal_window_search {
  public:
   using game_type = GameT;
@@ -28,23 +40,40 @@ class minimal_window_search {
   using move_type = typename game_type::move_type;
   using move_ordering_type = MoveOrderingT;
   using table_type = TableT;
+  using stats_type = StatsT;
+  using endgame_type = EndgameT;
 
   constexpr static value_type min_value = std::numeric_limits<value_type>::lowest() / 2;
   constexpr static value_type max_value = std::numeric_limits<value_type>::max() / 2;
 
   minimal_window_search(GameT game, TableT table = no_table<game_type>{},
-                        MoveOrderingT move_ordering = no_ordering{})
-      : game_(game), move_ordering_(move_ordering), table_(table) {}
+                        MoveOrderingT move_ordering = no_ordering{}, StatsT stats = no_search_stats{},
+                        EndgameT endgame = no_endgame_table<game_type>{})
+      : game_(game), move_ordering_(move_ordering), table_(std::move(table)), stats_(stats),
+        endgame_(std::move(endgame)) {}
+
+  bool solve(value_type bound) {
+    stats_.start();
+    auto result = _solve(bound);
+    stats_.stop();
+    return result;
+  }
+
+  StatsT const& stats() const { return stats_; }
 
-  bool solve(value_type bound) { return _solve(bound); }
+  /**
+   * Count a re-search (e. g. by mws_binary_search).
+   */
+  void re_search() { stats_.re_search(); }
 
   bool _solve(value_type bound, int depth = 0) {
+    stats_.node(depth);
     auto value = game_.value();
     if (value > bound)
       return true;
     else {
       if constexpr (has_opp_value<game_type>::value) {
-        if (game_.opp_value() >= 120 - bound) {
+        if (game_.opp_value() >= game_.total_value() - bound) {
           return false;
         }
       }
@@ -54,13 +83,25 @@ class minimal_window_search {
       return value > bound;
     }
 
+    if constexpr (with_endgame_table<endgame_type>::value) {
+      if (depth > 0) {
+        if (auto const rest = endgame_.probe(game_)) return value + *rest > bound;
+      }
+    }
+
+    // the root is always expanded, such that best_move() is set also with a warm table
     if constexpr (with_table<table_type>::value) {
-      if (table_.is_memorable(game_)) {
+      if (depth > 0 && table_.is_memorable(game_)) {
+        stats_.tt_probe();
         auto lookup = table_.get(game_.state());
         if (bound - value <= lookup.first) {
+          count_cutoff(table_, lookup.first == lookup.second);
+          stats_.tt_cutoff();
           return true;
         }
         if (bound - value >= lookup.second) {
+          count_cutoff(table_, lookup.first == lookup.second);
+          stats_.tt_cutoff();
           return false;
         }
       }
@@ -69,18 +110,41 @@ class minimal_window_search {
     auto legal_actions = game_.legal_actions();
 
     if constexpr (with_ordering<move_ordering_type>::value) {
-      std::sort(std::begin(legal_actions), std::end(legal_actions), move_ordering_);
+      sort_moves(legal_actions, move_ordering_);
     }
 
-    for (auto a : legal_actions) {
+    // try the move of the last cutoff first (tables storing best moves only)
+    size_t hint = 0;
+    if constexpr (with_best_move<table_type>) {
+      if (table_.is_memorable(game_)) {
+        auto const stored = table_.best_move(game_.state());
+        if (stored < legal_actions.size()) {
+          hint = stored;
+          std::rotate(std::begin(legal_actions), std::begin(legal_actions) + hint,
+                      std::begin(legal_actions) + hint + 1);
+        }
+      }
+    }
+
+    for (size_t i = 0; i < legal_actions.size(); ++i) {
+      auto a = legal_actions[i];
       game_.apply_action(a);
       bool son = _solve(bound, depth + 1);
       game_.undo_action(a);
 
       if (son == game_.is_max()) {
+        stats_.cutoff(i);
         if constexpr (with_table<table_type>::value) {
           if (table_.is_memorable(game_)) {
-            if (game_.is_max()) {
+            if constexpr (with_best_move<table_type>) {
+              // index before the rotation
+              auto const index = i == 0 ? hint : (i <= hint ? i - 1 : i);
+              if (game_.is_max()) {
+                table_.update_lower(game_.state(), bound - value, index);
+              } else {
+                table_.update_upper(game_.state(), bound - value, index);
+              }
+            } else if (game_.is_max()) {
               table_.update_lower(game_.state(), bound - value);
             } else {
               table_.update_upper(game_.state(), bound - value);
@@ -112,7 +176,9 @@ class minimal_window_search {
   game_type game_;
   move_ordering_type move_ordering_;
   table_type table_;
-  move_type best_move_;
+  [[no_unique_address]] stats_type stats_;
+  [[no_unique_address]] endgame_type endgame_;
+  move_type best_move_{};
 };
 
 template <Game GameT, typename LessT = no_ordering,
@@ -131,16 +197,21 @@ auto mws_with_memory(GameT g, typename GameT::value_type test_value, LessT o = s
   return std::make_pair(solution, mws.best_move());
 }
 
-template <Game GameT, typename LessT = std::less<typename GameT::move_type>>
-auto mws_binary_search(GameT g, LessT o = std::less<typename GameT::move_type>{}) {
-  mws_unordered_table<GameT> table{};
-  minimal_window_search mws(g, table, o);
-
-  typename GameT::value_type start = 0, end = 120;
+/**
+ * Binary search for the value in [start, end] with an existing search object, such that its table
+ * (and the statistics of it) can be inspected afterwards.
+ */
+template <Game GameT, TranspositionTable<GameT> TableT, typename MoveOrderingT, typename StatsT,
+          EndgameTable<GameT> EndgameT>
+auto mws_binary_search(minimal_window_search<GameT, TableT, MoveOrderingT, StatsT, EndgameT>& mws,
+                       typename GameT::value_type start = 0, typename GameT::value_type end = 120) {
   auto mid = (start + end) / 2;
   bool larger = false;
   typename GameT::move_type best_move;
+  bool first = true;
   while ((end - start) > 1) {
+    if (!first) mws.re_search();
+    first = false;
     larger = mws.solve(mid);
     if (larger) {
       start = mid;
@@ -155,4 +226,10 @@ auto mws_binary_search(GameT g, LessT o = std::less<typename GameT::move_type>{}
   return std::make_pair(end, best_move);  // todo: best move
 }
 
+template <Game GameT, typename LessT = std::less<typename GameT::move_type>>
+auto mws_binary_search(GameT g, LessT o = std::less<typename GameT::move_type>{}) {
+  minimal_window_search mws(g, mws_unordered_table<GameT>{}, o);
+  return mws_binary_search(mws);
+}
+
 }  // namespace golv
\ No newline at end of file
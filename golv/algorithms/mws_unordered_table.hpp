@@ -1,5 +1,6 @@
 #pragma once
 
+#include <golv/algorithms/table_counters.hpp>
 #include <golv/traits/game.hpp>
 #include <golv/traits/transposition_table.hpp>
 #include <golv/util/logging.hpp>
@@ -12,13 +13,15 @@ namespace golv {
 /**
  * mws_unordered_table is a simple TranspositionTable based on std::unordered_map.
  * It complies with the TranspositionTable concept.
+ * Counting (probes, hits, ...) is enabled with CountersT = table_counters.
  */
-template <Game GameT>
+template <Game GameT, class CountersT = no_table_counters>
 struct mws_unordered_table {
   using storage_type = std::pair<typename GameT::value_type, typename GameT::value_type>;
   using map_type = std::unordered_map<typename GameT::state_type, storage_type>;
 
   map_type map_;
+  [[no_unique_address]] CountersT counters_;
 
   constexpr bool is_memorable(GameT const& game) const {  //
     // todo! remove hash_me. work with std::hash instead
@@ -29,35 +32,57 @@ struct mws_unordered_table {
     const static storage_type _invalid = std::make_pair(std::numeric_limits<typename GameT::value_type>::lowest(),  //
                                                         std::numeric_limits<typename GameT::value_type>::max());
 
+    counters_.probe();
     auto it = map_.find(state);
     if (it == map_.end()) {
-      it = map_.insert(it, {state, _invalid});
+      it = _insert(state, _invalid);
+    } else {
+      counters_.hit();
     }
     return it->second;
   }
 
   void set(typename GameT::state_type const& state, storage_type type_value) {  //
-    map_[state] = type_value;
+    counters_.store();
+    auto it = map_.find(state);
+    if (it == map_.end()) {
+      _insert(state, type_value);
+    } else {
+      it->second = type_value;
+    }
   }
 
   void update_lower(typename GameT::state_type const& state,  //
                     typename GameT::value_type const& value) {
+    counters_.store();
     auto it = map_.find(state);
     if (it == map_.end()) {
-      it = map_.insert(it, {state, {value, std::numeric_limits<typename GameT::value_type>::max()}});
+      it = _insert(state, {value, std::numeric_limits<typename GameT::value_type>::max()});
     }
     it->second.first = std::max(value, it->second.first);
   }
 
   void update_upper(typename GameT::state_type const& state,  //
                     typename GameT::value_type const& value) {
+    counters_.store();
     auto it = map_.find(state);
     if (it == map_.end()) {
-      it = map_.insert(it, {state, {std::numeric_limits<typename GameT::value_type>::lowest(), value}});
+      it = _insert(state, {std::numeric_limits<typename GameT::value_type>::lowest(), value});
     }
     it->second.second = std::min(value, it->second.second);
   }
 
+  /**
+   * Called by the solvers if a lookup caused a cutoff.
+   */
+  void cutoff(bool exact) { counters_.cutoff(exact); }
+
+  table_stats stats() const {
+    table_stats stats = counters_.stats();
+    stats.size = map_.size();
+    return stats;
+  }
+
   void report() const {
     GOLV_LOG_DEBUG("max_bucket_count = " << map_.max_bucket_count());
     GOLV_LOG_DEBUG("load_factor = " << map_.load_factor());
@@ -69,6 +94,16 @@ struct mws_unordered_table {
       if (map_.bucket_size(i) > 1) collisions += (map_.bucket_size(i) - 1);
     }
     GOLV_LOG_DEBUG("collisions = " << collisions);
+    GOLV_LOG_DEBUG("stats = " << stats());
+  }
+
+  auto _insert(typename GameT::state_type const& state, storage_type type_value) {
+    auto it = map_.emplace(state, type_value).first;
+    counters_.insert(key_depth(state));
+    if constexpr (with_counters<CountersT>::value) {
+      if (map_.bucket_size(map_.bucket(state)) > 1) counters_.collision();
+    }
+    return it;
   }
 };
 }  // namespace golv
\ No newline at end of file
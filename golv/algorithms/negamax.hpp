@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <golv/algorithms/move_ordering.hpp>
+#include <golv/algorithms/search_stats.hpp>
 #include <golv/algorithms/unordered_table.hpp>
 #include <golv/traits/game.hpp>
 #include <iostream>
@@ -16,8 +17,10 @@ namespace golv {
  * ordering. GameT satisfies concept Game. MoveOrderingT is a less-than ordering for GameT::move_type (typically an
  * integer, but can be different as long as either std::less is defined for the type or a user-defined ordering given.
  *  TableT satisfies concept TranspositionTable.
+ *  StatsT is search_stats or no_search_stats (see search_stats.hpp).
  */
-template <Game GameT, typename MoveOrderingT = no_ordering, TranspositionTable<GameT> TableT = no_table<GameT>>
+template <Game GameT, typename MoveOrderingT = no_ordering, TranspositionTable<GameT> TableT = no_table<GameT>,
+          typename StatsT = no_search_stats>
 class nega_max {
  public:
   using game_type = GameT;
@@ -25,21 +28,29 @@ class nega_max {
   using move_type = typename game_type::move_type;
   using move_ordering_type = MoveOrderingT;
   using table_type = TableT;
+  using stats_type = StatsT;
 
   constexpr static value_type min_value = std::numeric_limits<value_type>::lowest() + 1;
   constexpr static value_type max_value = std::numeric_limits<value_type>::max() - 1;
 
-  nega_max(GameT game, MoveOrderingT move_ordering = no_ordering{}, TableT table = no_table<game_type>{})
-      : game_(game), move_ordering_(move_ordering), table_(table) {}
+  nega_max(GameT game, MoveOrderingT move_ordering = no_ordering{}, TableT table = no_table<game_type>{},
+           StatsT stats = no_search_stats{})
+      : game_(game), move_ordering_(move_ordering), table_(table), stats_(stats) {}
 
   auto solve() -> value_type {
-    return game_.is_max() ? _solve(min_value, max_value, 0) : -_solve(min_value, max_value, 0);
+    stats_.start();
+    auto value = game_.is_max() ? _solve(min_value, max_value, 0) : -_solve(min_value, max_value, 0);
+    stats_.stop();
+    return value;
   }
 
   move_type best_move() const { return best_move_; }
 
+  StatsT const& stats() const { return stats_; }
+
  private:
   auto _solve(value_type a, value_type b, int depth) -> value_type {
+    stats_.node(depth);
     if (game_.is_terminal()) {
       return game_.is_max() ? game_.value() : -game_.value();
     }
@@ -47,18 +58,25 @@ class nega_max {
     value_type value = min_value;
     value_type old_a = a;
 
+    if constexpr (with_stats<stats_type>::value && with_table<table_type>::value) {
+      if (table_.is_memorable(game_)) stats_.tt_probe();
+    }
     auto l = lookup_before<game_type, table_type>(table_, game_, a, b);
-    if (l.first) return l.second;
+    if (l.first) {
+      stats_.tt_cutoff();
+      return l.second;
+    }
 
     auto legal_actions = game_.legal_actions();
 
     if constexpr (with_ordering<move_ordering_type>::value) {
-      std::sort(std::begin(legal_actions), std::end(legal_actions), move_ordering_);
+      sort_moves(legal_actions, move_ordering_);
     }
 
     best_move_ = move_type{};
 
-    for (auto move : legal_actions) {
+    for (size_t i = 0; i < legal_actions.size(); ++i) {
+      auto move = legal_actions[i];
       game_.apply_action(move);
       value_type child_val = -_solve(-b, -a, depth + 1);
       game_.undo_action(move);
@@ -70,6 +88,7 @@ class nega_max {
 
       a = std::max(a, value);
       if (a >= b) {
+        stats_.cutoff(i);
         break;
       }
     }
@@ -96,6 +115,7 @@ class nega_max {
   game_type game_;
   move_ordering_type move_ordering_;
   table_type table_;
+  [[no_unique_address]] stats_type stats_;
   move_type best_move_;
 };
 
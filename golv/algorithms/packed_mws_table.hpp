@@ -0,0 +1,387 @@
+#pragma once
+
+#include <golv/algorithms/table_counters.hpp>
+#include <golv/traits/game.hpp>
+#include <golv/traits/transposition_table.hpp>
+#include <golv/util/exception.hpp>
+#include <golv/util/logging.hpp>
+#include <golv/util/mapped_file.hpp>
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace golv {
+
+/**
+ * packed_key maps a state of a trick-taking game to a 64-bit hash and a depth (the number of remaining cards),
+ * which is used by packed_mws_table to decide which entry of a full bucket to replace.
+ * The hashes must not change between runs, since tables can be stored on disk; layout names the key format
+ * in the file header.
+ */
+template <class StateT>
+struct packed_key;
+
+template <size_t N>
+struct packed_key<std::bitset<N>> {
+  constexpr static std::string_view layout = "bitset64/sm64";
+
+  static std::uint64_t hash(std::bitset<N> const& state) {
+    // splitmix64 finalizer: the card bits are far from uniformly distributed
+    std::uint64_t x = state.to_ullong();
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  static std::uint8_t depth(std::bitset<N> const& state) { return key_depth(state); }
+};
+
+template <>
+struct packed_key<std::string> {
+  constexpr static std::string_view layout = "string/fnv1a";
+
+  static std::uint64_t hash(std::string const& state) {
+    // FNV-1a, std::hash is not guaranteed to be stable across implementations
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : state) {
+      h ^= c;
+      h *= 0x100000001b3ULL;
+    }
+    return h;
+  }
+
+  static std::uint8_t depth(std::string const& state) { return key_depth(state); }
+};
+
+/**
+ * Header of a stored packed_mws_table (native byte order, readers reject files with a different byte_order),
+ * followed by the buckets at offset buckets_offset, i. e. cache-line aligned in the mapping. Entries are only valid
+ * for the same game, key layout and variant.
+ */
+struct packed_table_header {
+  constexpr static char magic_string[8] = "GOLVTT";
+  constexpr static std::uint32_t current_version = 2;
+  constexpr static std::uint32_t byte_order_mark = 0x01020304;
+  constexpr static size_t buckets_offset = 128;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t entry_size;
+  std::uint32_t byte_order;  // byte_order_mark as written
+  std::uint32_t reserved;
+  char game[8];
+  char key_layout[16];
+  std::uint64_t variant;  // e. g. a hash of the deal and the declaration
+  std::uint64_t num_buckets;
+  std::uint64_t size;
+};
+
+static_assert(sizeof(packed_table_header) <= packed_table_header::buckets_offset);
+
+/**
+ * packed_mws_table is a fixed-size TranspositionTable for minimal_window_search on trick-taking games
+ * (skat, bridge). Entries are 8 bytes (32-bit key fingerprint, 8-bit lower and upper bound, best move index
+ * and depth) grouped in cache-line sized buckets of 8 entries. The number of buckets is derived from a memory
+ * budget, so the table never grows. If a bucket is full, the entry with the fewest remaining cards is replaced.
+ *
+ * The bounds stored by minimal_window_search are relative to the current value and fit into 8 bits for both
+ * games; values outside are clamped such that they stay valid (but weaker) bounds.
+ *
+ * Tables can be saved and reopened as memory mapping (see save() and open()), such that later runs on the same
+ * deal start from a warm table without reading the file up front.
+ *
+ * Keys whose fingerprint matches but whose depth differs are detected as collisions and treated as misses.
+ * Counting (probes, hits, ...) is enabled with CountersT = table_counters.
+ */
+template <Game GameT, class CountersT = no_table_counters>
+class packed_mws_table {
+ public:
+  using value_type = typename GameT::value_type;
+  using state_type = typename GameT::state_type;
+  using storage_type = std::pair<value_type, value_type>;
+  using key_type = packed_key<state_type>;
+
+  constexpr static std::int8_t no_lower = std::numeric_limits<std::int8_t>::lowest();
+  constexpr static std::int8_t no_upper = std::numeric_limits<std::int8_t>::max();
+  constexpr static std::uint8_t no_move = 0;
+  constexpr static size_t bucket_size = 8;
+  constexpr static size_t default_memory = size_t{64} << 20;
+
+  struct entry {
+    std::uint32_t fingerprint = 0;  // 0 marks an empty entry
+    std::int8_t lower = no_lower;
+    std::int8_t upper = no_upper;
+    std::uint8_t move = no_move;  // index of the best move + 1
+    std::uint8_t depth = 0;
+  };
+
+  struct alignas(64) bucket {
+    std::array<entry, bucket_size> entries;
+  };
+
+  static_assert(sizeof(entry) == 8);
+  static_assert(sizeof(bucket) == 64);
+
+  /**
+   * Create a table using (at most) memory_bytes; the number of buckets is a power of two.
+   */
+  explicit packed_mws_table(size_t memory_bytes = default_memory) {
+    size_t num_buckets = 1;
+    while (num_buckets * 2 * sizeof(bucket) <= memory_bytes) num_buckets *= 2;
+    owned_.resize(num_buckets);
+    buckets_ = owned_.data();
+    num_buckets_ = num_buckets;
+  }
+
+  /**
+   * Open a table written by save() for the same variant. With mode::copy_on_write (the default) changes stay private
+   * to the process, with mode::read_write they go to the file, i. e. the store keeps growing across runs.
+   * Throws golv::exception if the file was written for another game, key layout or variant.
+   *
+   * The variant is required since the keys do not encode everything the values depend on, e. g. skat::state()
+   * holds neither the trump nor the soloist: a table of another declaration would return wrong bounds.
+   */
+  static packed_mws_table open(std::string const& path, std::uint64_t variant,
+                               mapped_file::mode m = mapped_file::mode::copy_on_write) {
+    if (m == mapped_file::mode::read_only) {
+      throw golv::exception("Transposition tables need a writable mapping: " + path);
+    }
+    packed_mws_table table(0);
+    table.file_ = mapped_file(path, m);
+    if (table.file_.size() < packed_table_header::buckets_offset) {
+      throw golv::exception("Not a transposition table: " + path);
+    }
+    packed_table_header header;
+    std::memcpy(&header, table.file_.data(), sizeof(header));
+    if (std::memcmp(header.magic, packed_table_header::magic_string, sizeof(header.magic)) != 0) {
+      throw golv::exception("Not a transposition table: " + path);
+    }
+    if (header.version != packed_table_header::current_version || header.entry_size != sizeof(entry)) {
+      throw golv::exception("Unsupported transposition table version: " + std::to_string(header.version));
+    }
+    if (header.byte_order != packed_table_header::byte_order_mark) {
+      throw golv::exception("Transposition table written with a different byte order: " + path);
+    }
+    std::string_view const game(header.game, sizeof(header.game));
+    std::string_view const layout(header.key_layout, sizeof(header.key_layout));
+    if (_tag(GameT::name, game.size()) != game || _tag(key_type::layout, layout.size()) != layout) {
+      throw golv::exception("Transposition table does not match the game or key layout: " + path);
+    }
+    if (header.variant != variant) {
+      throw golv::exception("Transposition table was written for another variant: " + path);
+    }
+    auto const n = header.num_buckets;
+    if (n == 0 || (n & (n - 1)) != 0 ||
+        n > (table.file_.size() - packed_table_header::buckets_offset) / sizeof(bucket)) {
+      throw golv::exception("Truncated transposition table: " + path);
+    }
+    table.owned_ = {};
+    table.buckets_ = reinterpret_cast<bucket*>(table.file_.data() + packed_table_header::buckets_offset);
+    table.num_buckets_ = n;
+    table.size_ = header.size;
+    return table;
+  }
+
+  /**
+   * Write the table to path (via a temporary file, such that readers never see a partial table). variant must
+   * identify everything the values depend on beyond the keys (see open()), e. g. the deal and the declaration.
+   */
+  void save(std::string const& path, std::uint64_t variant) const {
+    auto const tmp_path = path + ".tmp";
+    {
+      auto file =
+          mapped_file::create(tmp_path, packed_table_header::buckets_offset + num_buckets_ * sizeof(bucket));
+      packed_table_header header{};
+      std::memcpy(header.magic, packed_table_header::magic_string, sizeof(header.magic));
+      header.version = packed_table_header::current_version;
+      header.entry_size = sizeof(entry);
+      header.byte_order = packed_table_header::byte_order_mark;
+      auto const game = _tag(GameT::name, sizeof(header.game));
+      auto const layout = _tag(key_type::layout, sizeof(header.key_layout));
+      std::memcpy(header.game, game.data(), game.size());
+      std::memcpy(header.key_layout, layout.data(), layout.size());
+      header.variant = variant;
+      header.num_buckets = num_buckets_;
+      header.size = size_;
+      std::memcpy(file.data(), &header, sizeof(header));
+      std::memcpy(file.data() + packed_table_header::buckets_offset, buckets_, num_buckets_ * sizeof(bucket));
+      file.flush();
+    }
+    std::filesystem::rename(tmp_path, path);
+  }
+
+  /**
+   * Write the header of a table opened with mode::read_write (and the pages to disk).
+   */
+  void flush() {
+    if (!file_.is_open()) return;
+    packed_table_header header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+    header.size = size_;
+    std::memcpy(file_.data(), &header, sizeof(header));
+    file_.flush();
+  }
+
+  bool is_mapped() const { return file_.is_open(); }
+
+  constexpr bool is_memorable(GameT const& game) const { return game.hash_me(); }
+
+  storage_type get(state_type const& state) {
+    counters_.probe();
+    auto const* e = _find(state);
+    if (e == nullptr) {
+      return {std::numeric_limits<value_type>::lowest(), std::numeric_limits<value_type>::max()};
+    }
+    counters_.hit();
+    return {e->lower == no_lower ? std::numeric_limits<value_type>::lowest() : e->lower,
+            e->upper == no_upper ? std::numeric_limits<value_type>::max() : e->upper};
+  }
+
+  void set(state_type const& state, storage_type bounds) {
+    auto& e = _store(state);
+    e.lower = _clamp_lower(bounds.first);
+    e.upper = _clamp_upper(bounds.second);
+  }
+
+  void update_lower(state_type const& state, value_type const& value, size_t move_index = npos) {
+    auto& e = _store(state);
+    e.lower = std::max(e.lower, _clamp_lower(value));
+    _set_move(e, move_index);
+  }
+
+  void update_upper(state_type const& state, value_type const& value, size_t move_index = npos) {
+    auto& e = _store(state);
+    e.upper = std::min(e.upper, _clamp_upper(value));
+    _set_move(e, move_index);
+  }
+
+  /**
+   * Index of the move which caused the last cutoff in this state, or npos.
+   */
+  size_t best_move(state_type const& state) const {
+    auto const* e = _find(state);
+    return e == nullptr || e->move == no_move ? npos : e->move - 1;
+  }
+
+  void clear() {
+    std::fill(buckets_, buckets_ + num_buckets_, bucket{});
+    size_ = 0;
+    counters_.clear();
+  }
+
+  /**
+   * Called by the solvers if a lookup caused a cutoff.
+   */
+  void cutoff(bool exact) { counters_.cutoff(exact); }
+
+  table_stats stats() const {
+    table_stats stats = counters_.stats();
+    stats.size = size_;
+    stats.capacity = capacity();
+    return stats;
+  }
+
+  /**
+   * Number of occupied entries.
+   */
+  size_t size() const { return size_; }
+  size_t capacity() const { return num_buckets_ * bucket_size; }
+  size_t memory() const { return num_buckets_ * sizeof(bucket); }
+
+  /**
+   * Allocated bytes per occupied entry (sizeof(entry) for a full table).
+   */
+  double bytes_per_entry() const { return size_ == 0 ? 0.0 : static_cast<double>(memory()) / size_; }
+
+  void report() const {
+    GOLV_LOG_DEBUG("capacity = " << capacity());
+    GOLV_LOG_DEBUG("size = " << size());
+    GOLV_LOG_DEBUG("bytes_per_entry = " << bytes_per_entry());
+    GOLV_LOG_DEBUG("stats = " << stats());
+  }
+
+  constexpr static size_t npos = std::numeric_limits<size_t>::max();
+
+ private:
+  /**
+   * Zero padded name for the header; longer names are cut.
+   */
+  static std::string _tag(std::string_view name, size_t size) {
+    std::string tag(size, '\0');
+    std::copy_n(name.begin(), std::min(name.size(), tag.size()), tag.begin());
+    return tag;
+  }
+
+  static std::uint32_t _fingerprint(std::uint64_t hash) { return std::max<std::uint32_t>(hash >> 32, 1); }
+
+  static std::int8_t _clamp_lower(value_type value) {
+    // a lower bound may only be lowered, i. e. very small values are dropped
+    return static_cast<std::int8_t>(std::clamp<int>(value, no_lower, no_upper - 1));
+  }
+
+  static std::int8_t _clamp_upper(value_type value) {
+    return static_cast<std::int8_t>(std::clamp<int>(value, no_lower + 1, no_upper));
+  }
+
+  static void _set_move(entry& e, size_t move_index) {
+    if (move_index < std::numeric_limits<std::uint8_t>::max()) e.move = static_cast<std::uint8_t>(move_index + 1);
+  }
+
+  entry const* _find(state_type const& state) const {
+    auto const hash = key_type::hash(state);
+    auto const fp = _fingerprint(hash);
+    for (auto const& e : buckets_[hash & (num_buckets_ - 1)].entries) {
+      if (e.fingerprint == fp) {
+        if (e.depth == key_type::depth(state)) return &e;
+        counters_.collision();
+        return nullptr;
+      }
+    }
+    return nullptr;
+  }
+
+  entry& _store(state_type const& state) {
+    auto const hash = key_type::hash(state);
+    auto const fp = _fingerprint(hash);
+    auto& entries = buckets_[hash & (num_buckets_ - 1)].entries;
+    auto const depth = key_type::depth(state);
+    counters_.store();
+    entry* victim = &entries[0];
+    for (auto& e : entries) {
+      if (e.fingerprint == fp) {
+        if (e.depth == depth) return e;
+        counters_.collision();
+        victim = &e;
+        break;
+      }
+      if (e.fingerprint == 0) {
+        victim = &e;
+        break;
+      }
+      if (e.depth < victim->depth) victim = &e;
+    }
+    if (victim->fingerprint == 0)
+      ++size_;
+    else
+      counters_.overwrite(victim->depth);
+    counters_.insert(depth);
+    *victim = entry{fp, no_lower, no_upper, no_move, depth};
+    return *victim;
+  }
+
+  std::vector<bucket> owned_;
+  mapped_file file_;
+  bucket* buckets_ = nullptr;  // owned_ or the mapping of file_
+  size_t num_buckets_ = 0;
+  size_t size_ = 0;
+  [[no_unique_address]] mutable CountersT counters_;
+};
+
+}  // namespace golv
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <golv/traits/game.hpp>
+#include <golv/util/exception.hpp>
+#include <golv/util/mapped_file.hpp>
+#include <golv/util/parallel_for.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace golv {
+
+/**
+ * Header of a stored retrograde_table (native byte order, readers reject files with a different byte_order),
+ * followed by the packed values. The game is identified by its name and number of positions.
+ */
+struct retrograde_header {
+  constexpr static char magic_string[8] = "GOLVRET";
+  constexpr static std::uint32_t current_version = 2;
+  constexpr static std::uint32_t byte_order_mark = 0x01020304;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;  // byte_order_mark as written
+  char game[16];
+  std::uint64_t num_positions;
+  std::uint64_t size;  // solved positions
+};
+
+static_assert(sizeof(retrograde_header) % sizeof(std::uint64_t) == 0);  // the values are aligned in the mapping
+
+/**
+ * retrograde_table holds the exact values of all positions of an IndexedGame which are reachable from a root,
+ * two bits per position index (unknown, loss, draw or win), i. e. get() is a lookup without search.
+ *
+ * generate() enumerates the positions level by level (by the number of moves from the root) and solves them
+ * from the deepest level up: a position is terminal or takes the best value of its children, which are all on
+ * the level below. Each level is processed in blocks on a pool of threads. This requires that a position is
+ * reached after the same number of moves on every path (as in tictactoe and connectfour) and that the values are
+ * -1, 0 or 1 at the end and 0 before.
+ *
+ * The table is an EndgameTable, such that alpha_beta and minimal_window_search return its values below the root.
+ * Tables can be saved and mapped read-only, copies share the values.
+ */
+template <IndexedGame GameT>
+class retrograde_table {
+ public:
+  using value_type = typename GameT::value_type;
+
+  constexpr static size_t block_size = 1024;  // positions per task
+  constexpr static size_t positions_per_word = 32;
+
+  /**
+   * Solve all positions reachable from root on a pool of threads (0 for the hardware concurrency).
+   * Throws golv::exception if a position is reached at different depths or a terminal value is not -1, 0 or 1.
+   */
+  static retrograde_table generate(GameT root = GameT{}, size_t threads = 0) {
+    auto d = std::make_shared<data>();
+    d->owned.assign(_words(), 0);
+    auto& words = d->owned;
+
+    // forward: the positions of each level
+    std::vector<std::uint64_t> seen(_words() / 2 + 1, 0);
+    std::vector<std::vector<std::uint64_t>> levels{{root.position_index()}};
+    _mark(seen, levels.front().front());
+    while (true) {
+      auto const& level = levels.back();
+      std::vector<std::vector<std::uint64_t>> children(_blocks(level.size()));
+      parallel_for(children.size(), threads, [&](size_t block) {
+        auto& out = children[block];
+        for (size_t i = block * block_size; i < std::min(level.size(), (block + 1) * block_size); ++i) {
+          auto game = GameT::from_position_index(level[i]);
+          if (game.is_terminal()) continue;
+          for (auto const& move : game.legal_actions()) {
+            game.apply_action(move);
+            out.push_back(game.position_index());
+            game.undo_action(move);
+          }
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+      });
+      std::vector<std::uint64_t> next;
+      for (auto const& out : children) next.insert(next.end(), out.begin(), out.end());
+      if (next.empty()) break;
+      std::sort(next.begin(), next.end());
+      next.erase(std::unique(next.begin(), next.end()), next.end());
+      for (auto const index : next) {
+        if (seen[index / 64] >> (index % 64) & 1) {
+          throw golv::exception("Position reached at different depths: " + std::to_string(index));
+        }
+        _mark(seen, index);
+      }
+      levels.push_back(std::move(next));
+    }
+
+    // backward: the deepest level first
+    for (auto level = levels.rbegin(); level != levels.rend(); ++level) {
+      std::vector<std::uint8_t> codes(level->size());
+      parallel_for(_blocks(level->size()), threads, [&](size_t block) {
+        for (size_t i = block * block_size; i < std::min(level->size(), (block + 1) * block_size); ++i) {
+          auto game = GameT::from_position_index((*level)[i]);
+          if (game.is_terminal()) {
+            codes[i] = _encode(game.value());
+            continue;
+          }
+          auto const max = game.is_max();
+          std::uint8_t best = max ? _encode(-1) : _encode(1);
+          for (auto const& move : game.legal_actions()) {
+            game.apply_action(move);
+            auto const code = _code(words.data(), game.position_index());
+            game.undo_action(move);
+            best = max ? std::max(best, code) : std::min(best, code);
+          }
+          codes[i] = best;
+        }
+      });
+      for (size_t i = 0; i < level->size(); ++i) {
+        auto const index = (*level)[i];
+        words[index / positions_per_word] |= std::uint64_t{codes[i]} << (2 * (index % positions_per_word));
+      }
+      d->size += level->size();
+    }
+
+    d->words = words.data();
+    retrograde_table table;
+    table.data_ = std::move(d);
+    return table;
+  }
+
+  /**
+   * Map a table written by save() for the same game.
+   * Throws golv::exception if the file was written for another game, with another byte order or is truncated.
+   */
+  static retrograde_table open(std::string const& path) {
+    auto d = std::make_shared<data>();
+    d->file = mapped_file(path);
+    if (d->file.size() < sizeof(retrograde_header)) throw golv::exception("Not a retrograde table: " + path);
+    retrograde_header header;
+    std::memcpy(&header, d->file.data(), sizeof(header));
+    if (std::memcmp(header.magic, retrograde_header::magic_string, sizeof(header.magic)) != 0) {
+      throw golv::exception("Not a retrograde table: " + path);
+    }
+    if (header.version != retrograde_header::current_version) {
+      throw golv::exception("Unsupported retrograde table version: " + std::to_string(header.version));
+    }
+    if (header.byte_order != retrograde_header::byte_order_mark) {
+      throw golv::exception("Retrograde table written with a different byte order: " + path);
+    }
+    if (std::string_view(header.game, sizeof(header.game)) != _tag() || header.num_positions != GameT::num_positions) {
+      throw golv::exception("Retrograde table does not match the game: " + path);
+    }
+    if ((d->file.size() - sizeof(retrograde_header)) / sizeof(std::uint64_t) < _words()) {
+      throw golv::exception("Truncated retrograde table: " + path);
+    }
+    d->words = reinterpret_cast<std::uint64_t const*>(d->file.data() + sizeof(retrograde_header));
+    d->size = header.size;
+    retrograde_table table;
+    table.data_ = std::move(d);
+    return table;
+  }
+
+  /**
+   * Write the table to path (via a temporary file, such that readers never see a partial table).
+   */
+  void save(std::string const& path) const {
+    auto const tmp_path = path + ".tmp";
+    {
+      auto file = mapped_file::create(tmp_path, sizeof(retrograde_header) + memory());
+      retrograde_header header{};
+      std::memcpy(header.magic, retrograde_header::magic_string, sizeof(header.magic));
+      header.version = retrograde_header::current_version;
+      header.byte_order = retrograde_header::byte_order_mark;
+      auto const game = _tag();
+      std::copy(game.begin(), game.end(), header.game);
+      header.num_positions = GameT::num_positions;
+      header.size = size();
+      std::memcpy(file.data(), &header, sizeof(header));
+      std::memcpy(file.data() + sizeof(header), data_->words, memory());
+      file.flush();
+    }
+    std::filesystem::rename(tmp_path, path);
+  }
+
+  /**
+   * The value of a position, nothing if it is not reachable from the root.
+   */
+  std::optional<value_type> get(GameT const& game) const {
+    auto const code = _code(data_->words, game.position_index());
+    if (code == 0) return std::nullopt;
+    return static_cast<value_type>(code - 2);
+  }
+
+  /**
+   * EndgameTable: the value still to be gained, value() is 0 before the end.
+   */
+  std::optional<value_type> probe(GameT const& game) const { return get(game); }
+
+  /**
+   * Number of solved positions.
+   */
+  size_t size() const { return data_->size; }
+  size_t memory() const { return _words() * sizeof(std::uint64_t); }
+
+ private:
+  struct data {
+    std::vector<std::uint64_t> owned;
+    mapped_file file;
+    std::uint64_t const* words = nullptr;  // owned or the mapping of file
+    size_t size = 0;
+  };
+
+  retrograde_table() = default;
+
+  /**
+   * The name of the game padded with zeros to the size of retrograde_header::game.
+   */
+  static std::string _tag() {
+    std::string tag(sizeof(retrograde_header::game), '\0');
+    std::copy_n(GameT::name.begin(), std::min(GameT::name.size(), tag.size()), tag.begin());
+    return tag;
+  }
+
+  static constexpr size_t _words() { return (GameT::num_positions + positions_per_word - 1) / positions_per_word; }
+  static size_t _blocks(size_t positions) { return (positions + block_size - 1) / block_size; }
+
+  static void _mark(std::vector<std::uint64_t>& bits, std::uint64_t index) {
+    bits[index / 64] |= std::uint64_t{1} << (index % 64);
+  }
+
+  static std::uint8_t _encode(value_type value) {
+    if (value < -1 || value > 1) {
+      throw golv::exception("Retrograde analysis needs the values -1, 0 and 1: " + std::to_string(value));
+    }
+    return static_cast<std::uint8_t>(value + 2);
+  }
+
+  static std::uint8_t _code(std::uint64_t const* words, std::uint64_t index) {
+    return (words[index / positions_per_word] >> (2 * (index % positions_per_word))) & 3;
+  }
+
+  std::shared_ptr<data const> data_;
+};
+
+}  // namespace golv
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace golv {
+
+/**
+ * search_stats is the opt-in statistics policy of the solvers (alpha_beta, nega_max, mtd_f,
+ * minimal_window_search and cfr). It records the nodes visited per depth, the cutoffs by move index,
+ * the usage of the transposition table, re-searches (mtd_f, mws_binary_search) and the wall time.
+ * The counters accumulate over all solve() calls of a solver until clear().
+ */
+struct search_stats {
+  constexpr static size_t max_depth = 63;       // deeper nodes are counted at max_depth
+  constexpr static size_t max_move_index = 31;  // later cutoffs are counted at max_move_index
+
+  std::array<std::uint64_t, max_depth + 1> nodes_per_depth{};
+  std::array<std::uint64_t, max_move_index + 1> cutoffs_per_move{};
+  std::uint64_t tt_probes = 0;
+  std::uint64_t tt_cutoffs = 0;
+  std::uint64_t re_searches = 0;
+  std::chrono::nanoseconds wall_time{0};
+
+  void node(int depth) { ++nodes_per_depth[std::min<size_t>(depth, max_depth)]; }
+  void cutoff(size_t move_index) { ++cutoffs_per_move[std::min(move_index, max_move_index)]; }
+  void tt_probe() { ++tt_probes; }
+  void tt_cutoff() { ++tt_cutoffs; }
+  void re_search() { ++re_searches; }
+
+  void start() { start_ = std::chrono::steady_clock::now(); }
+  void stop() { wall_time += std::chrono::steady_clock::now() - start_; }
+
+  void clear() { *this = search_stats{}; }
+
+  std::uint64_t nodes() const { return std::accumulate(nodes_per_depth.begin(), nodes_per_depth.end(), std::uint64_t{0}); }
+
+  std::uint64_t cutoffs() const {
+    return std::accumulate(cutoffs_per_move.begin(), cutoffs_per_move.end(), std::uint64_t{0});
+  }
+
+  /**
+   * Deepest depth with a visited node.
+   */
+  size_t depth() const {
+    for (size_t d = max_depth + 1; d > 0; --d) {
+      if (nodes_per_depth[d - 1] != 0) return d - 1;
+    }
+    return 0;
+  }
+
+  /**
+   * Fraction of the cutoffs caused by the first move, i. e. the quality of the move ordering.
+   */
+  double first_move_cutoff_rate() const {
+    auto const total = cutoffs();
+    return total == 0 ? 0.0 : static_cast<double>(cutoffs_per_move[0]) / total;
+  }
+
+  double tt_cutoff_rate() const { return tt_probes == 0 ? 0.0 : static_cast<double>(tt_cutoffs) / tt_probes; }
+
+  /**
+   * The branching factor b of a uniform tree of depth() with the same number of nodes, 1 + b + ... + b^depth = nodes.
+   */
+  double effective_branching_factor() const {
+    auto const d = depth();
+    auto const n = static_cast<double>(nodes());
+    if (d == 0) return 0.0;
+    auto tree_size = [d](double b) {
+      double sum = 1.0, power = 1.0;
+      for (size_t i = 0; i < d; ++i) sum += (power *= b);
+      return sum;
+    };
+    double lo = 0.0, hi = std::max(1.0, n);
+    for (int i = 0; i < 100 && hi - lo > 1e-9; ++i) {
+      auto const mid = (lo + hi) / 2;
+      (tree_size(mid) < n ? lo : hi) = mid;
+    }
+    return (lo + hi) / 2;
+  }
+
+  double seconds() const { return std::chrono::duration<double>(wall_time).count(); }
+
+  double nodes_per_second() const { return wall_time.count() == 0 ? 0.0 : nodes() / seconds(); }
+
+  std::string to_json() const {
+    std::ostringstream os;
+    os << "{\"nodes\": " << nodes() << ", \"depth\": " << depth()
+       << ", \"effective_branching_factor\": " << effective_branching_factor() << ", \"cutoffs\": " << cutoffs()
+       << ", \"first_move_cutoff_rate\": " << first_move_cutoff_rate() << ", \"tt_probes\": " << tt_probes
+       << ", \"tt_cutoffs\": " << tt_cutoffs << ", \"re_searches\": " << re_searches
+       << ", \"wall_time_s\": " << seconds() << ", \"nodes_per_second\": " << nodes_per_second()
+       << ", \"nodes_per_depth\": [";
+    for (size_t d = 0; d <= depth(); ++d) {
+      os << (d == 0 ? "" : ", ") << nodes_per_depth[d];
+    }
+    os << "], \"cutoffs_per_move\": [";
+    auto const last = max_move_index + 1 -
+                      std::distance(cutoffs_per_move.rbegin(),
+                                    std::find_if(cutoffs_per_move.rbegin(), cutoffs_per_move.rend(),
+                                                 [](auto n) { return n != 0; }));
+    for (size_t i = 0; i < last; ++i) {
+      os << (i == 0 ? "" : ", ") << cutoffs_per_move[i];
+    }
+    os << "]}";
+    return os.str();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+};
+
+inline std::ostream& operator<<(std::ostream& os, search_stats const& stats) { return os << stats.to_json(); }
+
+/**
+ * no_search_stats is the default policy: all calls compile to nothing.
+ */
+struct no_search_stats {
+  constexpr void node(int) {}
+  constexpr void cutoff(size_t) {}
+  constexpr void tt_probe() {}
+  constexpr void tt_cutoff() {}
+  constexpr void re_search() {}
+  constexpr void start() {}
+  constexpr void stop() {}
+  constexpr void clear() {}
+};
+
+template <class T>
+struct with_stats : public std::true_type {};
+
+template <>
+struct with_stats<no_search_stats> : public std::false_type {};
+
+}  // namespace golv
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace golv {
+
+/**
+ * Depth of a table key, i. e. the number of remaining cards (bitset keys of skat)
+ * or the length of string keys (bridge, tictactoe, connectfour).
+ */
+template <class StateT>
+std::uint8_t key_depth(StateT const&) {
+  return 0;
+}
+
+template <size_t N>
+std::uint8_t key_depth(std::bitset<N> const& state) {
+  return static_cast<std::uint8_t>(state.count());
+}
+
+inline std::uint8_t key_depth(std::string const& state) {
+  return static_cast<std::uint8_t>(std::min<size_t>(state.size(), 255));
+}
+
+/**
+ * table_stats is the snapshot of the counters of a transposition table.
+ * Cutoffs are reported by the solvers, everything else by the table itself.
+ */
+struct table_stats {
+  constexpr static size_t max_depth = 63;  // deeper entries are counted at max_depth
+
+  std::uint64_t probes = 0;
+  std::uint64_t hits = 0;
+  std::uint64_t exact_cutoffs = 0;
+  std::uint64_t bound_cutoffs = 0;
+  std::uint64_t stores = 0;      // all writes
+  std::uint64_t overwrites = 0;  // entries replaced by another key
+  std::uint64_t collisions = 0;  // fingerprint (packed) or bucket (unordered) collisions
+  std::uint64_t size = 0;
+  std::uint64_t capacity = 0;  // 0 for tables which grow
+  std::array<std::uint64_t, max_depth + 1> entries_per_depth{};
+
+  double hit_rate() const { return probes == 0 ? 0.0 : static_cast<double>(hits) / probes; }
+
+  double cutoff_rate() const { return probes == 0 ? 0.0 : static_cast<double>(exact_cutoffs + bound_cutoffs) / probes; }
+
+  /**
+   * Occupied fraction of the table (or 1 for growing tables).
+   */
+  double fill_ratio() const {
+    if (capacity == 0) return size == 0 ? 0.0 : 1.0;
+    return static_cast<double>(size) / capacity;
+  }
+
+  /**
+   * Fraction of the entries (or the capacity of fixed-size tables) used by keys of depth.
+   */
+  double fill_ratio(size_t depth) const {
+    auto const total = capacity == 0 ? size : capacity;
+    return total == 0 ? 0.0 : static_cast<double>(entries_per_depth[std::min(depth, max_depth)]) / total;
+  }
+
+  std::string to_json() const {
+    std::ostringstream os;
+    os << "{\"probes\": " << probes << ", \"hits\": " << hits << ", \"exact_cutoffs\": " << exact_cutoffs
+       << ", \"bound_cutoffs\": " << bound_cutoffs << ", \"stores\": " << stores << ", \"overwrites\": " << overwrites
+       << ", \"collisions\": " << collisions << ", \"size\": " << size << ", \"capacity\": " << capacity
+       << ", \"entries_per_depth\": {";
+    bool first = true;
+    for (size_t d = 0; d <= max_depth; ++d) {
+      if (entries_per_depth[d] == 0) continue;
+      os << (first ? "" : ", ") << "\"" << d << "\": " << entries_per_depth[d];
+      first = false;
+    }
+    os << "}}";
+    return os.str();
+  }
+};
+
+inline std::ostream& operator<<(std::ostream& os, table_stats const& stats) { return os << stats.to_json(); }
+
+/**
+ * table_counters is the counting policy of the transposition tables.
+ */
+class table_counters {
+ public:
+  void probe() { ++stats_.probes; }
+  void hit() { ++stats_.hits; }
+  void cutoff(bool exact) { ++(exact ? stats_.exact_cutoffs : stats_.bound_cutoffs); }
+  void store() { ++stats_.stores; }
+  void collision() { ++stats_.collisions; }
+
+  void insert(std::uint8_t depth) { ++stats_.entries_per_depth[std::min<size_t>(depth, table_stats::max_depth)]; }
+
+  void overwrite(std::uint8_t old_depth) {
+    ++stats_.overwrites;
+    --stats_.entries_per_depth[std::min<size_t>(old_depth, table_stats::max_depth)];
+  }
+
+  void clear() { stats_ = table_stats{}; }
+
+  table_stats const& stats() const { return stats_; }
+
+ private:
+  table_stats stats_;
+};
+
+/**
+ * no_table_counters is the default policy: all calls compile to nothing.
+ */
+struct no_table_counters {
+  constexpr void probe() {}
+  constexpr void hit() {}
+  constexpr void cutoff(bool) {}
+  constexpr void store() {}
+  constexpr void collision() {}
+  constexpr void insert(std::uint8_t) {}
+  constexpr void overwrite(std::uint8_t) {}
+  constexpr void clear() {}
+
+  table_stats stats() const { return {}; }
+};
+
+template <class T>
+struct with_counters : public std::true_type {};
+
+template <>
+struct with_counters<no_table_counters> : public std::false_type {};
+
+/**
+ * Report a cutoff caused by a table lookup (no-op for tables without counters).
+ */
+template <class TableT>
+constexpr void count_cutoff(TableT& table, bool exact) {
+  if constexpr (requires { table.cutoff(exact); }) {
+    table.cutoff(exact);
+  }
+}
+
+}  // namespace golv
@@ -1,6 +1,11 @@
+#pragma once
+
+#include <golv/algorithms/table_counters.hpp>
 #include <golv/traits/game.hpp>
 #include <golv/traits/transposition_table.hpp>
+#include <limits>
 #include <unordered_map>
+#include <vector>
 
 namespace golv {
 /**
@@ -11,13 +16,15 @@ enum class lookup_value_type { exact, lower_bound, upper_bound };
 /**
  * unordered_table is a simple TranspositionTable based on std::unordered_map.
  * It complies with the TranspositionTable concept.
+ * Counting (probes, hits, ...) is enabled with CountersT = table_counters.
  */
-template <Game GameT>
+template <Game GameT, class CountersT = no_table_counters>
 struct unordered_table {
   using storage_type = std::pair<lookup_value_type, typename GameT::value_type>;
   using map_type = std::unordered_map<typename GameT::state_type, storage_type>;
 
   map_type map_;
+  [[no_unique_address]] mutable CountersT counters_;
 
   auto size() const { return map_.size(); }
 
@@ -29,18 +36,42 @@ struct unordered_table {
   storage_type const& get(typename GameT::state_type const& state) const {
     const static storage_type _invalid = {lookup_value_type::lower_bound,
                                           std::numeric_limits<typename GameT::value_type>::lowest()};
+    counters_.probe();
     auto it = map_.find(state);
-    if (it != map_.end())
+    if (it != map_.end()) {
+      counters_.hit();
       return it->second;
-    else
+    } else
       return _invalid;
   }
 
-  constexpr void set(typename GameT::state_type const& state, storage_type type_value) { map_[state] = type_value; }
+  constexpr void set(typename GameT::state_type const& state, storage_type type_value) {
+    if constexpr (with_counters<CountersT>::value) {
+      counters_.store();
+      auto [it, inserted] = map_.insert_or_assign(state, type_value);
+      if (inserted) {
+        counters_.insert(key_depth(state));
+        if (map_.bucket_size(map_.bucket(state)) > 1) counters_.collision();
+      }
+    } else {
+      map_[state] = type_value;
+    }
+  }
 
   constexpr void set(typename GameT::state_type const& state, lookup_value_type type,
                      typename GameT::value_type const& value) {
-    map_[state] = {type, value};
+    set(state, {type, value});
+  }
+
+  /**
+   * Called by the solvers if a lookup caused a cutoff.
+   */
+  void cutoff(bool exact) { counters_.cutoff(exact); }
+
+  table_stats stats() const {
+    table_stats stats = counters_.stats();
+    stats.size = map_.size();
+    return stats;
   }
 };
 
@@ -63,10 +94,10 @@ struct unordered_table {
 //   }
 // };
 
-template <class GameT>
-std::ostream& operator<<(std::ostream& os, unordered_table<GameT> const& t) {
+template <class GameT, class CountersT>
+std::ostream& operator<<(std::ostream& os, unordered_table<GameT, CountersT> const& t) {
   os << "Unordered Map = " << t.map_.size() << std::endl;
-  using storage_type = typename unordered_table<GameT>::storage_type;
+  using storage_type = typename unordered_table<GameT, CountersT>::storage_type;
   using value_type = std::pair<typename GameT::state_type, storage_type>;
   std::vector<value_type> vec;
   for (auto const& [key, value] : t.map_) {
@@ -88,6 +119,7 @@ auto lookup_before(TableT& table, GameT const& game, typename GameT::value_type&
       auto const& lookup = table.get(game.state());
       switch (lookup.first) {
         case lookup_value_type::exact:
+          count_cutoff(table, true);
           return {true, lookup.second};
         case lookup_value_type::lower_bound:
           a = std::max(a, lookup.second);
@@ -97,6 +129,7 @@ auto lookup_before(TableT& table, GameT const& game, typename GameT::value_type&
           break;
       }
       if (b <= a) {
+        count_cutoff(table, false);
         if (game.is_max())
           return {true, a};
         else
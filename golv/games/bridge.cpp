@@ -8,29 +8,11 @@
 
 namespace golv {
 
-bool kind_less(kind left, kind right) {
-  // > since ace = 0, king = 1, etc.
-  return static_cast<int>(left) > static_cast<int>(right);
-}
-
-bool bridge_card_order::operator()(card const& left, card const& right) const {
-  if (left.get_suit() == right.get_suit()) {
-    return kind_less(left.get_kind(), right.get_kind());
-  }
-  if (left.get_suit() == lead_suit) {
-    return false;
-  }
-  if (right.get_suit() == lead_suit) {
-    return true;
-  }
-  return static_cast<int>(left.get_suit()) > static_cast<int>(right.get_suit());
-}
-
 bridge::move_range bridge::legal_actions() const {
   bridge::move_range legal;
   auto const& cards = state_[*current_player_];
   if (tricks_.empty() || tricks_.back().cards_.empty()) {
-    legal = cards;
+    legal = move_range(cards.begin(), cards.end());
   } else {
     auto lead_card = tricks_.back().cards_.front();
     auto suit_order = [](card const& left, card const& right) { return left.get_suit() > right.get_suit(); };
@@ -39,7 +21,7 @@ bridge::move_range bridge::legal_actions() const {
     if (rng.first != rng.second) {
       legal = move_range(rng.first, rng.second);
     } else {
-      legal = cards;
+      legal = move_range(cards.begin(), cards.end());
     }
   }
   GOLV_LOG_TRACE("legal_actions for player " << *current_player_ << ": " << legal);
@@ -50,13 +32,15 @@ bridge::player_type
 bridge::get_trick_winner() const
 {
     assert(!tricks_.empty());
-    auto last_trick = tricks_.back().cards_;
-    std::sort(std::begin(last_trick), std::end(last_trick), bridge_card_order{last_trick.front().get_suit()});
-    GOLV_LOG_TRACE("Sorted trick: " << last_trick);
-    auto it = std::find(std::begin(tricks_.back().cards_), std::end(tricks_.back().cards_), last_trick.back());
-    assert(it != tricks_.back().cards_.end());
-    bridge::player_type winner = (tricks_.back().leader_ + (it - tricks_.back().cards_.begin())) % 4;
-    GOLV_LOG_TRACE("Trick Winner = " << winner << " for trick " << tricks_.back().cards_);
+    auto const& cards = tricks_.back().cards_;
+    bridge_card_order const order{cards.front().get_suit(), strain_};
+    size_t best = 0;
+    for (size_t i = 1; i < cards.size(); ++i) {
+        if (order.rank(cards[best]) < order.rank(cards[i]))
+            best = i;
+    }
+    bridge::player_type winner = (tricks_.back().leader_ + best) % 4;
+    GOLV_LOG_TRACE("Trick Winner = " << winner << " for trick " << cards);
     return winner;
 }
 
@@ -87,6 +71,7 @@ bridge::apply_action(bridge::move_type const& move)
     auto& cards = state_[*current_player_];
     auto it = std::find(std::begin(cards), std::end(cards), move);
     assert(it != std::end(cards));
+    journal_.push_back({ move, static_cast<std::uint8_t>(it - cards.begin()), *current_player_ });
     cards.erase(it);
 
     if (tricks_.empty())
@@ -97,6 +82,10 @@ bridge::apply_action(bridge::move_type const& move)
 
     if (tricks_.back().cards_.size() == 4) {
         current_player_ = get_trick_winner();
+        if (is_max())
+            ++value_;
+        else
+            ++opp_value_;
         tricks_.push_back({ {}, *current_player_ });
     }
 }
@@ -105,41 +94,39 @@ void
 bridge::undo_action(bridge::move_type const& move)
 {
     assert(!tricks_.empty());
-    if (!tricks_.back().cards_.empty()) {
-        --current_player_;
-        GOLV_LOG_TRACE("undo_action for player " << *current_player_ << ": " << move);
-        auto& cards = state_[*current_player_];
-        cards.push_back(move);
-        std::sort(cards.begin(), cards.end(), bridge_card_order{});
-        tricks_.back().cards_.pop_back();
-    } else {
+    assert(!journal_.empty() && journal_.back().move_ == move);
+    auto const entry = journal_.back();
+    journal_.pop_back();
+    if (tricks_.back().cards_.empty()) {
+        if (is_max())
+            --value_;
+        else
+            --opp_value_;
         tricks_.pop_back();
-        tricks_.back().cards_.pop_back();
-        current_player_ = tricks_.back().leader_;
-        --current_player_;
-        GOLV_LOG_TRACE("undo_action for player " << *current_player_ << ": " << move);
-        state_[*current_player_].push_back(move);
-        std::sort(state_[*current_player_].begin(), state_[*current_player_].end(), bridge_card_order{});
     }
+    tricks_.back().cards_.pop_back();
+    current_player_ = entry.player_;
+    GOLV_LOG_TRACE("undo_action for player " << *current_player_ << ": " << move);
+    auto& cards = state_[entry.player_];
+    cards.insert(cards.begin() + entry.slot_, move);
 }
 
 bridge::value_type
 bridge::value() const
 {
-  int soloist = soloist_ % 2;
-#if 0
-    if (!tricks_.empty() && tricks_.back().cards_.empty()) {
-        return (tricks_.back().leader_ % 2) == soloist ? 1 : 0;
-    }
+    return value_;
+}
 
-    return 0;
-#else
-  bridge::value_type sum = 0;
-  for (size_t i = 1; i < tricks_.size(); ++i) {
-    if (tricks_[i].leader_ % 2 == soloist) ++sum;
-  }
-  return sum;
-#endif
+bridge::value_type
+bridge::opp_value() const
+{
+    return opp_value_;
+}
+
+bridge::value_type
+bridge::total_value() const
+{
+    return total_value_;
 }
 
 bool
@@ -168,9 +155,10 @@ void
 bridge::deal(internal_state_type const& state)
 {
     state_ = state;
+    total_value_ = static_cast<value_type>(state_[0].size());
 }
 
-const std::vector<bridge::trick>&
+const bridge::trick_range&
 bridge::tricks() const
 {
     return tricks_;
@@ -187,4 +175,16 @@ bridge::set_soloist(player_type soloist)
 {
     soloist_ = soloist;
 }
+
+void
+bridge::set_strain(strain s)
+{
+    strain_ = s;
+}
+
+strain
+bridge::get_strain() const
+{
+    return strain_;
+}
 } // namespace golv
\ No newline at end of file
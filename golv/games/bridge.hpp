@@ -2,20 +2,75 @@
 
 #include <golv/games/cards.hpp>
 #include <golv/util/cyclic_number.hpp>
+#include <golv/util/static_vector.hpp>
 
 #include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace golv {
 
+/**
+ * strain of a bridge contract: a trump suit or no trump.
+ */
+enum class strain
+{
+  spades = static_cast<int>(suit::spades),
+  hearts = static_cast<int>(suit::hearts),
+  diamonds = static_cast<int>(suit::diamonds),
+  clubs = static_cast<int>(suit::clubs),
+  notrump
+};
+
+namespace detail {
+
+/**
+ * Rank of a card in a bridge trick (ascending): trump suit > lead suit > the other suits
+ * (clubs < diamonds < hearts < spades). Within a suit: 2 < 3 < ... < K < A.
+ */
+constexpr std::uint8_t bridge_rank(card c, suit lead_suit, strain s = strain::notrump) {
+  auto const kind_rank = 12 - static_cast<int>(c.get_kind());
+  if (static_cast<int>(c.get_suit()) == static_cast<int>(s)) return static_cast<std::uint8_t>(128 + kind_rank);
+  if (c.get_suit() == lead_suit) return static_cast<std::uint8_t>(64 + kind_rank);
+  return static_cast<std::uint8_t>(16 * (3 - static_cast<int>(c.get_suit())) + kind_rank);
+}
+
+/**
+ * bridge_ranks[strain][lead suit][card index]
+ */
+constexpr auto bridge_ranks = [] {
+  std::array<std::array<std::array<std::uint8_t, no_card + 1>, 4>, 5> ranks{};
+  for (int t = 0; t < 5; ++t) {
+    for (int s = 0; s < 4; ++s) {
+      for (int i = 0; i <= no_card; ++i) {
+        ranks[t][s][i] = bridge_rank(card::from_index(static_cast<card::index_type>(i)), static_cast<suit>(s),
+                                     static_cast<strain>(t));
+      }
+    }
+  }
+  return ranks;
+}();
+
+}  // namespace detail
+
+/**
+ * bridge_card_order compares cards by their precomputed rank, i. e. the winner of a trick is the card
+ * with the highest rank for the suit of the first card.
+ */
 struct bridge_card_order {
   suit lead_suit = suit::spades;
+  strain strain_ = strain::notrump;
+
+  constexpr std::uint8_t rank(card const& c) const {
+    return detail::bridge_ranks[static_cast<int>(strain_)][static_cast<int>(lead_suit)][c.index()];
+  }
 
-  bool operator()(card const& left, card const& right) const;
+  constexpr bool operator()(card const& left, card const& right) const { return rank(left) < rank(right); }
 };
 
 /**
- *   bridge describes a simple bridge game with no trump.
+ *   bridge describes a simple bridge game in a strain (no trump unless set_strain() is called).
  *   the cards are dealt from a given deck which can be smaller than 52 cards.
  *   the number of players is 4. this, however, can be easily changed in the future (as a template argument).
  *   the class suffices the Game concept.
@@ -24,36 +79,77 @@ class bridge
 {
   public:
     constexpr static size_t num_players = 4;
+    constexpr static std::string_view name = "bridge";
 
     using move_type = card;
-    using move_range = std::vector<move_type>;
+    using move_range = static_vector<move_type, 13>;
     using value_type = short;
     using player_type = unsigned short;
-    using internal_state_type = std::array<move_range, num_players>;
+    using internal_state_type = std::array<golv::hand, num_players>;
     using state_type = std::string;
     using cyclic_player_type = cyclic_number<player_type, num_players>;
 
     struct trick
     {
-        std::vector<card> cards_;
+        static_vector<card, num_players> cards_;
         player_type leader_;
     };
 
+    // at most 13 tricks plus the empty trick after the last one
+    using trick_range = static_vector<trick, 14>;
+
   private:
     internal_state_type state_;
     cyclic_player_type current_player_ = 0;
     player_type soloist_ = 0;
-    std::vector<trick> tricks_;
+    strain strain_ = strain::notrump;
+    trick_range tricks_;
+
+    /**
+     * Journal entry of a move, such that undo_action() restores the hand and the current player
+     * without sorting.
+     */
+    struct undo_entry
+    {
+        card move_;
+        std::uint8_t slot_; // position of the card in the hand
+        player_type player_;
+    };
+    static_vector<undo_entry, 52> journal_;
 
     player_type get_trick_winner() const;
 
   public:
    move_range legal_actions() const;
+
+   /**
+    * Number of tricks won by the soloist and the partner.
+    */
    value_type value() const;
+
+   /**
+    * Number of tricks won by the opponents.
+    */
+   value_type opp_value() const;
+
+   /**
+    * Number of tricks of the deal, i. e. value() + opp_value() at the end.
+    */
+   value_type total_value() const;
+
    bool is_max() const;
 
+   /**
+    * Set the soloist before the first move (the trick counts are kept incrementally).
+    */
    void set_soloist(player_type soloist);
 
+   /**
+    * Set the strain (trump suit or no trump) before the first move.
+    */
+   void set_strain(strain s);
+   strain get_strain() const;
+
    player_type current_player() const;
    void apply_action(move_type const& move);
    void undo_action(move_type const& move);
@@ -62,11 +158,13 @@ class bridge
    bool is_new_trick() const;
    state_type state() const;
    void deal(internal_state_type const& state);
-   const std::vector<trick>& tricks() const;
+   const trick_range& tricks() const;
    bool hash_me() const { return is_new_trick() && is_max(); }
 
   private:
     value_type value_{ 0 };
+    value_type opp_value_{ 0 };
+    value_type total_value_{ 0 };
 
     void next_player();
 };
@@ -5,12 +5,6 @@
 
 namespace golv {
 
-card::code_type to_code(kind k, suit s) {
-  card::code_type code;
-  code.set(13 * static_cast<size_t>(s) + static_cast<size_t>(k));
-  return code;
-}
-
 kind to_kind(char k) {
   switch (k) {
     case 'A':
@@ -64,67 +58,11 @@ card to_card(std::string const& str) {
   return card{k, s};
 }
 
-card::card(const char* c) {
-  card x = to_card(std::string(c));
-  this->kind_ = x.get_kind();
-  this->suit_ = x.get_suit();
-  code_ = to_code(this->get_kind(), this->get_suit());
-}
-
-card::card(kind k, suit s) : kind_(k), suit_(s), code_(to_code(k, s)) {}
-
-char to_char(suit s) {
-  switch (s) {
-    case suit::spades:
-      return 's';
-    case suit::hearts:
-      return 'h';
-    case suit::diamonds:
-      return 'd';
-    case suit::clubs:
-      return 'c';
-  }
-  throw golv::exception("Error parsing suit");
-}
-
-char to_char(kind k) {
-  switch (k) {
-    case kind::ace:
-      return 'A';
-    case kind::king:
-      return 'K';
-    case kind::queen:
-      return 'Q';
-    case kind::jack:
-      return 'J';
-    case kind::ten:
-      return 'T';
-    case kind::nine:
-      return '9';
-    case kind::eight:
-      return '8';
-    case kind::seven:
-      return '7';
-    case kind::six:
-      return '6';
-    case kind::five:
-      return '5';
-    case kind::four:
-      return '4';
-    case kind::three:
-      return '3';
-    case kind::deuce:
-      return '2';
-  }
-  throw golv::exception("Error parsing kind");
-}
+card::card(const char* c) : card(to_card(std::string(c))) {}
 
 std::string to_string(const card& c) {
-  return std::string(1, to_char(c.get_kind())) + std::string(1, to_char(c.get_suit()));
-}
-
-bool operator==(const card& left, const card& right) {
-  return left.get_kind() == right.get_kind() && left.get_suit() == right.get_suit();
+  auto const& name = detail::card_names[c.index()];
+  return std::string(name.data(), name.size());
 }
 
 std::ostream& operator<<(std::ostream& os, const card& c) {
@@ -143,10 +81,6 @@ std::string to_string(const hand& h) {
   return ss.str();
 }
 
-bool operator<(const card& left, const card& right) {  //
-  return left.code().to_ullong() < right.code().to_ullong();
-}
-
 hand create_bridge_deck() { return create_deck<13>(); }
 hand create_skat_deck() { return create_deck<8>(); }
 
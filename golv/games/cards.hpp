@@ -2,10 +2,13 @@
 
 #include <array>
 #include <bitset>
+#include <cstdint>
 #include <ostream>
 #include <vector>
 #include <cassert>
 #include <algorithm>
+#include <string>
+#include <type_traits>
 
 namespace golv {
 
@@ -34,27 +37,77 @@ enum class kind
     deuce
 };
 
+namespace detail {
+
+constexpr std::uint8_t no_card = 52;
+
+/**
+ * Lookup tables of the card index 13 * suit + kind (plus no_card for default constructed cards).
+ */
+constexpr auto card_kinds = [] {
+  std::array<kind, no_card + 1> kinds{};
+  for (int i = 0; i < no_card; ++i) kinds[i] = static_cast<kind>(i % 13);
+  return kinds;
+}();
+
+constexpr auto card_suits = [] {
+  std::array<suit, no_card + 1> suits{};
+  for (int i = 0; i < no_card; ++i) suits[i] = static_cast<suit>(i / 13);
+  return suits;
+}();
+
+constexpr auto card_codes = [] {
+  std::array<std::uint64_t, no_card + 1> codes{};
+  for (int i = 0; i < no_card; ++i) codes[i] = std::uint64_t{1} << i;
+  return codes;
+}();
+
+constexpr auto card_names = [] {
+  constexpr char kind_chars[] = "AKQJT98765432";
+  constexpr char suit_chars[] = "shdc";
+  std::array<std::array<char, 2>, no_card + 1> names{};
+  for (int i = 0; i < no_card; ++i) names[i] = {kind_chars[i % 13], suit_chars[i / 13]};
+  names[no_card] = {'-', '-'};
+  return names;
+}();
+
+}  // namespace detail
+
+/**
+ * card is a single byte, the index 13 * suit + kind, such that hands, tricks and move lists are dense
+ * byte arrays. Kind, suit, code (the bit of the index) and name are table lookups.
+ */
 class card {
  public:
   using code_type = std::bitset<64>;
+  using index_type = std::uint8_t;
 
-  card() = default;
+  constexpr card() = default;
   card(const char* c);
-  card(kind k, suit s);
-  kind get_kind() const { return kind_; }
-  suit get_suit() const { return suit_; }
-  code_type code() const { return code_; }
+  constexpr card(kind k, suit s) : index_(static_cast<index_type>(13 * static_cast<int>(s) + static_cast<int>(k))) {}
+
+  constexpr static card from_index(index_type index) {
+    card c;
+    c.index_ = index;
+    return c;
+  }
+
+  constexpr index_type index() const { return index_; }
+  constexpr kind get_kind() const { return detail::card_kinds[index_]; }
+  constexpr suit get_suit() const { return detail::card_suits[index_]; }
+  constexpr code_type code() const { return code_type{detail::card_codes[index_]}; }
+
+  friend constexpr bool operator==(card const& left, card const& right) { return left.index_ == right.index_; }
+  friend constexpr bool operator<(card const& left, card const& right) { return left.index_ < right.index_; }
 
  private:
-  kind kind_;
-  suit suit_;
-  code_type code_ = 0;
+  index_type index_ = detail::no_card;
 };
 
+static_assert(sizeof(card) == 1 && std::is_trivially_copyable_v<card>);
+
 std::string to_string(const card& c);
-bool operator==(const card& left, const card& right);
 std::ostream& operator<<(std::ostream& os, const card& c);
-bool operator<(const card& left, const card& right);
 
 /**
  * hand
@@ -1,12 +1,16 @@
 #include <golv/algorithms/utility.hpp>
 #include <golv/games/connectfour.hpp>
 
+#include <bit>
+
 namespace golv {
-connectfour::move_range
-connectfour::legal_actions() const
+
+template <size_t Width, size_t Height>
+typename basic_connectfour<Width, Height>::move_range
+basic_connectfour<Width, Height>::legal_actions() const
 {
     move_range valid;
-    for (size_t col = 0; col < connectfour::width; ++col) {
+    for (size_t col = 0; col < width; ++col) {
         if (state_[col].size() < height) {
             valid.push_back(col);
         }
@@ -14,22 +18,25 @@ connectfour::legal_actions() const
     return valid;
 }
 
+template <size_t Width, size_t Height>
 void
-connectfour::switch_player()
+basic_connectfour<Width, Height>::switch_player()
 {
     current_player_ = current_player_ == player_type::yellow ? player_type::red : player_type::yellow;
 }
 
+template <size_t Width, size_t Height>
 void
-connectfour::apply_action(connectfour::move_type move)
+basic_connectfour<Width, Height>::apply_action(move_type move)
 {
     assert(state_[move].size() < height);
     state_[move].push_back(current_player_);
     switch_player();
 }
 
+template <size_t Width, size_t Height>
 void
-connectfour::undo_action(connectfour::move_type move)
+basic_connectfour<Width, Height>::undo_action(move_type move)
 {
     assert(!state_[move].empty());
     state_[move].pop_back();
@@ -37,36 +44,49 @@ connectfour::undo_action(connectfour::move_type move)
     switch_player();
 }
 
-bool
-connectfour::check_rows()
-{
-    for (size_t row = 0; row < height; ++row) {
-        if (state_[width / 2].size() <= row)
-            break;
+namespace {
 
-        auto const center = state_[width / 2][row];
+/**
+ * The last field in a direction (col_step, row_step) from a start field with the same piece.
+ */
+template <class StateT>
+std::pair<size_t, size_t>
+advance_equal(StateT const& state, size_t start_col, size_t start_row, int col_step, int row_step)
+{
+    auto const& s = state[start_col][start_row];
+    auto next_row = start_row;
+    auto next_col = start_col;
+    do {
+        next_row += row_step;
+        next_col += col_step;
+    } while (next_col < state.size() && next_row < state[next_col].size() && state[next_col][next_row] == s);
+    next_row -= row_step;
+    next_col -= col_step;
+    return { next_col, next_row };
+}
 
-        // check left half
-        if (std::all_of(std::begin(state_), std::begin(state_) + width / 2, [&](auto col) {
-                return col.size() > row && col[row] == center;
-            })) {
-            value_ = static_cast<value_type>(center);
-            return true;
-        }
+} // namespace
 
-        // check right half
-        if (std::all_of(std::begin(state_) + width / 2 + 1, std::end(state_), [&](auto const& col) {
-                return col.size() > row && col[row] == center;
-            })) {
-            value_ = static_cast<value_type>(center);
+template <size_t Width, size_t Height>
+bool
+basic_connectfour<Width, Height>::check_rows()
+{
+    // every row of N covers the middle column
+    auto const mid = width / 2;
+    for (size_t row = 0; row < state_[mid].size(); ++row) {
+        auto const right = advance_equal(state_, mid, row, 1, 0);
+        auto const left = advance_equal(state_, mid, row, -1, 0);
+        if (right.first - left.first + 1 >= N) {
+            value_ = static_cast<value_type>(state_[mid][row]);
             return true;
         }
     }
     return false;
 }
 
+template <size_t Width, size_t Height>
 bool
-connectfour::check_cols()
+basic_connectfour<Width, Height>::check_cols()
 {
     // check cols
     for (auto const& col : state_) {
@@ -83,37 +103,21 @@ connectfour::check_cols()
     return false;
 }
 
-namespace {
-std::pair<size_t, size_t>
-advance_equal(const connectfour::ext_state_type& state, size_t start_col, size_t start_row, bool inc_col, bool inc_row)
-{
-    auto const& s = state[start_col][start_row];
-    auto next_row = start_row;
-    auto next_col = start_col;
-    do {
-        inc_row ? ++next_row : --next_row;
-        inc_col ? ++next_col : --next_col;
-    } while (next_col < state.size() && next_row < state[next_col].size() && state[next_col][next_row] == s);
-    inc_row ? --next_row : ++next_row;
-    inc_col ? --next_col : ++next_col;
-    return { next_col, next_row };
-}
-} // namespace
-
+template <size_t Width, size_t Height>
 bool
-connectfour::check_diags()
+basic_connectfour<Width, Height>::check_diags()
 {
     auto mid = width / 2;
     for (size_t row = 0; row < state_[mid].size(); ++row) {
-        auto right_rng = advance_equal(state_, mid, row, true, true);
-        auto left_rng = advance_equal(state_, mid, row, false, false);
+        auto right_rng = advance_equal(state_, mid, row, 1, 1);
+        auto left_rng = advance_equal(state_, mid, row, -1, -1);
         if (right_rng.first - left_rng.first + 1 >= N) {
             value_ = static_cast<value_type>(state_[mid][row]);
             return true;
         }
 
-        right_rng = advance_equal(state_, mid, row, true, false);
-        left_rng = advance_equal(state_, mid, row, false, true);
+        right_rng = advance_equal(state_, mid, row, 1, -1);
+        left_rng = advance_equal(state_, mid, row, -1, 1);
         if (right_rng.first - left_rng.first + 1 >= N) {
             value_ = static_cast<value_type>(state_[mid][row]);
             return true;
@@ -123,8 +127,9 @@ connectfour::check_diags()
     return false;
 }
 
+template <size_t Width, size_t Height>
 bool
-connectfour::is_terminal()
+basic_connectfour<Width, Height>::is_terminal()
 {
     if (is_terminal_)
         return true;
@@ -135,13 +140,14 @@ connectfour::is_terminal()
         value_ = 0;
         // check if all cols are full
         is_terminal_ =
-          std::all_of(std::begin(state_), std::end(state_), [](auto col) { return col.size() == connectfour::height; });
+          std::all_of(std::begin(state_), std::end(state_), [](auto const& col) { return col.size() == height; });
     }
     return is_terminal_;
 }
 
-connectfour::value_type
-connectfour::value()
+template <size_t Width, size_t Height>
+typename basic_connectfour<Width, Height>::value_type
+basic_connectfour<Width, Height>::value()
 {
     if (is_terminal())
         return value_;
@@ -149,13 +155,15 @@ connectfour::value()
         return 0;
 }
 
-connectfour::connectfour()
+template <size_t Width, size_t Height>
+basic_connectfour<Width, Height>::basic_connectfour()
   : state_{ width, std::vector<player_type>{} }
 {
 }
 
-connectfour::state_type
-connectfour::state() const
+template <size_t Width, size_t Height>
+typename basic_connectfour<Width, Height>::state_type
+basic_connectfour<Width, Height>::state() const
 {
     // convert ext_state_type to state_type
     state_type state;
@@ -170,4 +178,42 @@ connectfour::state() const
     return state;
 }
 
-} // namespace golv
\ No newline at end of file
+template <size_t Width, size_t Height>
+std::uint64_t
+basic_connectfour<Width, Height>::position_index() const
+{
+    std::uint64_t index = 0;
+    for (size_t col = 0; col < width; ++col) {
+        std::uint64_t code = std::uint64_t{ 1 } << state_[col].size();
+        for (size_t row = 0; row < state_[col].size(); ++row) {
+            if (state_[col][row] == player_type::red)
+                code |= std::uint64_t{ 1 } << row;
+        }
+        index |= code << (col * (height + 1));
+    }
+    return index;
+}
+
+template <size_t Width, size_t Height>
+basic_connectfour<Width, Height>
+basic_connectfour<Width, Height>::from_position_index(std::uint64_t index)
+{
+    basic_connectfour game;
+    size_t pieces = 0;
+    for (size_t col = 0; col < width; ++col) {
+        auto const code = (index >> (col * (height + 1))) & ((std::uint64_t{ 1 } << (height + 1)) - 1);
+        assert(code != 0);
+        auto const size = static_cast<size_t>(std::bit_width(code)) - 1;
+        for (size_t row = 0; row < size; ++row) {
+            game.state_[col].push_back((code >> row) & 1 ? player_type::red : player_type::yellow);
+        }
+        pieces += size;
+    }
+    game.current_player_ = pieces % 2 == 0 ? player_type::yellow : player_type::red;
+    return game;
+}
+
+template class basic_connectfour<7, 6>;
+template class basic_connectfour<5, 4>;
+
+} // namespace golv
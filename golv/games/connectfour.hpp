@@ -1,29 +1,40 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
+#include <golv/util/static_vector.hpp>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace golv {
 
 /**
- *   defines a connectfour game on a 7x6 board, and two players.
+ *   defines a connectfour game on a Width x Height board, and two players.
+ *   Every line of four in a row has to cover the middle column, i. e. Width is at most 7.
  */
-class connectfour {
+template <size_t Width, size_t Height>
+class basic_connectfour {
 public:
   using move_type = size_t;
-  using move_range = std::vector<move_type>;
   using value_type = short;
 
-  constexpr static size_t width = 7;
-  constexpr static size_t height = 6;
+  constexpr static std::string_view name = "connectfour";
+  constexpr static size_t width = Width;
+  using move_range = static_vector<move_type, width>;
+  constexpr static size_t height = Height;
+
+  /**
+   * Positions of position_index(): height + 1 bits per column.
+   */
+  constexpr static std::uint64_t num_positions = std::uint64_t{1} << (width * (height + 1));
 
   enum class player_type { yellow = 1, red = -1 };
 
   using ext_state_type = std::vector<std::vector<player_type>>;
   using state_type = std::string;
 
-  connectfour();
+  basic_connectfour();
   bool hash_me() const { return true; }
 
   player_type current_player() const { return current_player_; }
@@ -35,6 +46,13 @@ public:
   value_type value();
   state_type state() const;
 
+  /**
+   * Perfect hash of the position: each column is the bits of its red pieces (from the bottom) below a
+   * bit marking its height.
+   */
+  std::uint64_t position_index() const;
+  static basic_connectfour from_position_index(std::uint64_t index);
+
 private:
   player_type current_player_ = player_type::yellow;
   ext_state_type state_;
@@ -48,13 +66,12 @@ private:
 
   constexpr static size_t N = 4;
 
-  std::vector<connectfour::player_type>
-  get_minor_diag(connectfour::ext_state_type const &state, size_t row,
-                 size_t col);
-
-  std::vector<connectfour::player_type>
-  get_major_diag(connectfour::ext_state_type const &state, size_t row,
-                 size_t col);
+  static_assert(width >= N && width <= 2 * N - 1 && height >= 1);
 };
 
+extern template class basic_connectfour<7, 6>;
+extern template class basic_connectfour<5, 4>;
+
+using connectfour = basic_connectfour<7, 6>;
+
 } // namespace golv
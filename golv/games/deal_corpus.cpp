@@ -0,0 +1,218 @@
+#include <golv/games/deal_corpus.hpp>
+#include <golv/util/exception.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace golv {
+
+namespace {
+
+/**
+ * Card index of a position of the deck.
+ */
+constexpr card::index_type card_index(corpus_game game, size_t position) {
+  if (game == corpus_game::bridge) return static_cast<card::index_type>(position);
+  return static_cast<card::index_type>(13 * (position / 8) + position % 8);
+}
+
+constexpr size_t align8(size_t n) { return (n + 7) & ~size_t{7}; }
+
+size_t block_bytes(size_t rows) { return align8(rows * (sizeof(std::uint64_t) + sizeof(std::int16_t) + 1)); }
+
+}  // namespace
+
+deal_generator::deal_type deal_record::masks() const {
+  deal_generator::deal_type masks{};
+  for (size_t p = 0; p < corpus_cards(game_); ++p) {
+    masks[owner(p)] |= std::uint64_t{1} << card_index(game_, p);
+  }
+  return masks;
+}
+
+bridge::internal_state_type deal_record::bridge_hands() const {
+  if (game_ != corpus_game::bridge) throw golv::exception("Not a bridge deal");
+  auto const m = masks();
+  return {mask_to_hand(m[0]), mask_to_hand(m[1]), mask_to_hand(m[2]), mask_to_hand(m[3])};
+}
+
+skat::internal_state_type deal_record::skat_hands() const {
+  if (game_ != corpus_game::skat) throw golv::exception("Not a skat deal");
+  auto const m = masks();
+  return {mask_to_hand(m[0]), mask_to_hand(m[1]), mask_to_hand(m[2]), mask_to_hand(m[3])};
+}
+
+deal_corpus::deal_corpus(std::string const& path) : file_(path) {
+  if (file_.size() < sizeof(deal_corpus_header)) throw golv::exception("Not a deal corpus: " + path);
+  std::memcpy(&header_, file_.data(), sizeof(header_));
+  if (std::memcmp(header_.magic, deal_corpus_header::magic_string, sizeof(header_.magic)) != 0) {
+    throw golv::exception("Not a deal corpus: " + path);
+  }
+  if (header_.version != deal_corpus_header::current_version) {
+    throw golv::exception("Unsupported deal corpus version: " + std::to_string(header_.version));
+  }
+  if (header_.byte_order != deal_corpus_header::byte_order_mark) {
+    throw golv::exception("Deal corpus written with a different byte order: " + path);
+  }
+  if ((header_.game != corpus_game::bridge && header_.game != corpus_game::skat) ||
+      header_.record_size != corpus_record_size(header_.game)) {
+    throw golv::exception("Invalid deal corpus: " + path);
+  }
+  // overflow-safe: count comes from the file
+  if (header_.count > (file_.size() - sizeof(deal_corpus_header)) / header_.record_size) {
+    throw golv::exception("Truncated deal corpus: " + path);
+  }
+}
+
+deal_record deal_corpus::at(size_t i) const {
+  if (i >= size()) throw golv::exception("Deal out of range: " + std::to_string(i));
+  return (*this)[i];
+}
+
+deal_corpus_writer::deal_corpus_writer(std::string const& path, corpus_game game)
+    : out_(path, std::ios::binary | std::ios::trunc), game_(game) {
+  if (!out_) throw golv::exception("Cannot open file: " + path);
+  deal_corpus_header header{};
+  std::memcpy(header.magic, deal_corpus_header::magic_string, sizeof(header.magic));
+  header.version = deal_corpus_header::current_version;
+  header.game = game;
+  header.record_size = static_cast<std::uint32_t>(corpus_record_size(game));
+  header.byte_order = deal_corpus_header::byte_order_mark;
+  out_.write(reinterpret_cast<char const*>(&header), sizeof(header));
+}
+
+deal_corpus_writer::~deal_corpus_writer() {
+  try {
+    close();
+  } catch (...) {
+  }
+}
+
+void deal_corpus_writer::append(deal_generator::deal_type const& masks) {
+  std::array<std::uint8_t, 13> record{};
+  for (size_t p = 0; p < corpus_cards(game_); ++p) {
+    auto const bit = std::uint64_t{1} << card_index(game_, p);
+    unsigned owners = 0;
+    for (unsigned o = 0; o < masks.size(); ++o) {
+      if (masks[o] & bit) {
+        record[p / 4] = static_cast<std::uint8_t>(record[p / 4] | (o << (2 * (p % 4))));
+        ++owners;
+      }
+    }
+    if (owners != 1) throw golv::exception("Not a deal of the deck: " + to_string(card::from_index(card_index(game_, p))));
+  }
+  out_.write(reinterpret_cast<char const*>(record.data()), static_cast<std::streamsize>(corpus_record_size(game_)));
+  ++count_;
+}
+
+void deal_corpus_writer::append(std::array<hand, 4> const& hands) {
+  append({hand_to_mask(hands[0]), hand_to_mask(hands[1]), hand_to_mask(hands[2]), hand_to_mask(hands[3])});
+}
+
+void deal_corpus_writer::close() {
+  if (!out_.is_open()) return;
+  out_.seekp(offsetof(deal_corpus_header, count));
+  out_.write(reinterpret_cast<char const*>(&count_), sizeof(count_));
+  out_.close();
+  if (!out_) throw golv::exception("Cannot write deal corpus");
+}
+
+corpus_results_writer::corpus_results_writer(std::string const& path, std::uint32_t block_rows)
+    : out_(path, std::ios::binary | std::ios::trunc), block_rows_(block_rows) {
+  if (!out_) throw golv::exception("Cannot open file: " + path);
+  if (block_rows == 0) throw golv::exception("Invalid block size");
+  corpus_results_header header{};
+  std::memcpy(header.magic, corpus_results_header::magic_string, sizeof(header.magic));
+  header.version = corpus_results_header::current_version;
+  header.block_rows = block_rows;
+  header.byte_order = corpus_results_header::byte_order_mark;
+  out_.write(reinterpret_cast<char const*>(&header), sizeof(header));
+  nodes_.reserve(block_rows);
+  values_.reserve(block_rows);
+  moves_.reserve(block_rows);
+}
+
+corpus_results_writer::~corpus_results_writer() {
+  try {
+    close();
+  } catch (...) {
+  }
+}
+
+void corpus_results_writer::append(corpus_result const& result) {
+  nodes_.push_back(result.nodes);
+  values_.push_back(result.value);
+  moves_.push_back(result.best_move.index());
+  ++count_;
+  if (nodes_.size() == block_rows_) _write_block();
+}
+
+void corpus_results_writer::_write_block() {
+  auto const rows = nodes_.size();
+  out_.write(reinterpret_cast<char const*>(nodes_.data()), static_cast<std::streamsize>(rows * sizeof(std::uint64_t)));
+  out_.write(reinterpret_cast<char const*>(values_.data()), static_cast<std::streamsize>(rows * sizeof(std::int16_t)));
+  out_.write(reinterpret_cast<char const*>(moves_.data()), static_cast<std::streamsize>(rows));
+  std::array<char, 8> const padding{};
+  auto const written = rows * (sizeof(std::uint64_t) + sizeof(std::int16_t) + 1);
+  out_.write(padding.data(), static_cast<std::streamsize>(block_bytes(rows) - written));
+  nodes_.clear();
+  values_.clear();
+  moves_.clear();
+}
+
+void corpus_results_writer::close() {
+  if (!out_.is_open()) return;
+  if (!nodes_.empty()) _write_block();
+  out_.seekp(offsetof(corpus_results_header, count));
+  out_.write(reinterpret_cast<char const*>(&count_), sizeof(count_));
+  out_.close();
+  if (!out_) throw golv::exception("Cannot write corpus results");
+}
+
+corpus_results::corpus_results(std::string const& path) : file_(path) {
+  if (file_.size() < sizeof(corpus_results_header)) throw golv::exception("Not a corpus result file: " + path);
+  std::memcpy(&header_, file_.data(), sizeof(header_));
+  if (std::memcmp(header_.magic, corpus_results_header::magic_string, sizeof(header_.magic)) != 0) {
+    throw golv::exception("Not a corpus result file: " + path);
+  }
+  if (header_.version != corpus_results_header::current_version) {
+    throw golv::exception("Unsupported corpus result version: " + std::to_string(header_.version));
+  }
+  if (header_.byte_order != corpus_results_header::byte_order_mark) {
+    throw golv::exception("Corpus result file written with a different byte order: " + path);
+  }
+  if (header_.block_rows == 0) throw golv::exception("Invalid corpus result file: " + path);
+  block_bytes_ = block_bytes(header_.block_rows);
+  auto const full = header_.count / header_.block_rows;
+  auto const rest = header_.count % header_.block_rows;
+  // overflow-safe: count comes from the file
+  auto const available = file_.size() - sizeof(corpus_results_header);
+  if (full > available / block_bytes_ || available - full * block_bytes_ < (rest ? block_bytes(rest) : 0)) {
+    throw golv::exception("Truncated corpus result file: " + path);
+  }
+}
+
+corpus_result corpus_results::at(size_t row) const {
+  if (row >= size()) throw golv::exception("Result out of range: " + std::to_string(row));
+  return (*this)[row];
+}
+
+corpus_result corpus_results::operator[](size_t row) const {
+  assert(row < size());
+  auto const block = row / header_.block_rows;
+  auto const i = row % header_.block_rows;
+  // the last block can be shorter
+  auto const rows = std::min<size_t>(header_.block_rows, header_.count - block * header_.block_rows);
+  auto const* base = file_.data() + sizeof(corpus_results_header) + block * block_bytes_;
+
+  corpus_result result;
+  std::memcpy(&result.nodes, base + i * sizeof(std::uint64_t), sizeof(result.nodes));
+  std::memcpy(&result.value, base + rows * sizeof(std::uint64_t) + i * sizeof(std::int16_t), sizeof(result.value));
+  auto const index = static_cast<card::index_type>(base[rows * (sizeof(std::uint64_t) + sizeof(std::int16_t)) + i]);
+  if (index > detail::no_card) throw golv::exception("Invalid best move in corpus result file: " + std::to_string(index));
+  result.best_move = card::from_index(index);
+  return result;
+}
+
+}  // namespace golv
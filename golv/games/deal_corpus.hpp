@@ -0,0 +1,243 @@
+#pragma once
+
+#include <golv/games/bridge.hpp>
+#include <golv/games/deal_generator.hpp>
+#include <golv/games/skat.hpp>
+#include <golv/util/mapped_file.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace golv {
+
+/**
+ * Binary deal corpus format (native byte order, readers reject files with a different byte_order):
+ *
+ *   header
+ *   record[count]
+ *
+ * A record holds the owner of every card of the deck (create_bridge_deck() or create_skat_deck() order)
+ * in two bits, four cards per byte: the players 0 to 3 for bridge (13 bytes), the players 0 to 2 and 3 for
+ * the skat for skat (8 bytes).
+ */
+enum class corpus_game : std::uint32_t { bridge, skat };
+
+struct deal_corpus_header {
+  constexpr static char magic_string[8] = "GOLVDEA";
+  constexpr static std::uint32_t current_version = 2;
+  constexpr static std::uint32_t byte_order_mark = 0x01020304;
+
+  char magic[8];
+  std::uint32_t version;
+  corpus_game game;
+  std::uint32_t record_size;
+  std::uint32_t byte_order;  // byte_order_mark as written
+  std::uint64_t count;
+};
+
+/**
+ * Number of cards and bytes of a record.
+ */
+constexpr size_t corpus_cards(corpus_game g) { return g == corpus_game::bridge ? 52 : 32; }
+constexpr size_t corpus_record_size(corpus_game g) { return corpus_cards(g) / 4; }
+
+/**
+ * deal_record is a view on a record of a mapped corpus.
+ */
+class deal_record {
+ public:
+  deal_record(std::byte const* data, corpus_game game) : data_(data), game_(game) {}
+
+  /**
+   * The owner of the card at a position of the deck.
+   */
+  unsigned owner(size_t position) const {
+    return (static_cast<unsigned>(data_[position / 4]) >> (2 * (position % 4))) & 3;
+  }
+
+  /**
+   * The cards of the owners (the skat is the fourth).
+   */
+  deal_generator::deal_type masks() const;
+
+  bridge::internal_state_type bridge_hands() const;
+  skat::internal_state_type skat_hands() const;
+
+ private:
+  std::byte const* data_;
+  corpus_game game_;
+};
+
+/**
+ * deal_corpus maps a corpus file read-only, the records are read in place.
+ */
+class deal_corpus {
+ public:
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = deal_record;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = deal_record;
+
+    iterator() = default;
+    iterator(std::byte const* data, size_t record_size, corpus_game game)
+        : data_(data), record_size_(record_size), game_(game) {}
+
+    deal_record operator*() const { return {data_, game_}; }
+    iterator& operator++() {
+      data_ += record_size_;
+      return *this;
+    }
+    iterator operator++(int) {
+      auto it = *this;
+      ++*this;
+      return it;
+    }
+    bool operator==(iterator const& other) const { return data_ == other.data_; }
+
+   private:
+    std::byte const* data_ = nullptr;
+    size_t record_size_ = 0;
+    corpus_game game_ = corpus_game::bridge;
+  };
+
+  explicit deal_corpus(std::string const& path);
+
+  corpus_game game() const { return header_.game; }
+  size_t size() const { return header_.count; }
+  deal_record operator[](size_t i) const {
+    assert(i < size());
+    return {_records() + i * header_.record_size, header_.game};
+  }
+
+  /**
+   * Like operator[], but throws golv::exception if i is out of range.
+   */
+  deal_record at(size_t i) const;
+
+  iterator begin() const { return {_records(), header_.record_size, header_.game}; }
+  iterator end() const { return {_records() + size() * header_.record_size, header_.record_size, header_.game}; }
+
+ private:
+  std::byte const* _records() const { return file_.data() + sizeof(deal_corpus_header); }
+
+  mapped_file file_;
+  deal_corpus_header header_{};
+};
+
+/**
+ * deal_corpus_writer appends deals to a new corpus file, the count in the header is written by close().
+ */
+class deal_corpus_writer {
+ public:
+  deal_corpus_writer(std::string const& path, corpus_game game);
+  ~deal_corpus_writer();
+
+  deal_corpus_writer(deal_corpus_writer const&) = delete;
+  deal_corpus_writer& operator=(deal_corpus_writer const&) = delete;
+
+  /**
+   * Append a deal given by the cards of the owners (the skat is the fourth), every card of the deck
+   * must have exactly one owner.
+   */
+  void append(deal_generator::deal_type const& masks);
+
+  /**
+   * Append the hands of a bridge deal or the hands and the skat of a skat deal.
+   */
+  void append(std::array<hand, 4> const& hands);
+
+  size_t size() const { return count_; }
+  void close();
+
+ private:
+  std::ofstream out_;
+  corpus_game game_;
+  std::uint64_t count_ = 0;
+};
+
+/**
+ * Columnar results of a corpus (one row per deal), written in blocks of block_rows rows:
+ *
+ *   header
+ *   block[(count + block_rows - 1) / block_rows]
+ *     std::uint64_t nodes[rows]
+ *     std::int16_t value[rows]
+ *     std::uint8_t best_move[rows]   card index, no card if unknown
+ *     padding to 8 bytes
+ *
+ * All blocks but the last have block_rows rows, such that a row is found without an index.
+ */
+struct corpus_results_header {
+  constexpr static char magic_string[8] = "GOLVRES";
+  constexpr static std::uint32_t current_version = 2;
+  constexpr static std::uint32_t byte_order_mark = deal_corpus_header::byte_order_mark;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t block_rows;
+  std::uint32_t byte_order;  // byte_order_mark as written
+  std::uint32_t reserved;
+  std::uint64_t count;
+};
+
+struct corpus_result {
+  std::int16_t value = 0;
+  card best_move;
+  std::uint64_t nodes = 0;
+};
+
+class corpus_results_writer {
+ public:
+  explicit corpus_results_writer(std::string const& path, std::uint32_t block_rows = 1 << 16);
+  ~corpus_results_writer();
+
+  corpus_results_writer(corpus_results_writer const&) = delete;
+  corpus_results_writer& operator=(corpus_results_writer const&) = delete;
+
+  void append(corpus_result const& result);
+  size_t size() const { return count_; }
+
+  /**
+   * Write the last block and the count.
+   */
+  void close();
+
+ private:
+  void _write_block();
+
+  std::ofstream out_;
+  std::uint32_t block_rows_;
+  std::uint64_t count_ = 0;
+  std::vector<std::uint64_t> nodes_;
+  std::vector<std::int16_t> values_;
+  std::vector<std::uint8_t> moves_;
+};
+
+class corpus_results {
+ public:
+  explicit corpus_results(std::string const& path);
+
+  size_t size() const { return header_.count; }
+  corpus_result operator[](size_t row) const;
+
+  /**
+   * Like operator[], but throws golv::exception if row is out of range.
+   */
+  corpus_result at(size_t row) const;
+
+ private:
+  mapped_file file_;
+  corpus_results_header header_{};
+  size_t block_bytes_ = 0;
+};
+
+}  // namespace golv
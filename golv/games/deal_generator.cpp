@@ -0,0 +1,395 @@
+#include <golv/games/deal_generator.hpp>
+#include <golv/util/exception.hpp>
+#include <golv/util/parallel_for.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace golv {
+
+namespace {
+
+/**
+ * The state of the counting: the free places (4 bits per holder), the lengths in the group of the class
+ * (4 bits per holder, bit 16), the points (6 bits per holder, bit 32, capped) and the cards of the class
+ * which are not assigned yet (bit 56).
+ */
+constexpr int length_shift = 16;
+constexpr int points_shift = 32;
+constexpr std::uint64_t max_tracked_points = 63;
+
+constexpr int left_shift = 56;
+
+constexpr unsigned places(std::uint64_t state, size_t h) { return (state >> (4 * h)) & 15; }
+constexpr unsigned length(std::uint64_t state, size_t h) { return (state >> (length_shift + 4 * h)) & 15; }
+constexpr unsigned points(std::uint64_t state, size_t h) { return (state >> (points_shift + 6 * h)) & 63; }
+constexpr unsigned left_cards(std::uint64_t state) { return (state >> left_shift) & 63; }
+
+constexpr auto binomials = [] {
+  std::array<std::array<std::uint64_t, 65>, 65> c{};
+  for (size_t n = 0; n <= 64; ++n) {
+    c[n][0] = 1;
+    for (size_t k = 1; k <= n; ++k) c[n][k] = c[n - 1][k - 1] + (k < n ? c[n - 1][k] : 0);
+  }
+  return c;
+}();
+
+constexpr auto factorials = [] {
+  std::array<double, 65> f{};
+  f[0] = 1;
+  for (size_t n = 1; n <= 64; ++n) f[n] = f[n - 1] * static_cast<double>(n);
+  return f;
+}();
+
+constexpr std::uint8_t high_card_points(card c) {
+  switch (c.get_kind()) {
+    case kind::ace:
+      return 4;
+    case kind::king:
+      return 3;
+    case kind::queen:
+      return 2;
+    case kind::jack:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+std::uint64_t hand_to_mask(hand const& cards) {
+  std::uint64_t mask = 0;
+  for (auto c : cards) mask |= detail::card_codes[c.index()];
+  return mask;
+}
+
+hand mask_to_hand(std::uint64_t mask) {
+  hand cards;
+  cards.reserve(static_cast<size_t>(std::popcount(mask)));
+  for (; mask; mask &= mask - 1) cards.push_back(card::from_index(static_cast<card::index_type>(std::countr_zero(mask))));
+  return cards;
+}
+
+deal_spec deal_spec::bridge() {
+  deal_spec spec;
+  for (auto c : create_bridge_deck()) spec.points[c.index()] = high_card_points(c);
+  spec.deck = hand_to_mask(create_bridge_deck());
+  for (int s = 0; s < 4; ++s) spec.groups.push_back(std::uint64_t{0x1fff} << (13 * s));
+  spec.holders.assign(4, holder{.size = 13});
+  return spec;
+}
+
+deal_spec deal_spec::skat(trump t) {
+  deal_spec spec;
+  spec.groups.assign(5, 0);
+  for (auto c : create_skat_deck()) {
+    spec.deck |= detail::card_codes[c.index()];
+    spec.groups[detail::skat_follow_group(c, t)] |= detail::card_codes[c.index()];
+  }
+  spec.holders.assign(3, holder{.size = 10});
+  spec.holders.push_back(holder{.size = 2});
+  return spec;
+}
+
+deal_generator::deal_generator(deal_spec spec) : spec_(std::move(spec)) {
+  auto const holders = spec_.holders.size();
+  if (holders == 0 || holders > deal_spec::max_holders) {
+    throw golv::exception("Invalid number of holders: " + std::to_string(holders));
+  }
+  if (spec_.groups.size() > deal_spec::max_groups) {
+    throw golv::exception("Too many groups: " + std::to_string(spec_.groups.size()));
+  }
+  std::uint64_t covered = 0;
+  for (auto g : spec_.groups) {
+    if ((covered & g) || (g & ~spec_.deck)) throw golv::exception("The groups are no partition of the deck");
+    covered |= g;
+  }
+  if (covered != spec_.deck) throw golv::exception("The groups are no partition of the deck");
+
+  // the places for the cards which are not fixed
+  std::uint64_t fixed = 0;
+  size_t total_places = 0;
+  for (size_t h = 0; h < holders; ++h) {
+    auto const& holder = spec_.holders[h];
+    if ((holder.fixed & fixed) || (holder.fixed & ~spec_.deck)) throw golv::exception("Invalid fixed cards");
+    fixed |= holder.fixed;
+    auto const n = std::popcount(holder.fixed);
+    if (holder.size > 15 || n > holder.size) throw golv::exception("Invalid hand size");
+    places_[h] = static_cast<std::uint8_t>(holder.size - n);
+    total_places += places_[h];
+  }
+  auto const free = spec_.deck & ~fixed;
+  if (static_cast<size_t>(std::popcount(free)) != total_places) {
+    throw golv::exception("Wrong number of cards: " + std::to_string(std::popcount(free)) + " for " +
+                          std::to_string(total_places) + " places");
+  }
+  bool free_points = false;
+  for (auto rest = free; rest; rest &= rest - 1) free_points |= spec_.points[std::countr_zero(rest)] > 0;
+
+  // the constrained holders are counted one by one, the others as one
+  counted_holder pool;
+  for (size_t h = 0; h < holders; ++h) {
+    auto const& holder = spec_.holders[h];
+    auto const index = static_cast<std::uint8_t>(holders_.size());
+    counted_holder counted;
+    counted.places = places_[h];
+    bool constrained = false;
+    for (size_t g = 0; g < spec_.groups.size(); ++g) {
+      auto const fixed_length = std::popcount(holder.fixed & spec_.groups[g]);
+      auto const free_length = std::popcount(spec_.groups[g] & free);
+      if (fixed_length > holder.max_length[g] || fixed_length + free_length < holder.min_length[g]) {
+        throw golv::exception("No deal satisfies the constraints");
+      }
+      if (free_length == 0) continue;
+      if (holder.max_length[g] == fixed_length) {
+        counted.closed |= static_cast<std::uint8_t>(1 << g);
+        constrained = true;
+      } else if (holder.min_length[g] > fixed_length || holder.max_length[g] < fixed_length + free_length) {
+        lengths_.push_back({index, static_cast<std::uint8_t>(g), static_cast<std::uint8_t>(fixed_length),
+                            holder.min_length[g], holder.max_length[g]});
+        constrained = true;
+      }
+    }
+
+    std::uint64_t points = 0;
+    for (auto rest = holder.fixed; rest; rest &= rest - 1) points += spec_.points[std::countr_zero(rest)];
+    if (holder.min_points > 0 || holder.max_points < deal_spec::unlimited) {
+      if (!free_points) {
+        // the points are known
+        if (points < holder.min_points || points > holder.max_points) {
+          throw golv::exception("No deal satisfies the constraints");
+        }
+      } else {
+        auto const cap = holder.max_points < deal_spec::unlimited ? holder.max_points + 1 : holder.min_points;
+        if (cap > static_cast<int>(max_tracked_points)) throw golv::exception("Too many points");
+        counted.min_points = holder.min_points;
+        counted.max_points = holder.max_points;
+        counted.points_cap = static_cast<std::uint8_t>(cap);
+        counted.fixed_points = static_cast<std::uint8_t>(std::min<std::uint64_t>(points, cap));
+        constrained = true;
+      }
+    }
+
+    if (constrained) {
+      counted_index_[h] = index;
+      holders_.push_back(counted);
+    } else {
+      counted_index_[h] = -1;
+      pool.places = static_cast<std::uint8_t>(pool.places + places_[h]);
+      pool_places_[h] = places_[h];
+      with_pool_ = true;
+    }
+  }
+  if (lengths_.size() > max_length_constraints) throw golv::exception("Too many length constraints");
+
+  unconstrained_ = holders_.empty();
+  if (unconstrained_) {
+    count_ = factorials[total_places];
+    for (size_t h = 0; h < holders; ++h) count_ /= factorials[places_[h]];
+    return;
+  }
+  if (with_pool_) holders_.push_back(pool);
+
+  // classes of the same group and points, the classes with points first
+  auto const with_points = std::any_of(holders_.begin(), holders_.end(), [](auto const& h) { return h.points_cap > 0; });
+  auto const add_classes = [&](std::uint64_t cards) {
+    for (size_t g = 0; g < spec_.groups.size(); ++g) {
+      for (auto rest = spec_.groups[g] & cards; rest;) {
+        auto const p = with_points ? spec_.points[std::countr_zero(rest)] : 0;
+        std::uint64_t same = 0;
+        for (auto r = rest; r; r &= r - 1) {
+          auto const i = std::countr_zero(r);
+          if (!with_points || spec_.points[i] == p) same |= std::uint64_t{1} << i;
+        }
+        classes_.push_back({same, static_cast<std::uint8_t>(std::popcount(same)), static_cast<std::uint8_t>(g),
+                            static_cast<std::uint8_t>(p)});
+        rest &= ~same;
+      }
+    }
+  };
+  if (with_points) {
+    std::uint64_t with = 0;
+    for (auto rest = free; rest; rest &= rest - 1) {
+      if (spec_.points[std::countr_zero(rest)] > 0) with |= rest & (~rest + 1);
+    }
+    add_classes(with);
+    point_classes_ = classes_.size();
+    add_classes(free & ~with);
+  } else {
+    add_classes(free);
+  }
+  for (size_t c = 0; c < classes_.size(); ++c) {
+    if (classes_[c].size > 63) throw golv::exception("Too many cards in a group");
+    last_class_[classes_[c].group] = c;
+  }
+  cards_after_.assign(classes_.size(), 0);
+  for (size_t c = classes_.size(); c-- > 1;) cards_after_[c - 1] = cards_after_[c] + classes_[c].size;
+
+  counts_.resize(classes_.size() * holders_.size());
+  count_ = _count(0, _initial_state());
+  if (count_ == 0) throw golv::exception("No deal satisfies the constraints");
+  // the splits of the cards of the unconstrained holders
+  count_ *= factorials[pool.places];
+  for (auto n : pool_places_) count_ /= factorials[n];
+}
+
+std::uint64_t deal_generator::_initial_state() const {
+  std::uint64_t state = 0;
+  for (size_t d = 0; d < holders_.size(); ++d) {
+    if (!(with_pool_ && d + 1 == holders_.size())) state |= std::uint64_t{holders_[d].places} << (4 * d);
+    state |= std::uint64_t{holders_[d].fixed_points} << (points_shift + 6 * d);
+  }
+  for (size_t i = 0; i < lengths_.size(); ++i) state |= std::uint64_t{lengths_[i].fixed} << (length_shift + 4 * i);
+  if (!classes_.empty()) state |= std::uint64_t{classes_.front().size} << left_shift;
+  return state;
+}
+
+template <class F>
+void deal_generator::_for_each_choice(size_t step, std::uint64_t state, F&& f) const {
+  auto const c = step / holders_.size();
+  auto const d = step % holders_.size();
+  auto const& cls = classes_[c];
+  auto const& holder = holders_[d];
+  auto const left = left_cards(state);
+  auto const last = d + 1 == holders_.size();
+  auto const pooled = with_pool_ && last;
+  auto const last_of_group = last_class_[cls.group] == c;
+
+  // the places of the unconstrained holders are the cards which are not dealt to the others
+  unsigned free_places = places(state, d);
+  if (pooled) {
+    unsigned others = 0;
+    for (size_t i = 0; i < d; ++i) others += places(state, i);
+    if (others > left + cards_after_[c]) return;
+    free_places = left + cards_after_[c] - others;
+  }
+  if (holder.closed & (1 << cls.group)) free_places = 0;
+
+  for (unsigned n = last ? left : 0; n <= std::min(left, free_places); ++n) {
+    auto next = state - (std::uint64_t{n} << left_shift);
+    if (!pooled) next -= std::uint64_t{n} << (4 * d);
+
+    bool valid = true;
+    for (size_t i = 0; i < lengths_.size(); ++i) {
+      if (lengths_[i].holder != d || lengths_[i].group != cls.group) continue;
+      auto const shift = length_shift + 4 * i;
+      auto const length_after = ((state >> shift) & 15) + n;
+      if (length_after > lengths_[i].max) return;
+      if (last_of_group && length_after < lengths_[i].min) valid = false;
+      // the length is no more needed after the last class of the group
+      next = (next & ~(std::uint64_t{15} << shift)) | (last_of_group ? 0 : std::uint64_t{length_after} << shift);
+    }
+    if (!valid) continue;
+
+    if (holder.points_cap > 0 && n * cls.points > 0) {
+      auto const p = std::min<unsigned>(points(state, d) + n * cls.points, holder.points_cap);
+      if (p > holder.max_points) return;
+      auto const shift = points_shift + 6 * d;
+      next = (next & ~(std::uint64_t{63} << shift)) | (std::uint64_t{p} << shift);
+    }
+
+    if (last) {
+      // the points are no more needed after the last class with points
+      if (c + 1 == point_classes_) {
+        for (size_t i = 0; i < holders_.size(); ++i) {
+          if (holders_[i].points_cap > 0 && points(next, i) < holders_[i].min_points) valid = false;
+        }
+        next &= ~(((std::uint64_t{1} << 24) - 1) << points_shift);
+      }
+      if (c + 1 < classes_.size()) next |= std::uint64_t{classes_[c + 1].size} << left_shift;
+    }
+    if (valid) f(n, step + 1, next, static_cast<double>(binomials[left][n]));
+  }
+}
+
+double deal_generator::_count(size_t step, std::uint64_t state) {
+  if (step == counts_.size()) return _lookup(step, state);
+  if (auto it = counts_[step].find(state); it != counts_[step].end()) return it->second;
+  double total = 0;
+  _for_each_choice(step, state, [&](unsigned, size_t next_step, std::uint64_t next, double weight) {
+    total += weight * _count(next_step, next);
+  });
+  counts_[step].emplace(state, total);
+  return total;
+}
+
+double deal_generator::_lookup(size_t step, std::uint64_t state) const {
+  if (step == counts_.size()) return (state & 0xffff) == 0 ? 1 : 0;
+  auto it = counts_[step].find(state);
+  return it == counts_[step].end() ? 0 : it->second;
+}
+
+void deal_generator::_deal_class(std::uint64_t cards, split_type const& split, deal_type& deal,
+                                 std::mt19937_64& rng) const {
+  for (size_t h = 0; h < split.size(); ++h) {
+    auto need = split[h];
+    if (need == 0) continue;
+    // unrank a combination of need of the m remaining cards (lexicographic by the card index)
+    auto m = static_cast<size_t>(std::popcount(cards));
+    auto rank = std::uniform_int_distribution<std::uint64_t>(0, binomials[m][need] - 1)(rng);
+    for (auto rest = cards; need > 0; rest &= rest - 1) {
+      auto const bit = rest & (~rest + 1);
+      --m;
+      auto const with = binomials[m][need - 1];
+      if (rank < with) {
+        deal[h] |= bit;
+        cards &= ~bit;
+        --need;
+      } else {
+        rank -= with;
+      }
+    }
+  }
+}
+
+deal_generator::deal_type deal_generator::sample(std::mt19937_64& rng) const {
+  deal_type deal{};
+  for (size_t h = 0; h < spec_.holders.size(); ++h) deal[h] = spec_.holders[h].fixed;
+  if (unconstrained_) {
+    std::uint64_t free = spec_.deck;
+    for (auto d : deal) free &= ~d;
+    _deal_class(free, places_, deal, rng);
+    return deal;
+  }
+
+  deal_type counted{};
+  auto state = _initial_state();
+  split_type split{};
+  for (size_t step = 0; step < counts_.size(); ++step) {
+    auto r = std::uniform_real_distribution<double>(0, _lookup(step, state))(rng);
+    unsigned chosen = 0;
+    std::uint64_t chosen_state = 0;
+    bool found = false;
+    _for_each_choice(step, state, [&](unsigned n, size_t next_step, std::uint64_t next, double weight) {
+      if (found) return;
+      auto const w = weight * _lookup(next_step, next);
+      if (w == 0) return;
+      chosen = n;
+      chosen_state = next;
+      // the last choice with deals takes the rounding errors
+      if (r < w) found = true;
+      r -= w;
+    });
+    auto const d = step % holders_.size();
+    split[d] = static_cast<std::uint8_t>(chosen);
+    state = chosen_state;
+    if (d + 1 == holders_.size()) _deal_class(classes_[step / holders_.size()].cards, split, counted, rng);
+  }
+
+  for (size_t h = 0; h < spec_.holders.size(); ++h) {
+    if (counted_index_[h] >= 0) deal[h] |= counted[static_cast<size_t>(counted_index_[h])];
+  }
+  if (with_pool_) _deal_class(counted[holders_.size() - 1], pool_places_, deal, rng);
+  return deal;
+}
+
+void deal_generator::generate(std::span<deal_type> out, std::uint64_t seed, size_t threads) const {
+  constexpr size_t block = 256;
+  parallel_for((out.size() + block - 1) / block, threads, [&](size_t b) {
+    std::mt19937_64 rng(seed + b);
+    for (size_t i = b * block; i < std::min(out.size(), (b + 1) * block); ++i) out[i] = sample(rng);
+  });
+}
+
+}  // namespace golv
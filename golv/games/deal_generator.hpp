@@ -0,0 +1,158 @@
+#pragma once
+
+#include <golv/games/cards.hpp>
+#include <golv/games/skat.hpp>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace golv {
+
+/**
+ * A set of cards as bits of the card indices.
+ */
+std::uint64_t hand_to_mask(hand const& cards);
+hand mask_to_hand(std::uint64_t mask);
+
+/**
+ * deal_spec describes the deals to generate: the cards, the groups of cards whose lengths can be constrained
+ * (e. g. suits, the trumps of skat), the points of the cards (e. g. high card points) and per holder (players
+ * and the skat) the number of cards, the cards it surely holds and the ranges of the lengths and points.
+ */
+struct deal_spec {
+  constexpr static size_t max_holders = 4;
+  constexpr static size_t max_groups = 5;
+  constexpr static std::uint8_t unlimited = 255;
+
+  struct holder {
+    std::uint8_t size = 0;
+    std::uint64_t fixed = 0;
+    std::array<std::uint8_t, max_groups> min_length{};
+    std::array<std::uint8_t, max_groups> max_length{unlimited, unlimited, unlimited, unlimited, unlimited};
+    std::uint8_t min_points = 0;
+    std::uint8_t max_points = unlimited;
+
+    void set_void(size_t group) { max_length[group] = 0; }
+  };
+
+  std::uint64_t deck = 0;
+  std::vector<std::uint64_t> groups;  // a partition of the deck
+  std::array<std::uint8_t, 64> points{};
+  std::vector<holder> holders;
+
+  /**
+   * Four hands of 13 cards, the suits as groups and the high card points (A = 4, K = 3, Q = 2, J = 1).
+   */
+  static deal_spec bridge();
+
+  /**
+   * Three hands of 10 cards and the skat, the groups are the suits without the trumps (0 to 3) and the
+   * trumps (4) as in following suit.
+   */
+  static deal_spec skat(trump t);
+};
+
+/**
+ * deal_generator draws deals uniformly from all deals of a spec without rejection. The cards which are
+ * not fixed are split into classes of the same group and points (only the group if no points are
+ * constrained), the classes with points first. The constructor counts the completions per step (a class and
+ * a holder) and state (free places, constrained lengths and points) and sample() chooses the number of cards
+ * of the class for each holder with the probability of its completions. The points are checked after the
+ * last class with points and the lengths after the last class of their group, such that they leave the
+ * state early. The holders without constraints are counted as one, their cards are split among them at the
+ * end. The cards of a class are assigned by unranking a random combination, without constraints a deal is
+ * dealt by unranking only.
+ * After the construction the generator is read-only, i. e. threads can share it with a generator each.
+ */
+class deal_generator {
+ public:
+  using deal_type = std::array<std::uint64_t, deal_spec::max_holders>;  // the cards of the holders
+
+  /**
+   * At most four lengths can be constrained other than voids.
+   */
+  constexpr static size_t max_length_constraints = 4;
+
+  explicit deal_generator(deal_spec spec);
+
+  /**
+   * Number of deals of the spec.
+   */
+  double count() const { return count_; }
+
+  deal_spec const& spec() const { return spec_; }
+
+  deal_type sample(std::mt19937_64& rng) const;
+
+  /**
+   * Fill a buffer with deals on a pool of threads (0 for the hardware concurrency). The deals are drawn in
+   * blocks with a generator seeded with seed + block, such that the result does not depend on the threads.
+   */
+  void generate(std::span<deal_type> out, std::uint64_t seed, size_t threads = 0) const;
+
+ private:
+  using split_type = std::array<std::uint8_t, deal_spec::max_holders>;
+
+  struct card_class {
+    std::uint64_t cards;
+    std::uint8_t size;
+    std::uint8_t group;
+    std::uint8_t points;
+  };
+
+  /**
+   * A holder of the counting: a constrained holder of the spec or all holders without constraints.
+   */
+  struct counted_holder {
+    std::uint8_t places = 0;
+    std::uint8_t closed = 0;  // bits of the groups without more cards (e. g. voids)
+    std::uint8_t min_points = 0;
+    std::uint8_t max_points = deal_spec::unlimited;
+    std::uint8_t points_cap = 0;  // the tracked points are at most the cap (0 if untracked)
+    std::uint8_t fixed_points = 0;
+  };
+
+  /**
+   * The length of a holder in a group which is tracked until the last class of the group.
+   */
+  struct length_constraint {
+    std::uint8_t holder;
+    std::uint8_t group;
+    std::uint8_t fixed;
+    std::uint8_t min;
+    std::uint8_t max;
+  };
+
+  std::uint64_t _initial_state() const;
+  double _count(size_t step, std::uint64_t state);
+  double _lookup(size_t step, std::uint64_t state) const;
+
+  /**
+   * Call f(n, next step, next state, weight) for all numbers of cards of the class for the holder of the step.
+   */
+  template <class F>
+  void _for_each_choice(size_t step, std::uint64_t state, F&& f) const;
+
+  void _deal_class(std::uint64_t cards, split_type const& split, deal_type& deal, std::mt19937_64& rng) const;
+
+  deal_spec spec_;
+  std::vector<card_class> classes_;
+  std::vector<unsigned> cards_after_;                            // the cards of the classes after a class
+  std::array<size_t, deal_spec::max_groups> last_class_{};       // of a group
+  size_t point_classes_ = 0;                                     // the first classes
+  std::vector<counted_holder> holders_;
+  std::vector<length_constraint> lengths_;
+  std::array<int, deal_spec::max_holders> counted_index_{};  // of the holders of the spec, -1 if unconstrained
+  split_type places_{};                                      // of the holders of the spec
+  split_type pool_places_{};                                 // of the unconstrained holders
+  bool with_pool_ = false;                                   // the last counted holder is the unconstrained
+  bool unconstrained_ = true;
+  std::vector<std::unordered_map<std::uint64_t, double>> counts_;  // per step
+  double count_ = 0;
+};
+
+}  // namespace golv
@@ -0,0 +1,537 @@
+#include <golv/games/double_dummy.hpp>
+#include <golv/util/exception.hpp>
+#include <golv/util/parallel_for.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <limits>
+
+namespace golv {
+
+namespace {
+
+constexpr int notrump = 4;
+
+int highest(std::uint16_t mask) { return std::bit_width(mask) - 1; }
+
+}  // namespace
+
+double_dummy_table::double_dummy_table(size_t capacity) : capacity_(capacity) {}
+
+size_t double_dummy_table::key_hash::operator()(key const& k) const {
+  // splitmix64 finalizer
+  auto h = k.lengths ^ (static_cast<std::uint64_t>(k.leader) * 0x9e3779b97f4a7c15ull);
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+  return static_cast<size_t>(h ^ (h >> 31));
+}
+
+double_dummy_table::entry& double_dummy_table::store(position const& p, std::array<std::uint8_t, 4> const& significant,
+                                                     std::uint8_t tricks) {
+  entry e{p.owners, {}, 0, static_cast<std::int8_t>(tricks), 0, tricks, age_};
+  for (int s = 0; s < 4; ++s) {
+    e.masks[s] = (std::uint32_t{1} << (2 * significant[s])) - 1;
+    e.owners[s] &= e.masks[s];
+  }
+
+  if (size_ >= capacity_) _age();
+  auto& group = groups_[key{p.lengths, p.leader}];
+  for (auto& x : group) {
+    if (x.masks == e.masks && x.owners == e.owners) {
+      x.age = age_;
+      return x;
+    }
+  }
+  ++size_;
+  return group.emplace_back(e);
+}
+
+void double_dummy_table::clear() {
+  groups_.clear();
+  size_ = 0;
+}
+
+void double_dummy_table::_age() {
+  // the entries of the current search by remaining tricks
+  std::array<size_t, 14> current{};
+  for (auto const& [k, group] : groups_) {
+    for (auto const& e : group) {
+      if (e.age == age_) ++current[std::min<size_t>(e.tricks, 13)];
+    }
+  }
+  // the deepest ones which fill half of the table stay
+  size_t kept = 0;
+  size_t min_tricks = current.size();
+  while (min_tricks > 0 && kept + current[min_tricks - 1] <= capacity_ / 2) kept += current[--min_tricks];
+  for (auto it = groups_.begin(); it != groups_.end();) {
+    std::erase_if(it->second, [&](entry const& e) { return e.age != age_ || e.tricks < min_tricks; });
+    it = it->second.empty() ? groups_.erase(it) : std::next(it);
+  }
+  size_ = kept;
+}
+
+double_dummy_solver::double_dummy_solver(strain s, size_t table_capacity)
+    : strain_(s), trump_(static_cast<int>(s)), table_(table_capacity) {}
+
+void double_dummy_solver::_setup(deal_type const& deal, player_type declarer) {
+  if (declarer >= bridge::num_players) {
+    throw golv::exception("Invalid declarer: " + std::to_string(declarer));
+  }
+  table_.new_search();
+  hands_ = {};
+  remaining_ = {};
+  played_ = {};
+  for (size_t p = 0; p < bridge::num_players; ++p) {
+    if (deal[p].size() != deal[0].size()) {
+      throw golv::exception("Hands of different sizes");
+    }
+    for (auto const& c : deal[p]) {
+      auto const s = static_cast<int>(c.get_suit());
+      std::uint16_t const bit = 1u << (12 - static_cast<int>(c.get_kind()));
+      if (remaining_[s] & bit) {
+        throw golv::exception("Card dealt twice: " + to_string(c));
+      }
+      hands_[p][s] |= bit;
+      remaining_[s] |= bit;
+    }
+  }
+  // the owners of the remaining cards from the highest (the player numbers) and the lengths of the hands
+  owners_ = {};
+  lengths_ = 0;
+  for (int s = 0; s < 4; ++s) {
+    int i = 0;
+    for (auto alive = remaining_[s]; alive != 0; ++i) {
+      std::uint16_t const bit = 1u << highest(alive);
+      for (std::uint32_t p = 0; p < 4; ++p) {
+        if (hands_[p][s] & bit) owners_[s] |= p << (2 * i);
+      }
+      alive ^= bit;
+    }
+    for (int h = 0; h < 4; ++h) {
+      lengths_ |= static_cast<std::uint64_t>(std::popcount(hands_[h][s])) << (16 * s + 4 * h);
+    }
+  }
+  max_side_ = declarer % 2;
+  won_ = 0;
+  tricks_left_ = static_cast<int>(deal[0].size());
+}
+
+int double_dummy_solver::solve(deal_type const& deal, player_type declarer, int guess) {
+  _setup(deal, declarer);
+  auto const leader = static_cast<std::uint8_t>((declarer + 1) % 4);
+  int lower = 0;
+  int upper = tricks_left_ - _quick_tricks(leader);
+  if (guess < 0) guess = (lower + upper + 1) / 2;
+  // MTD(f): null window probes moving from the guess to the value
+  while (lower < upper) {
+    auto const target = std::clamp(guess, lower + 1, upper);
+    suit_masks relevant{};
+    if (_search(trick{leader}, target, relevant)) {
+      lower = target;
+      guess = target + 1;
+    } else {
+      upper = target - 1;
+      guess = target - 1;
+    }
+  }
+  return lower;
+}
+
+bool double_dummy_solver::can_make(deal_type const& deal, player_type declarer, int target) {
+  _setup(deal, declarer);
+  suit_masks relevant{};
+  return _search(trick{static_cast<std::uint8_t>((declarer + 1) % 4)}, target, relevant);
+}
+
+bool double_dummy_solver::_search(trick const& t, int target, suit_masks& relevant) {
+  int const player = (t.leader + t.count) % 4;
+  bool const maximizing = player % 2 == max_side_;
+
+  double_dummy_table::position position;
+  int hint_suit = -1;
+  int hint_rank = -1;
+  if (t.count == 0) {
+    if (won_ >= target) return true;
+    if (won_ + tricks_left_ < target) return false;
+    // the side of the leader takes its quick tricks
+    int const quick_tricks = _quick_tricks(player);
+    if (maximizing ? won_ + quick_tricks >= target : won_ + tricks_left_ - quick_tricks < target) {
+      _quick_tricks(player, &relevant);
+      return maximizing;
+    }
+
+    position = _position(player);
+    bool result = false;
+    auto const* hit = table_.find_if(position, [&](double_dummy_table::entry const& e) {
+      int const lower = max_side_ == 0 ? e.lower : tricks_left_ - e.upper;
+      int const upper = max_side_ == 0 ? e.upper : tricks_left_ - e.lower;
+      if (won_ + lower >= target || won_ + upper < target) {
+        result = won_ + lower >= target;
+        return true;
+      }
+      if (e.move != 0 && hint_suit < 0) {
+        hint_suit = (e.move - 1) / 16;
+        // the relative rank counts from the highest remaining card
+        auto mask = remaining_[hint_suit];
+        for (int i = (e.move - 1) % 16; i > 0 && mask != 0; --i) mask &= ~(1u << highest(mask));
+        hint_rank = mask == 0 ? -1 : highest(mask);
+      }
+      return false;
+    });
+    if (hit != nullptr) {
+      // the significant cards of the entry are relevant
+      for (int s = 0; s < 4; ++s) {
+        int const significant = std::popcount(hit->masks[s]) / 2;
+        auto mask = remaining_[s];
+        for (int i = 1; i < significant; ++i) mask &= ~(1u << highest(mask));
+        if (significant != 0) relevant[s] |= 1u << highest(mask);
+      }
+      return result;
+    }
+  }
+
+  suit_masks all_relevant{};
+  auto const moves = _moves(t, player, hint_suit, hint_rank);
+  for (auto const& m : moves) {
+    ++nodes_;
+    std::uint16_t const bit = 1u << m.rank;
+    _remove_owner(player, m.suit, m.rank);
+    hands_[player][m.suit] ^= bit;
+    remaining_[m.suit] ^= bit;
+    played_[m.suit] ^= bit;
+
+    trick next = t;
+    ++next.count;
+    if (t.count == 0) {
+      next.lead_suit = m.suit;
+    }
+    if (t.count == 0 || (m.suit == t.win_suit && m.rank > t.win_rank) || (m.suit == trump_ && t.win_suit != trump_)) {
+      next.winner = static_cast<std::uint8_t>(player);
+      next.win_suit = m.suit;
+      next.win_rank = m.rank;
+    }
+
+    suit_masks child_relevant{};
+    bool result;
+    if (next.count == 4) {
+      auto const played = played_;
+      // the rank of the winning card matters if it beat another card of its suit
+      if (std::popcount(played[next.win_suit]) > 1) child_relevant[next.win_suit] |= 1u << next.win_rank;
+      played_ = {};
+      int const won = next.winner % 2 == max_side_;
+      won_ += won;
+      --tricks_left_;
+      result = _search(trick{next.winner}, target, child_relevant);
+      won_ -= won;
+      ++tricks_left_;
+      played_ = played;
+    } else {
+      result = _search(next, target, child_relevant);
+    }
+
+    hands_[player][m.suit] ^= bit;
+    remaining_[m.suit] ^= bit;
+    played_[m.suit] ^= bit;
+    _insert_owner(player, m.suit, m.rank);
+
+    if (result == maximizing) {
+      for (int s = 0; s < 4; ++s) relevant[s] |= child_relevant[s];
+      if (t.count == 0) {
+        _store(position, child_relevant, result, target - won_, m.suit, m.rank);
+      }
+      return result;
+    }
+    for (int s = 0; s < 4; ++s) all_relevant[s] |= child_relevant[s];
+  }
+
+  for (int s = 0; s < 4; ++s) relevant[s] |= all_relevant[s];
+  if (t.count == 0) {
+    _store(position, all_relevant, !maximizing, target - won_, -1, -1);
+  }
+  return !maximizing;
+}
+
+void double_dummy_solver::_store(double_dummy_table::position const& p, suit_masks const& relevant,
+                                 bool max_side_makes, int needed, int move_suit, int move_rank) {
+  std::array<std::uint8_t, 4> significant{};
+  for (int s = 0; s < 4; ++s) {
+    if (relevant[s] == 0) continue;
+    // all remaining cards down to the lowest relevant rank
+    auto const lowest = std::countr_zero(relevant[s]);
+    significant[s] = static_cast<std::uint8_t>(std::popcount<std::uint16_t>(remaining_[s] >> lowest));
+  }
+  auto& e = table_.store(p, significant, static_cast<std::uint8_t>(tricks_left_));
+  // bounds of north/south
+  bool const lower_bound = max_side_makes == (max_side_ == 0);
+  int const bound = max_side_ == 0 ? (max_side_makes ? needed : needed - 1)
+                                   : (max_side_makes ? tricks_left_ - needed : tricks_left_ - needed + 1);
+  if (lower_bound) {
+    e.lower = static_cast<std::int8_t>(std::max<int>(e.lower, bound));
+  } else {
+    e.upper = static_cast<std::int8_t>(std::min<int>(e.upper, bound));
+  }
+  if (move_suit >= 0) {
+    e.move = static_cast<std::uint8_t>(1 + 16 * move_suit + std::popcount<std::uint16_t>(remaining_[move_suit] >> (move_rank + 1)));
+  }
+}
+
+double_dummy_solver::move_list double_dummy_solver::_moves(trick const& t, int player, int hint_suit,
+                                                           int hint_rank) const {
+  move_list moves;
+  int first = 0;
+  int last = 4;
+  if (t.count > 0 && hands_[player][t.lead_suit] != 0) {
+    first = t.lead_suit;
+    last = first + 1;
+  }
+  for (int s = first; s < last; ++s) {
+    auto h = hands_[player][s];
+    std::uint16_t const alive = remaining_[s] | played_[s];
+    while (h != 0) {
+      // a sequence: the cards between top and low are all in this hand
+      int const top = highest(h);
+      int low = top;
+      for (;;) {
+        std::uint16_t const below = alive & ((1u << low) - 1);
+        if (below == 0 || !(h & (1u << highest(below)))) break;
+        low = highest(below);
+      }
+      h &= (1u << low) - 1;
+
+      int score;
+      if (s == hint_suit && hint_rank >= low && hint_rank <= top) {
+        score = 1000;
+      } else if (t.count == 0) {
+        score = _lead_score(player, s, low);
+      } else {
+        score = _follow_score(t, player, s, low);
+      }
+      moves.push_back(move{static_cast<std::uint8_t>(s), static_cast<std::uint8_t>(low), static_cast<std::int16_t>(score)});
+    }
+  }
+  std::stable_sort(moves.begin(), moves.end(), [](move const& l, move const& r) { return l.score > r.score; });
+  return moves;
+}
+
+int double_dummy_solver::_lead_score(int player, int suit, int rank) const {
+  int const lho = (player + 1) % 4;
+  int const partner = (player + 2) % 4;
+  int const rho = (player + 3) % 4;
+  auto const alive = remaining_[suit];
+  bool const trumps = trump_ != notrump && suit != trump_;
+  bool const ruffed = trumps && ((hands_[lho][suit] == 0 && hands_[lho][trump_] != 0) ||
+                                 (hands_[rho][suit] == 0 && hands_[rho][trump_] != 0));
+  // all remaining cards from rank upwards are in the hand of the leader
+  bool const winner = (alive >> rank) == (hands_[player][suit] >> rank);
+  if (winner && !ruffed) {
+    return 100 + (suit == trump_ ? 5 : 0);
+  }
+  int const top = highest(alive);
+  if (hands_[partner][suit] & (1u << top) && !ruffed) {
+    return 80 - rank;
+  }
+  if (trumps && hands_[partner][suit] == 0 && hands_[partner][trump_] != 0 && hands_[lho][suit] != 0) {
+    return 70 - rank;
+  }
+  int score = 40 - rank;
+  if (hands_[lho][suit] & (1u << top)) score -= 15;
+  if (suit == trump_) score -= 10;
+  return score;
+}
+
+bool double_dummy_solver::_beaten_later(trick const& t, int player, int suit, int rank) const {
+  int const lead = t.count == 0 ? suit : t.lead_suit;
+  for (int k = t.count + 1; k < 4; ++k) {
+    int const q = (t.leader + k) % 4;
+    if ((q + player) % 2 == 0) continue;
+    if (auto const follow = hands_[q][lead]; follow != 0) {
+      if (suit == lead && (follow >> (rank + 1)) != 0) return true;
+    } else if (trump_ != notrump && hands_[q][trump_] != 0) {
+      if (suit != trump_ || (hands_[q][trump_] >> (rank + 1)) != 0) return true;
+    }
+  }
+  return false;
+}
+
+int double_dummy_solver::_follow_score(trick const& t, int player, int suit, int rank) const {
+  bool const partner_wins = (t.winner + player) % 2 == 0;
+  if (partner_wins && !_beaten_later(t, t.winner, t.win_suit, t.win_rank)) {
+    // play low, keep the trumps
+    return -rank - (suit == trump_ && t.lead_suit != trump_ ? 20 : 0);
+  }
+  bool const beats = (suit == t.win_suit && rank > t.win_rank) || (suit == trump_ && t.win_suit != trump_);
+  if (beats && !_beaten_later(t, player, suit, rank)) {
+    return 100 - rank;
+  }
+  if (beats && !partner_wins) {
+    return 50 - rank;
+  }
+  return -rank - (suit == trump_ && t.lead_suit != trump_ ? 20 : 0);
+}
+
+int double_dummy_solver::_quick_tricks(int leader, suit_masks* relevant) const {
+  int const lho = (leader + 1) % 4;
+  int const partner = (leader + 2) % 4;
+  int const rho = (leader + 3) % 4;
+  int result = 0;
+  for (int s = 0; s < 4; ++s) {
+    auto const h = hands_[leader][s];
+    if (h == 0) continue;
+    // the highest remaining cards in the hand of the leader
+    auto alive = remaining_[s];
+    int tops = 0;
+    while (alive != 0 && (h & (1u << highest(alive)))) {
+      ++tops;
+      alive &= ~(1u << highest(alive));
+    }
+    if (tops != 0 && trump_ != notrump && s != trump_) {
+      // opponents with trumps ruff as soon as they are void, the partner could be forced to
+      for (int opp : {lho, rho}) {
+        if (hands_[opp][trump_] != 0) tops = std::min(tops, std::popcount(hands_[opp][s]));
+      }
+      if (hands_[partner][trump_] != 0) tops = std::min(tops, std::popcount(hands_[partner][s]));
+    }
+    if (tops != 0 && relevant != nullptr) {
+      auto mask = remaining_[s];
+      for (int i = 1; i < tops; ++i) mask &= ~(1u << highest(mask));
+      (*relevant)[s] |= 1u << highest(mask);
+    }
+    result += tops;
+  }
+  // then a low card to the highest remaining cards of the partner in one suit, the partner keeps them as
+  // long as the leader takes at most tricks_left - tops tricks before
+  int entry_suit = -1;
+  int entry_tops = 0;
+  for (int s = 0; s < 4; ++s) {
+    auto const h = hands_[partner][s];
+    if (hands_[leader][s] == 0 || h == 0 || !(h & (1u << highest(remaining_[s])))) continue;
+    auto alive = remaining_[s];
+    int tops = 0;
+    while (alive != 0 && (h & (1u << highest(alive)))) {
+      ++tops;
+      alive &= ~(1u << highest(alive));
+    }
+    if (trump_ != notrump && s != trump_) {
+      for (int opp : {lho, rho}) {
+        if (hands_[opp][trump_] != 0) tops = std::min(tops, std::popcount(hands_[opp][s]));
+      }
+    }
+    if (tops > entry_tops) {
+      entry_suit = s;
+      entry_tops = tops;
+    }
+  }
+  if (entry_tops != 0 && relevant != nullptr) {
+    auto mask = remaining_[entry_suit];
+    for (int i = 1; i < entry_tops; ++i) mask &= ~(1u << highest(mask));
+    (*relevant)[entry_suit] |= 1u << highest(mask);
+  }
+  result += entry_tops;
+  return std::min(result, tricks_left_);
+}
+
+double_dummy_table::position double_dummy_solver::_position(int leader) const {
+  return {lengths_, owners_, static_cast<std::uint8_t>(leader)};
+}
+
+void double_dummy_solver::_remove_owner(int player, int suit, int rank) {
+  // the owners of the higher cards stay, the ones of the lower cards move up
+  auto const i = 2 * std::popcount<std::uint16_t>(remaining_[suit] >> (rank + 1));
+  auto const higher = owners_[suit] & ((std::uint32_t{1} << i) - 1);
+  owners_[suit] = higher | ((owners_[suit] >> (i + 2)) << i);
+  lengths_ -= std::uint64_t{1} << (16 * suit + 4 * player);
+}
+
+void double_dummy_solver::_insert_owner(int player, int suit, int rank) {
+  auto const i = 2 * std::popcount<std::uint16_t>(remaining_[suit] >> (rank + 1));
+  auto const higher = owners_[suit] & ((std::uint32_t{1} << i) - 1);
+  owners_[suit] = higher | (static_cast<std::uint32_t>(player) << i) | ((owners_[suit] >> i) << (i + 2));
+  lengths_ += std::uint64_t{1} << (16 * suit + 4 * player);
+}
+
+int solve_double_dummy(bridge::internal_state_type const& deal, bridge::player_type declarer, strain s) {
+  double_dummy_solver solver(s);
+  return solver.solve(deal, declarer);
+}
+
+dd_table_result dd_table(bridge::internal_state_type const& deal, vulnerability v, size_t threads) {
+  dd_table_result result;
+  auto const total = static_cast<int>(deal[0].size());
+  parallel_for(5, threads, [&](size_t s) {
+    double_dummy_solver solver(static_cast<strain>(s));
+    auto& tricks = result.tricks[s];
+    // north, south, east, west: the partner's result is the first guess, the opponents' the complement
+    tricks[0] = solver.solve(deal, 0);
+    tricks[2] = solver.solve(deal, 2, tricks[0]);
+    tricks[1] = solver.solve(deal, 1, total - tricks[0]);
+    tricks[3] = solver.solve(deal, 3, tricks[1]);
+  });
+
+  if (total == 13) result.par_score = par_score(result.tricks, v);
+  return result;
+}
+
+namespace {
+
+/**
+ * Index of a contract in the order of the auction: 1C, 1D, 1H, 1S, 1NT, 2C, ...
+ */
+int contract_index(int level, int s) { return 5 * (level - 1) + (s == notrump ? 4 : 3 - s); }
+
+int made_score(int level, int s, int tricks, bool vulnerable) {
+  int const per_trick = s == notrump || s <= static_cast<int>(suit::hearts) ? 30 : 20;
+  int const trick_score = level * per_trick + (s == notrump ? 10 : 0);
+  int score = trick_score + (tricks - 6 - level) * per_trick;
+  score += trick_score >= 100 ? (vulnerable ? 500 : 300) : 50;
+  if (level == 6) score += vulnerable ? 750 : 500;
+  if (level == 7) score += vulnerable ? 1500 : 1000;
+  return score;
+}
+
+int doubled_penalty(int down, bool vulnerable) {
+  if (vulnerable) return 200 + 300 * (down - 1);
+  return down <= 3 ? 100 + 200 * (down - 1) : 500 + 300 * (down - 3);
+}
+
+}  // namespace
+
+int par_score(std::array<std::array<int, 4>, 5> const& tricks, vulnerability v) {
+  // the best declarer of every side and strain
+  std::array<std::array<int, 5>, 2> best{};
+  std::array<int, 2> highest_contract{-1, -1};
+  for (int side = 0; side < 2; ++side) {
+    for (int s = 0; s < 5; ++s) {
+      best[side][s] = std::max(tricks[s][side], tricks[s][side + 2]);
+      if (best[side][s] >= 7) {
+        highest_contract[side] = std::max(highest_contract[side], contract_index(best[side][s] - 6, s));
+      }
+    }
+  }
+  if (highest_contract[0] < 0 && highest_contract[1] < 0) return 0;
+
+  int const declaring = highest_contract[0] >= highest_contract[1] ? 0 : 1;
+  int const defending = 1 - declaring;
+  bool const vulnerable[2] = {v == vulnerability::north_south || v == vulnerability::both,
+                              v == vulnerability::east_west || v == vulnerability::both};
+  int par = std::numeric_limits<int>::min();
+  for (int s = 0; s < 5; ++s) {
+    for (int level = 1; level <= best[declaring][s] - 6; ++level) {
+      auto const index = contract_index(level, s);
+      if (index <= highest_contract[defending]) continue;
+      int value = made_score(level, s, best[declaring][s], vulnerable[declaring]);
+      // the cheapest doubled sacrifice above the contract
+      for (int t = 0; t < 5; ++t) {
+        for (int l = 1; l <= 7; ++l) {
+          if (contract_index(l, t) <= index) continue;
+          value = std::min(value, doubled_penalty(l + 6 - best[defending][t], vulnerable[defending]));
+          break;
+        }
+      }
+      par = std::max(par, value);
+    }
+  }
+  return declaring == 0 ? par : -par;
+}
+
+}  // namespace golv
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <golv/games/bridge.hpp>
+#include <golv/util/static_vector.hpp>
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace golv {
+
+/**
+ * double_dummy_table is the transposition table of the double dummy solver (partition search). Positions are
+ * stored at the start of a trick and only with the cards which were relevant for the result: per suit the
+ * owners of the highest remaining cards down to the lowest relevant rank (relative ranks, i. e. independent
+ * of the cards played before). An entry matches every position with the same lengths of all hands in all
+ * suits and leader which agrees on these owners. The bounds are the tricks of north/south (players 0 and 2)
+ * in the remaining tricks, such that a table can be shared by all declarers of a strain.
+ * The entries are grouped by lengths and leader. The table is bounded: when it holds capacity entries, the
+ * entries not used by the current search are dropped and then the ones with the fewest remaining tricks (the
+ * cheapest to search again) until it is half full.
+ */
+class double_dummy_table {
+ public:
+  /**
+   * A position at the start of a trick: the owners of the remaining cards per suit from the highest
+   * (two bits each) and the lengths (4 bits per hand and suit).
+   */
+  struct position {
+    std::uint64_t lengths = 0;
+    std::array<std::uint32_t, 4> owners{};
+    std::uint8_t leader = 0;
+  };
+
+  struct entry {
+    std::array<std::uint32_t, 4> owners{};  // of the significant cards
+    std::array<std::uint32_t, 4> masks{};   // of the owners of the significant cards per suit
+    std::int8_t lower = 0;
+    std::int8_t upper = 0;
+    std::uint8_t move = 0;  // 1 + 16 * suit + relative rank of the best lead, 0 if unknown
+    std::uint8_t tricks = 0;
+    std::uint8_t age = 0;  // of the last search which used the entry
+
+    bool matches(position const& p) const {
+      return (((p.owners[0] & masks[0]) ^ owners[0]) | ((p.owners[1] & masks[1]) ^ owners[1]) |
+              ((p.owners[2] & masks[2]) ^ owners[2]) | ((p.owners[3] & masks[3]) ^ owners[3])) == 0;
+    }
+  };
+
+  explicit double_dummy_table(size_t capacity = size_t{1} << 20);
+
+  /**
+   * Call f(entry) for all entries matching the position until it returns true. The entry found moves
+   * towards the front of its group, such that the scans of frequently used entries are short.
+   */
+  template <class F>
+  entry const* find_if(position const& p, F&& f) {
+    auto it = groups_.find(key{p.lengths, p.leader});
+    if (it == groups_.end()) return nullptr;
+    auto& group = it->second;
+    for (size_t i = 0; i < group.size(); ++i) {
+      if (group[i].matches(p) && f(group[i])) {
+        group[i].age = age_;
+        std::swap(group[i], group[i / 2]);
+        return &group[i / 2];
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * Entry of the position with the given number of significant cards per suit, a new entry has the
+   * bounds [0, tricks].
+   */
+  entry& store(position const& p, std::array<std::uint8_t, 4> const& significant, std::uint8_t tricks);
+
+  /**
+   * Start a new search: the entries of the previous searches are dropped first when the table is full.
+   */
+  void new_search() { ++age_; }
+
+  void clear();
+  size_t capacity() const { return capacity_; }
+  size_t size() const { return size_; }
+
+ private:
+  struct key {
+    std::uint64_t lengths;
+    std::uint8_t leader;
+    bool operator==(key const&) const = default;
+  };
+
+  struct key_hash {
+    size_t operator()(key const& k) const;
+  };
+
+  void _age();
+
+  std::unordered_map<key, std::vector<entry>, key_hash> groups_;
+  size_t capacity_;
+  size_t size_ = 0;
+  std::uint8_t age_ = 0;
+};
+
+/**
+ * double_dummy_solver computes the number of tricks of the declarer and the partner if all hands are known
+ * and the left-hand opponent of the declarer leads. It works on bitboards (a rank mask per player and suit)
+ * instead of the bridge game and combines
+ *  - rank equivalence: of cards in sequence in one hand only one is tried,
+ *  - move ordering heuristics per position in the trick and the best lead of the table,
+ *  - quick tricks of the leader (and of the partner in one suit the leader can reach it with) as bounds at
+ *    the start of every trick,
+ *  - partition search: the double_dummy_table stores the positions with the relevant ranks only,
+ *  - MTD(f)-style probing: null window searches "at least n tricks?" which share the table.
+ * The hands can be smaller than 13 cards, but must have the same size.
+ */
+class double_dummy_solver {
+ public:
+  using deal_type = bridge::internal_state_type;
+  using player_type = bridge::player_type;
+
+  explicit double_dummy_solver(strain s, size_t table_capacity = size_t{1} << 20);
+
+  /**
+   * Tricks of the declarer's side. The probing starts at guess (e. g. the result of a related declarer)
+   * or in the middle of the bounds for a negative guess.
+   */
+  int solve(deal_type const& deal, player_type declarer, int guess = -1);
+
+  /**
+   * Check whether the declarer's side takes at least target tricks.
+   */
+  bool can_make(deal_type const& deal, player_type declarer, int target);
+
+  strain get_strain() const { return strain_; }
+  double_dummy_table const& table() const { return table_; }
+  double_dummy_table& table() { return table_; }
+
+  /**
+   * Searched nodes (cards played) since the construction.
+   */
+  std::uint64_t nodes() const { return nodes_; }
+
+ private:
+  using suit_masks = std::array<std::uint16_t, 4>;
+
+  struct trick {
+    std::uint8_t leader = 0;
+    std::uint8_t count = 0;
+    std::uint8_t winner = 0;
+    std::uint8_t lead_suit = 0;
+    std::uint8_t win_suit = 0;
+    std::uint8_t win_rank = 0;
+  };
+
+  struct move {
+    std::uint8_t suit = 0;
+    std::uint8_t rank = 0;
+    std::int16_t score = 0;
+  };
+
+  using move_list = static_vector<move, 13>;
+
+  void _setup(deal_type const& deal, player_type declarer);
+  bool _search(trick const& t, int target, suit_masks& relevant);
+  move_list _moves(trick const& t, int player, int hint_suit, int hint_rank) const;
+  int _lead_score(int player, int suit, int rank) const;
+  int _follow_score(trick const& t, int player, int suit, int rank) const;
+  bool _beaten_later(trick const& t, int player, int suit, int rank) const;
+  int _quick_tricks(int leader, suit_masks* relevant = nullptr) const;
+  double_dummy_table::position _position(int leader) const;
+  void _remove_owner(int player, int suit, int rank);
+  void _insert_owner(int player, int suit, int rank);
+  void _store(double_dummy_table::position const& p, suit_masks const& relevant, bool max_side_makes, int needed,
+              int move_suit, int move_rank);
+
+  strain strain_;
+  int trump_;  // suit index, 4 for no trump
+  double_dummy_table table_;
+
+  std::array<suit_masks, 4> hands_{};
+  suit_masks remaining_{};                 // cards in the hands
+  suit_masks played_{};                    // cards of the current trick
+  std::array<std::uint32_t, 4> owners_{};  // of the remaining cards per suit from the highest, two bits each
+  std::uint64_t lengths_ = 0;              // of the hands, 4 bits per hand and suit
+  int max_side_ = 0;                       // declarer % 2
+  int won_ = 0;                            // tricks of the declarer's side
+  int tricks_left_ = 0;
+  std::uint64_t nodes_ = 0;
+};
+
+/**
+ * Tricks of the declarer's side in a double dummy analysis (the left-hand opponent leads).
+ */
+int solve_double_dummy(bridge::internal_state_type const& deal, bridge::player_type declarer, strain s);
+
+enum class vulnerability { none, north_south, east_west, both };
+
+struct dd_table_result {
+  std::array<std::array<int, 4>, 5> tricks{};  // [strain][declarer]
+  int par_score = 0;                           // of north/south
+};
+
+/**
+ * The double dummy table of a deal: the tricks of all strains and declarers and the par score.
+ * Every strain is solved by one solver (one transposition table for all declarers) on a pool of
+ * threads (0 for the hardware concurrency). The result of a declarer is the first guess for the next.
+ */
+dd_table_result dd_table(bridge::internal_state_type const& deal, vulnerability v = vulnerability::none,
+                         size_t threads = 0);
+
+/**
+ * Par score of north/south for a double dummy table of 13-card hands: the side with the highest makeable
+ * contract chooses the contract with the best score considering the doubled sacrifices of the opponents.
+ */
+int par_score(std::array<std::array<int, 4>, 5> const& tricks, vulnerability v = vulnerability::none);
+
+}  // namespace golv
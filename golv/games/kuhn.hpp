@@ -25,6 +25,8 @@ class kuhn {
   using strategy_type = std::vector<double>;
   using information_set_type = std::string;
 
+  constexpr static int num_hands = 3;  // the private card
+
   kuhn() { reset(); }
 
   move_range legal_actions() const {
@@ -48,24 +50,36 @@ class kuhn {
   }
 
   value_type _value() const {
+    auto opponent = (current_player_ + 1) % 2;
+    return _value(card_[current_player_], card_[opponent]);
+  }
+
+  /**
+   * Value for the current player holding mine against theirs.
+   */
+  value_type _value(int mine, int theirs) const {
     if (!is_terminal()) throw std::logic_error("Value requested for non-terminal state");
 
-    auto opponent = (current_player_ + 1) % 2;
     // Payoff calculation
     if (state_ == "bf" || state_ == "xbf") {
       return 1;
     }
-    if (state_ == "xx") return card_[current_player_] > card_[opponent] ? 1 : -1;  // Higher card wins
+    if (state_ == "xx") return mine > theirs ? 1 : -1;  // Higher card wins
 
     if (state_ == "bc" || state_ == "xbc") {
-      return card_[current_player_] > card_[opponent] ? 2 : -2;  // Higher card wins double the pot
+      return mine > theirs ? 2 : -2;  // Higher card wins double the pot
     }
     throw std::logic_error("Unknown terminal state");
   }
 
   bool is_max() const { return current_player_ == max_player_; }
 
-  state_type state() const { return std::to_string(card_[current_player_]) + "|" + state_; }
+  state_type state() const { return information_set(card_[current_player_]); }
+
+  /**
+   * The information set of the current player holding card.
+   */
+  information_set_type information_set(int card) const { return std::to_string(card) + "|" + state_; }
 
   void apply_action(move_type move) {
     if (legal_actions().find(move) == std::string::npos) {
@@ -103,6 +117,22 @@ class kuhn {
     deal(deck[0], deck[1]);
   }
 
+  /**
+   * Leave the initial chance node without dealing the cards, see cfr::solve_public_tree().
+   */
+  void begin_public_tree() { current_player_ = 0; }
+
+  bool hand_possible(int card) const { return card >= 0 && card < num_hands; }
+
+  static bool hands_compatible(int card1, int card2) { return card1 != card2; }
+
+  /**
+   * Payoff of the first player in a terminal state, if the players hold card1 and card2.
+   */
+  value_type payoff(int card1, int card2) const {
+    return current_player_ == 0 ? _value(card1, card2) : -_value(card2, card1);
+  }
+
   void deal(move_type card1, move_type card2) {
     card_ = {card1, card2};  // Default card assignment
     GOLV_LOG_TRACE("Dealt cards: " << card_[0] << ", " << card_[1]);
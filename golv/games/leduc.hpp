@@ -0,0 +1,262 @@
+#pragma once
+
+#include <golv/util/exception.hpp>
+#include <golv/util/logging.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace golv {
+
+/**
+ * Leduc Hold'em implementation that satisfies the Game concept.
+ *
+ * The deck consists of six cards: two suits of the ranks J, Q and K. Both players ante 1 and get one private card.
+ * After a first betting round a public card is dealt and a second betting round follows. The bet size is 2 in the
+ * first and 4 in the second round, with at most two bets/raises per round. At the showdown a pair with the public
+ * card wins, otherwise the higher rank wins.
+ *
+ * Information sets are encoded as integers (see information_set()): the betting history uses two bits per action,
+ * followed by two bits each for the public and the private rank. This keeps the keys of the cfr map small and cheap
+ * to compare.
+ */
+class leduc {
+ public:
+  using value_type = double;
+  using player_type = int;  // 0 or 1, -1 at chance nodes
+  using information_set_type = std::uint32_t;
+  using state_type = information_set_type;
+
+  using move_type = char;          // 'f' for fold, 'c' for check/call, 'r' for bet/raise
+  using move_range = std::string;  // "cr", "fc" or "fcr"
+
+  using strategy_type = std::vector<double>;
+
+  constexpr static int num_cards = 6;
+  constexpr static int num_ranks = 3;
+  constexpr static int max_raises = 2;
+  constexpr static int max_actions = 8;  // at most "crrc" in each round
+  constexpr static int num_hands = num_cards;  // the private card
+
+  leduc() { reset(); }
+
+  static int rank(int card) { return card / 2; }
+
+  move_range legal_actions() const {
+    if (is_terminal() || is_chance_node()) throw std::logic_error("No legal actions available");
+    if (!_facing_bet()) return "cr";
+    return status_.raises < max_raises ? "fcr" : "fc";
+  }
+
+  player_type current_player() const { return status_.player; }
+
+  bool is_terminal() const { return status_.terminal; }
+
+  bool is_chance_node() const { return !status_.terminal && status_.player == -1; }
+
+  bool is_max() const { return status_.player == max_player_; }
+
+  /**
+   * Return the payoff of the maximizing player (only valid in terminal states).
+   */
+  value_type value() const {
+    if (!is_terminal()) throw std::logic_error("Value requested for non-terminal state");
+    return _payoff(max_player_, card_);
+  }
+
+  /**
+   * The information set of the current player. At chance nodes (no player to move), the public state with the
+   * private rank 3, which no information set uses.
+   */
+  state_type state() const {
+    if (status_.player < 0) return _public_state() | chance_rank;
+    return information_set(card_[status_.player]);
+  }
+
+  /**
+   * The information set of a player holding private_card in the current public state.
+   */
+  information_set_type information_set(int private_card) const {
+    return _public_state() | static_cast<information_set_type>(rank(private_card));
+  }
+
+  void apply_action(move_type move) {
+    if (legal_actions().find(move) == std::string::npos) {
+      throw golv::exception("Invalid move: " + std::string(1, move));
+    }
+    stack_[num_actions_++] = status_;
+
+    auto& s = status_;
+    auto const player = s.player;
+    auto const opponent = 1 - player;
+    bool const facing_bet = _facing_bet();
+    s.history = (s.history << 2) | _digit(move);
+
+    switch (move) {
+      case 'f':
+        s.terminal = true;
+        s.folded = player;
+        return;
+      case 'c':
+        s.pot[player] = s.pot[opponent];
+        if (facing_bet || s.actions > 0) {
+          return _end_round();
+        }
+        break;
+      case 'r':
+        s.pot[player] = s.pot[opponent] + (s.round == 0 ? 2 : 4);
+        ++s.raises;
+        break;
+    }
+    ++s.actions;
+    s.player = opponent;
+  }
+
+  void undo_action(move_type move) {
+    if (num_actions_ == 0 || (status_.history & 3) != _digit(move)) {
+      throw golv::exception("Cannot undo move: " + std::string(1, move));
+    }
+    // restores the public card as well if move closed the first round
+    status_ = stack_[--num_actions_];
+  }
+
+  bool hash_me() const { return true; }
+
+  void set_max(int player) { max_player_ = player; }
+
+  void reset() {
+    status_ = status{};
+    card_ = {-1, -1};
+    num_actions_ = 0;
+    max_player_ = 0;
+  }
+
+  /**
+   * Deal the private cards at the beginning and the public card after the first betting round.
+   */
+  void handle_chance_node() {
+    static thread_local std::mt19937 gen{std::random_device{}()};
+    if (card_[0] < 0) {
+      std::uniform_int_distribution<int> first(0, num_cards - 1), second(0, num_cards - 2);
+      int c0 = first(gen);
+      int c1 = second(gen);
+      if (c1 >= c0) ++c1;
+      deal(c0, c1);
+    } else {
+      std::uniform_int_distribution<int> dis(0, num_cards - 3);
+      int c = dis(gen);
+      // skip the private cards in ascending order
+      if (c >= std::min(card_[0], card_[1])) ++c;
+      if (c >= std::max(card_[0], card_[1])) ++c;
+      deal_public(c);
+    }
+  }
+
+  void deal(int card1, int card2) {
+    if (card1 == card2) throw golv::exception("Cannot deal the same card twice");
+    card_ = {card1, card2};
+    GOLV_LOG_TRACE("Dealt cards: " << card_[0] << ", " << card_[1]);
+    status_.player = 0;
+  }
+
+  void deal_public(int card) {
+    if (!is_chance_node() || status_.round != 1) throw golv::exception("Public card cannot be dealt now");
+    if (card == card_[0] || card == card_[1]) throw golv::exception("Public card already dealt to a player");
+    status_.public_card = card;
+    status_.player = 0;
+  }
+
+  /**
+   * Leave the initial chance node without dealing the private cards, see cfr::solve_public_tree().
+   */
+  void begin_public_tree() { status_.player = 0; }
+
+  /**
+   * Whether a player can hold card, i. e. it is not the public card.
+   */
+  bool hand_possible(int card) const { return card >= 0 && card < num_cards && card != status_.public_card; }
+
+  static bool hands_compatible(int card1, int card2) { return card1 != card2; }
+
+  /**
+   * Payoff of the first player in a terminal state, if the players hold card1 and card2.
+   */
+  value_type payoff(int card1, int card2) const { return _payoff(0, {card1, card2}); }
+
+  /**
+   * Possible public cards (ignoring the private cards) and the probability of each of them given the private cards.
+   */
+  std::vector<int> public_outcomes() const {
+    std::vector<int> outcomes;
+    for (int c = 0; c < num_cards; ++c) {
+      if (c != card_[0] && c != card_[1]) outcomes.push_back(c);
+    }
+    return outcomes;
+  }
+
+  static double public_outcome_probability() { return 1.0 / (num_cards - 2); }
+
+  int private_card(player_type player) const { return card_[player]; }
+  int public_card() const { return status_.public_card; }
+  int round() const { return status_.round; }
+  int pot(player_type player) const { return status_.pot[player]; }
+
+ private:
+  struct status {
+    std::array<int, 2> pot{1, 1};  // contributions including the ante
+    information_set_type history = 0;
+    int round = 0;
+    int raises = 0;   // bets and raises in the current round
+    int actions = 0;  // actions in the current round
+    int public_card = -1;
+    player_type player = -1;
+    player_type folded = -1;
+    bool terminal = false;
+  };
+
+  constexpr static information_set_type chance_rank = 3;
+
+  information_set_type _public_state() const {
+    information_set_type public_rank = status_.public_card < 0 ? 0 : rank(status_.public_card) + 1;
+    return (status_.history << 4) | (public_rank << 2);
+  }
+
+  static information_set_type _digit(move_type move) { return move == 'f' ? 1 : (move == 'c' ? 2 : 3); }
+
+  bool _facing_bet() const { return status_.pot[status_.player] < status_.pot[1 - status_.player]; }
+
+  void _end_round() {
+    if (status_.round == 0) {
+      status_.round = 1;
+      status_.raises = 0;
+      status_.actions = 0;
+      status_.player = -1;  // public card is dealt next
+    } else {
+      status_.terminal = true;
+    }
+  }
+
+  value_type _payoff(player_type player, std::array<int, 2> const& cards) const {
+    auto const opponent = 1 - player;
+    if (status_.folded >= 0) {
+      return status_.folded == player ? -status_.pot[player] : status_.pot[opponent];
+    }
+    auto const public_rank = rank(status_.public_card);
+    auto strength = [public_rank](int card) { return rank(card) == public_rank ? num_ranks + rank(card) : rank(card); };
+    auto const mine = strength(cards[player]), theirs = strength(cards[opponent]);
+    if (mine == theirs) return 0;
+    return mine > theirs ? status_.pot[opponent] : -status_.pot[player];
+  }
+
+  status status_;
+  std::array<int, 2> card_{-1, -1};  // private cards of the players
+  std::array<status, max_actions> stack_;
+  int num_actions_ = 0;
+  int max_player_ = 0;  // player to maximize value
+};
+
+}  // namespace golv
@@ -8,92 +8,8 @@
 
 namespace golv {
 
-namespace {
-bool less_suit(suit left, suit right)
-{
-  if (left == right) return false;
-  if (left == suit::diamonds) return true;
-  if (right == suit::diamonds) return false;
-  if (left == suit::hearts) return true;
-  if (right == suit::hearts) return false;
-  if (left == suit::spades) return true;
-  return false;
-}
-
-bool less_kind(kind left, kind right)
-{
-  if (left == right) return false;
-  if (left == kind::ten) {
-    if (right == kind::ace)
-      return true;
-    else
-      return false;
-  }
-  if (right == kind::ten) {
-    if (left == kind::ace)
-      return false;
-    else
-      return true;
-  }
-  return static_cast<int>(left) > static_cast<int>(right);
-}
-
-bool is_trump(card const& c, trump t)
-{
-  if (c.get_kind() == kind::jack) return true;
-  if (t == trump::grand) {
-    return false;
-  }
-  return (static_cast<int>(t) == static_cast<int>(c.get_suit()));
-}
-
-bool less_trump(card const& left, card const& right)
-{
-  if (left.get_kind() == kind::jack) {
-    if (right.get_kind() == kind::jack) {
-      return less_suit(left.get_suit(), right.get_suit());
-    }
-    return false;
-  }
-  if (right.get_kind() == kind::jack) {
-    return true;
-  }
-  return less_kind(left.get_kind(), right.get_kind());
-}
-}  // namespace
-
-bool skat_card_order::operator()(card const& left, card const& right) const
-{
-  if (is_trump(left, trump_)) {
-    if (is_trump(right, trump_)) {
-      return less_trump(left, right);
-    } else {
-      return false;
-    }
-  }
-  if (is_trump(right, trump_)) {
-    return true;
-  }
-  if (left.get_suit() == lead_suit) {
-    if (right.get_suit() == lead_suit) {
-      return less_kind(left.get_kind(), right.get_kind());
-    } else {
-      return false;
-    }
-  } else {
-    if (right.get_suit() == lead_suit) {
-      return true;
-    } else {
-      if (left.get_suit() == right.get_suit()) {
-        return less_kind(left.get_kind(), right.get_kind());
-      } else {
-        return less_suit(left.get_suit(), right.get_suit());
-      }
-    }
-  }
-}
-
-skat::value_type count_eyes(hand const& cards) {
+template <class CardsT>
+skat::value_type count_eyes(CardsT const& cards) {
   skat::value_type eyes = 0;
   for (auto const& card : cards) {
     switch (card.get_kind()) {
@@ -125,33 +41,21 @@ skat::move_range skat::legal_actions() const {
     throw golv::exception("Soloist not set.");
   }
   if (state_[3].size() <= 1) {
-    return state_[soloist_];
+    return {state_[soloist_].begin(), state_[soloist_].end()};
   }
   skat::move_range legal;
   auto const& cards = state_[*current_player_];
   if (tricks_.empty() || tricks_.back().cards_.empty()) {
-    legal = cards;
+    legal = skat::move_range{cards.begin(), cards.end()};
   } else {
-    if (tricks_.back().cards_.front().get_kind() == kind::jack) {
-      auto it = std::find_if(cards.begin(), cards.end(), [](const card& c) { return c.get_kind() == kind::jack; });
-      if (it != cards.end()) {
-        legal = skat::move_range{it, cards.end()};
-      } else {
-        legal = cards;
-      }
-    } else {
-      auto lead_suit = tricks_.back().cards_.front().get_suit();
-      auto it = std::find_if(cards.begin(), cards.end(), [lead_suit](const card& c) {
-        return c.get_kind() != kind::jack && c.get_suit() == lead_suit;
-      });
-      if (it != cards.end()) {
-        auto it2 = std::find_if(it, cards.end(), [lead_suit](const card& c) {
-          return c.get_kind() == kind::jack || c.get_suit() != lead_suit;
-        });
-        legal = skat::move_range{it, it2};
-      } else {
-        legal = cards;
-      }
+    // follow the lead: a trump (jacks and the trump suit) or the suit of the lead
+    auto const lead = tricks_.back().cards_.front();
+    auto const follows = [this, lead](const card& c) {
+      return is_trump(lead) ? is_trump(c) : !is_trump(c) && c.get_suit() == lead.get_suit();
+    };
+    std::copy_if(cards.begin(), cards.end(), std::back_inserter(legal), follows);
+    if (legal.empty()) {
+      legal = skat::move_range{cards.begin(), cards.end()};
     }
   }
   GOLV_LOG_TRACE("legal_actions for player " << *current_player_ << ": " << legal);
@@ -160,13 +64,14 @@ skat::move_range skat::legal_actions() const {
 
 skat::player_type skat::get_trick_winner() const {
   assert(!tricks_.empty());
-  auto last_trick = tricks_.back().cards_;
-  std::sort(std::begin(last_trick), std::end(last_trick), skat_card_order{last_trick.front().get_suit()});
-  GOLV_LOG_TRACE("Sorted trick: " << last_trick);
-  auto it = std::find(std::begin(tricks_.back().cards_), std::end(tricks_.back().cards_), last_trick.back());
-  assert(it != tricks_.back().cards_.end());
-  skat::player_type winner = (tricks_.back().leader_ + (it - tricks_.back().cards_.begin())) % num_players;
-  GOLV_LOG_TRACE("Trick Winner = " << winner << " for trick " << tricks_.back().cards_);
+  auto const& cards = tricks_.back().cards_;
+  skat_card_order const order{cards.front().get_suit(), trump_};
+  size_t best = 0;
+  for (size_t i = 1; i < cards.size(); ++i) {
+    if (order.rank(cards[best]) < order.rank(cards[i])) best = i;
+  }
+  skat::player_type winner = (tricks_.back().leader_ + best) % num_players;
+  GOLV_LOG_TRACE("Trick Winner = " << winner << " for trick " << cards);
   return winner;
 }
 
@@ -177,17 +82,21 @@ skat::state_type skat::state() const {
       bits |= c.code();
     }
   }
-  if (*current_player_ == 1) {
-    bits |= state_[3][0].code();
-  } else if (*current_player_ == 2) {
-    bits |= state_[3][1].code();
+  // the current player in the highest bits, which are no card
+  if (*current_player_ != 0) {
+    bits.set(bits.size() - 3 + *current_player_);
   }
   return bits;
 }
 
+bool skat::is_trump(card c) const {
+  return c.get_kind() == kind::jack || (trump_ != trump::grand && static_cast<int>(c.get_suit()) == static_cast<int>(trump_));
+}
+
 bool skat::is_new_trick() const
 {
-  return !tricks_.empty() && tricks_.back().cards_.empty();
+  // undoing the first trick leaves an empty trick, which is no new trick while pushing
+  return state_[3].size() == 2 && !tricks_.empty() && tricks_.back().cards_.empty();
 }
 
 void skat::push(skat::move_type const& move)
@@ -211,6 +120,7 @@ void skat::apply_action(skat::move_type const& move)
   if (it == std::end(cards)) {
     throw golv::exception("Card not in hand");
   }
+  journal_.push_back({move, static_cast<std::uint8_t>(it - cards.begin()), *current_player_, value_, opp_value_});
   cards.erase(it);
 
   // pushing phase
@@ -239,51 +149,31 @@ void skat::apply_action(skat::move_type const& move)
 
 void skat::undo_action(skat::move_type const& move) {
   GOLV_LOG_TRACE("undo_action for player " << *current_player_ << ": " << move);
-  if (tricks_.empty() ||
-      (tricks_.size() == 1 && tricks_.back().cards_.empty())) {
-    if (state_[3].empty()) {
-      throw golv::exception("No move to undo");
-    } else {
-      // unpush
-      GOLV_LOG_TRACE("unpushing " << move);
-      auto& skat = state_[3];
-      auto it = std::find(skat.begin(), skat.end(), move);
-      if (it == skat.end()) {
-        throw golv::exception("move not found in skat");
-      }
-      skat.erase(it);
-      state_[soloist_].push_back(move);
-      current_player_ = soloist_;
-      value_ = 0;
-      return;
-    }
+  if (journal_.empty()) {
+    throw golv::exception("No move to undo");
   }
-  if (!tricks_.back().cards_.empty()) {
-    if (tricks_.back().cards_.back() != move) {
-      throw golv::exception("Cannot undo action");
-    }
-    --current_player_;
-    auto& cards = state_[*current_player_];
-    cards.push_back(move);
-    std::sort(cards.begin(), cards.end(), skat_card_order{});
-    tricks_.back().cards_.pop_back();
+  auto const entry = journal_.back();
+  if (entry.move_ != move) {
+    throw golv::exception("Cannot undo action");
+  }
+  journal_.pop_back();
+
+  if (tricks_.empty() || (tricks_.size() == 1 && tricks_.back().cards_.empty())) {
+    // unpush
+    GOLV_LOG_TRACE("unpushing " << move);
+    state_[3].pop_back();
   } else {
-    if ((tricks_.end() - 2)->cards_.back() != move) {
-      throw golv::exception("Cannot undo action");
-    }
-    if (tricks_.back().leader_ == soloist_) {
-      value_ -= (tricks_.end() - 2)->eyes_;
-    } else {
-      opp_value_ -= (tricks_.end() - 2)->eyes_;
+    if (tricks_.back().cards_.empty()) {
+      tricks_.pop_back();
+      tricks_.back().eyes_ = 0;
     }
-    (tricks_.end() - 2)->eyes_ = 0;
-    tricks_.pop_back();
     tricks_.back().cards_.pop_back();
-    current_player_ = tricks_.back().leader_;
-    --current_player_;
-    state_[*current_player_].push_back(move);
-    std::sort(state_[*current_player_].begin(), state_[*current_player_].end(), skat_card_order{});
   }
+  auto& cards = state_[entry.player_];
+  cards.insert(cards.begin() + entry.slot_, move);
+  current_player_ = entry.player_;
+  value_ = entry.value_;
+  opp_value_ = entry.opp_value_;
 }
 
 skat::value_type skat::value() const
@@ -333,7 +223,7 @@ void skat::deal(golv::hand const& first_hand, golv::hand const& second_hand,
   }
 }
 
-const std::vector<skat::trick>& skat::tricks() const
+const skat::trick_range& skat::tricks() const
 {
   return tricks_;
 }
@@ -2,8 +2,11 @@
 
 #include <golv/games/cards.hpp>
 #include <golv/util/cyclic_number.hpp>
+#include <golv/util/static_vector.hpp>
 #include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace golv {
 
@@ -16,11 +19,65 @@ enum class trump
   grand
 };
 
+namespace detail {
+
+/**
+ * Rank of a card in a skat trick (ascending), given the trump and the lead suit:
+ * jacks (by suit) > trump suit > lead suit > the other suits (diamonds < hearts < spades < clubs).
+ * Within a suit: 7 < 8 < 9 < Q < K < T < A.
+ */
+constexpr std::uint8_t skat_rank(card c, trump t, suit lead_suit) {
+  constexpr std::uint8_t suit_ranks[] = {2, 1, 0, 3};  // spades, hearts, diamonds, clubs
+  auto const k = c.get_kind();
+  auto const s = c.get_suit();
+  auto const suit_rank = suit_ranks[static_cast<int>(s)];
+  if (k == kind::jack) return 192 + suit_rank;
+  auto const kind_rank = k == kind::ace ? 13 : k == kind::ten ? 12 : 12 - static_cast<int>(k);
+  if (t != trump::grand && static_cast<int>(t) == static_cast<int>(s)) return static_cast<std::uint8_t>(128 + kind_rank);
+  if (s == lead_suit) return static_cast<std::uint8_t>(64 + kind_rank);
+  return static_cast<std::uint8_t>(16 * suit_rank + kind_rank);
+}
+
+/**
+ * The suit a card follows: the trumps (jacks and the trump suit) are group 4, the other cards their suit.
+ */
+constexpr int skat_follow_group(card c, trump t) {
+  if (c.get_kind() == kind::jack) return 4;
+  if (t != trump::grand && static_cast<int>(t) == static_cast<int>(c.get_suit())) return 4;
+  return static_cast<int>(c.get_suit());
+}
+
+/**
+ * skat_ranks[trump][lead suit][card index]
+ */
+constexpr auto skat_ranks = [] {
+  std::array<std::array<std::array<std::uint8_t, no_card + 1>, 4>, 5> ranks{};
+  for (int t = 0; t < 5; ++t) {
+    for (int s = 0; s < 4; ++s) {
+      for (int i = 0; i <= no_card; ++i) {
+        ranks[t][s][i] = skat_rank(card::from_index(static_cast<card::index_type>(i)), static_cast<trump>(t),
+                                   static_cast<suit>(s));
+      }
+    }
+  }
+  return ranks;
+}();
+
+}  // namespace detail
+
+/**
+ * skat_card_order compares cards by their precomputed rank, i. e. the winner of a trick is the card
+ * with the highest rank for the suit of the first card.
+ */
 struct skat_card_order {
   suit lead_suit = suit::clubs;
   trump trump_ = trump::grand;
 
-  bool operator()(card const& left, card const& right) const;
+  constexpr std::uint8_t rank(card const& c) const {
+    return detail::skat_ranks[static_cast<int>(trump_)][static_cast<int>(lead_suit)][c.index()];
+  }
+
+  constexpr bool operator()(card const& left, card const& right) const { return rank(left) < rank(right); }
 };
 
 /**
@@ -31,21 +88,25 @@ struct skat_card_order {
 class skat {
  public:
   constexpr static size_t num_players = 3;
+  constexpr static std::string_view name = "skat";
 
   using move_type = card;
-  using move_range = std::vector<move_type>;
+  using move_range = static_vector<move_type, 12>;  // the soloist holds 12 cards while pushing
   using value_type = short;
   using player_type = unsigned short;
-  using internal_state_type = std::array<move_range, num_players + 1>;
+  using internal_state_type = std::array<golv::hand, num_players + 1>;
   using state_type = card::code_type;
   using cyclic_player_type = cyclic_number<player_type, num_players>;
 
   struct trick {
-    std::vector<card> cards_;
+    static_vector<card, num_players> cards_;
     player_type leader_;
     value_type eyes_{0};
   };
 
+  // at most 10 tricks plus the empty trick after the last one
+  using trick_range = static_vector<trick, 11>;
+
   /**
    * Return a list of all legal actions for the current player.
    */
@@ -62,6 +123,11 @@ class skat {
    */
   value_type opp_value() const;
 
+  /**
+   * Return the eyes of a skat deck, i. e. value() + opp_value() at the end of a full game.
+   */
+  constexpr static value_type total_value() { return 120; }
+
   /**
    * Check whether the current player is the maximizing player.
    */
@@ -78,8 +144,16 @@ class skat {
    */
   void skip_pushing();
 
+  player_type get_soloist() const { return soloist_; }
+  trump get_trump() const { return trump_; }
+
   /**
-   * Declare a trump.
+   * Cards in the hand of a player.
+   */
+  golv::hand const& get_hand(player_type player) const { return state_[player]; }
+
+  /**
+   * Declare a trump after set_soloist(), the trump is honored when following suit and in the trick winner.
    */
   void declare(trump t);
 
@@ -93,7 +167,7 @@ class skat {
    */
   bool is_terminal() const;
   state_type state() const;
-  const std::vector<trick>& tricks() const;
+  const trick_range& tricks() const;
 
   /**
    * Deal a skat deck of 32 cards such that player i gets (deck[i*10], ...,
@@ -118,14 +192,28 @@ class skat {
 
  private:
   player_type get_trick_winner() const;
+  bool is_trump(card c) const;
   bool is_new_trick() const;
   void push(skat::move_type const& move);
 
+  /**
+   * Journal entry of a move, such that undo_action() restores the hand, the current player
+   * and the values without sorting.
+   */
+  struct undo_entry {
+    card move_;
+    std::uint8_t slot_;  // position of the card in the hand
+    player_type player_;
+    value_type value_;
+    value_type opp_value_;
+  };
+
   value_type value_{0};
   value_type opp_value_{0};
 
   internal_state_type state_;
-  std::vector<trick> tricks_;
+  trick_range tricks_;
+  static_vector<undo_entry, 32> journal_;  // two cards pushed, 30 played
   player_type soloist_ = 100;
   cyclic_player_type current_player_ = 0;
   trump trump_ = trump::grand;
@@ -0,0 +1,35 @@
+#include <golv/algorithms/mws.hpp>
+#include <golv/algorithms/packed_mws_table.hpp>
+#include <golv/games/skat_declaration.hpp>
+#include <golv/util/parallel_for.hpp>
+
+namespace golv {
+
+skat_declaration_table_type skat_declaration_table(skat const& game, size_t threads, size_t memory_bytes) {
+  skat_declaration_table_type result;
+  parallel_for(5 * skat::num_players, threads, [&](size_t i) {
+    auto const t = static_cast<trump>(i / skat::num_players);
+    auto const soloist = static_cast<skat::player_type>(i % skat::num_players);
+    skat g = game;
+    g.set_soloist(soloist);
+    g.declare(t);
+
+    minimal_window_search mws(g, packed_mws_table<skat>(memory_bytes));
+    auto& declaration = result[i / skat::num_players][soloist];
+    declaration.value = mws_binary_search(mws, -1, skat::total_value()).first;
+    // a cutoff at the root sets the best move: push the cards which keep the value
+    for (auto& c : declaration.push) {
+      if (declaration.value > 0) {
+        mws.solve(declaration.value - 1);
+        c = mws.best_move();
+      } else {
+        // every pushing keeps the value
+        c = mws.game_.legal_actions().front();
+      }
+      mws.game_.apply_action(c);
+    }
+  });
+  return result;
+}
+
+}  // namespace golv
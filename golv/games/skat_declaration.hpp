@@ -0,0 +1,32 @@
+#pragma once
+
+#include <golv/games/skat.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace golv {
+
+/**
+ * Double dummy value of a skat game for one trump and soloist after the best pushing.
+ */
+struct skat_declaration {
+  skat::value_type value = 0;  // eyes of the soloist including the pushed cards
+  std::array<card, 2> push{};  // the pushed cards of the best pushing
+};
+
+/**
+ * [trump][soloist], the trumps in the order of the enum (spades, hearts, diamonds, clubs, grand)
+ */
+using skat_declaration_table_type = std::array<std::array<skat_declaration, skat::num_players>, 5>;
+
+/**
+ * Solve a dealt game (without soloist) for all trumps and soloists. Every declaration is solved with
+ * mws_binary_search including the pushing, the best pushed cards are taken from a second pass over the
+ * same (warm) table. The 15 declarations run on a pool of threads (0 for the hardware concurrency), each
+ * with a packed_mws_table of memory_bytes.
+ */
+skat_declaration_table_type skat_declaration_table(skat const& game, size_t threads = 0,
+                                                   size_t memory_bytes = size_t{16} << 20);
+
+}  // namespace golv
@@ -0,0 +1,301 @@
+#include <golv/games/skat_endgame.hpp>
+#include <golv/util/exception.hpp>
+#include <golv/util/parallel_for.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+
+namespace golv {
+
+namespace {
+
+using mask_type = std::uint64_t;  // bits of the positions in the deck
+using hands_type = std::array<mask_type, skat::num_players>;  // relative to the soloist
+
+/**
+ * binomials[n][k] for n <= 32
+ */
+constexpr auto binomials = [] {
+  std::array<std::array<std::uint64_t, skat_endgame_table::max_deck_size + 1>,
+             skat_endgame_table::max_deck_size + 1>
+      c{};
+  for (size_t n = 0; n < c.size(); ++n) {
+    c[n][0] = 1;
+    for (size_t k = 1; k <= n; ++k) c[n][k] = c[n - 1][k - 1] + c[n - 1][k];
+  }
+  return c;
+}();
+
+constexpr std::uint8_t no_position = 255;
+constexpr size_t set_block = 4096;  // sets of cards per task of the generator
+
+std::uint8_t eyes(card c) {
+  switch (c.get_kind()) {
+    case kind::jack:
+      return 2;
+    case kind::ace:
+      return 11;
+    case kind::ten:
+      return 10;
+    case kind::king:
+      return 4;
+    case kind::queen:
+      return 3;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * The set of m positions of a colex rank.
+ */
+mask_type unrank(std::uint64_t rank, unsigned m, size_t n) {
+  mask_type mask = 0;
+  size_t p = n;
+  for (unsigned i = m; i > 0; --i) {
+    do {
+      --p;
+    } while (binomials[p][i] > rank);
+    rank -= binomials[p][i];
+    mask |= mask_type{1} << p;
+  }
+  return mask;
+}
+
+/**
+ * The next set of the same size in colex order.
+ */
+mask_type next_set(mask_type x) {
+  auto const c = x & -x;
+  auto const r = x + c;
+  return (((r ^ x) >> 2) / c) | r;
+}
+
+/**
+ * The bits of a local set (the i-th bit for the i-th lowest position) in the positions of mask.
+ */
+mask_type scatter(mask_type local, mask_type mask) {
+  mask_type result = 0;
+  for (; mask != 0; mask &= mask - 1, local >>= 1) {
+    if (local & 1) result |= mask & -mask;
+  }
+  return result;
+}
+
+std::uint64_t position_index(hands_type const& h, unsigned leader, unsigned k) {
+  auto const all = h[0] | h[1] | h[2];
+  std::uint64_t cards = 0, first = 0, second = 0;
+  unsigned i = 0, t = 0, l = 0;
+  for (auto m = all; m != 0; m &= m - 1, ++l) {
+    auto const p = static_cast<unsigned>(std::countr_zero(m));
+    cards += binomials[p][++i];
+    if (h[0] & (mask_type{1} << p)) first += binomials[l][++t];
+  }
+  t = l = 0;
+  for (auto m = h[1] | h[2]; m != 0; m &= m - 1, ++l) {
+    if (h[1] & m & -m) second += binomials[l][++t];
+  }
+  return ((cards * binomials[3 * k][k] + first) * binomials[2 * k][k] + second) * 3 + leader;
+}
+
+/**
+ * The cards of the deck by position and what the search of a trick needs of them.
+ */
+struct deck_info {
+  size_t size = 0;
+  std::array<card, skat_endgame_table::max_deck_size> cards{};
+  std::array<std::uint8_t, skat_endgame_table::max_deck_size> eyes{};
+  std::array<mask_type, 5> groups{};  // positions of the follow groups
+
+  deck_info(std::uint64_t deck, trump t) {
+    for (auto m = deck; m != 0; m &= m - 1, ++size) {
+      cards[size] = card::from_index(static_cast<card::index_type>(std::countr_zero(m)));
+      eyes[size] = golv::eyes(cards[size]);
+      groups[detail::skat_follow_group(cards[size], t)] |= mask_type{1} << size;
+    }
+  }
+};
+
+/**
+ * Search the trick at the start of a position of level k, the remaining tricks are looked up in level k - 1.
+ */
+std::uint8_t solve_trick(deck_info const& deck, trump t, hands_type h, unsigned leader, unsigned k,
+                         std::uint8_t const* below) {
+  auto const better = [](unsigned player, int value, int best) { return player == 0 ? value > best : value < best; };
+  auto const second = (leader + 1) % 3;
+  auto const third = (leader + 2) % 3;
+  int best_first = leader == 0 ? -1 : 1000;
+  for (auto m0 = h[leader]; m0 != 0; m0 &= m0 - 1) {
+    auto const a = static_cast<unsigned>(std::countr_zero(m0));
+    auto const lead = deck.cards[a];
+    auto const group = deck.groups[detail::skat_follow_group(lead, t)];
+    auto const& ranks = detail::skat_ranks[static_cast<int>(t)][static_cast<int>(lead.get_suit())];
+    auto const legal_second = (h[second] & group) != 0 ? h[second] & group : h[second];
+    auto const legal_third = (h[third] & group) != 0 ? h[third] & group : h[third];
+    int best_second = second == 0 ? -1 : 1000;
+    for (auto m1 = legal_second; m1 != 0; m1 &= m1 - 1) {
+      auto const b = static_cast<unsigned>(std::countr_zero(m1));
+      int best_third = third == 0 ? -1 : 1000;
+      for (auto m2 = legal_third; m2 != 0; m2 &= m2 - 1) {
+        auto const c = static_cast<unsigned>(std::countr_zero(m2));
+        std::array<unsigned, 3> const played{a, b, c};
+        unsigned winner = 0;
+        for (unsigned i = 1; i < 3; ++i) {
+          if (ranks[deck.cards[played[winner]].index()] < ranks[deck.cards[played[i]].index()]) winner = i;
+        }
+        winner = (leader + winner) % 3;
+        int value = winner == 0 ? deck.eyes[a] + deck.eyes[b] + deck.eyes[c] : 0;
+        if (k > 1) {
+          auto rest = h;
+          rest[leader] &= ~(mask_type{1} << a);
+          rest[second] &= ~(mask_type{1} << b);
+          rest[third] &= ~(mask_type{1} << c);
+          value += below[position_index(rest, winner, k - 1)];
+        }
+        if (better(third, value, best_third)) best_third = value;
+      }
+      if (better(second, best_third, best_second)) best_second = best_third;
+    }
+    if (better(leader, best_second, best_first)) best_first = best_second;
+  }
+  return static_cast<std::uint8_t>(best_first);
+}
+
+}  // namespace
+
+std::uint64_t skat_endgame_table::positions(size_t deck_size, unsigned cards) {
+  return binomials[deck_size][3 * cards] * binomials[3 * cards][cards] * binomials[2 * cards][cards] * 3;
+}
+
+void skat_endgame_table::_init(data& d) {
+  auto const& h = d.header;
+  if (static_cast<unsigned>(h.trump_) > static_cast<unsigned>(trump::grand) || (h.deck >> detail::no_card) != 0) {
+    throw golv::exception("Invalid endgame table");
+  }
+  auto const n = static_cast<size_t>(std::popcount(h.deck));
+  if (n > max_deck_size || h.max_cards == 0 || 3 * h.max_cards > n) {
+    throw golv::exception("Invalid endgame table for " + std::to_string(n) + " cards and " +
+                          std::to_string(h.max_cards) + " cards per player");
+  }
+  d.positions.fill(no_position);
+  std::uint8_t p = 0;
+  for (auto m = h.deck; m != 0; m &= m - 1) d.positions[std::countr_zero(m)] = p++;
+  d.offsets.assign(h.max_cards + 1, 0);
+  std::uint64_t offset = 0;
+  for (unsigned k = 1; k <= h.max_cards; ++k) {
+    d.offsets[k] = offset;
+    offset += positions(n, k);
+  }
+  d.header.size = offset;
+}
+
+skat_endgame_table skat_endgame_table::generate(std::uint64_t deck, trump t, unsigned max_cards, size_t threads) {
+  auto d = std::make_shared<data>();
+  std::memcpy(d->header.magic, skat_endgame_header::magic_string, sizeof(d->header.magic));
+  d->header.version = skat_endgame_header::current_version;
+  d->header.trump_ = t;
+  d->header.deck = deck;
+  d->header.max_cards = max_cards;
+  d->header.byte_order = skat_endgame_header::byte_order_mark;
+  _init(*d);
+  d->owned.resize(d->header.size);
+
+  deck_info const info(deck, t);
+  for (unsigned k = 1; k <= max_cards; ++k) {
+    auto* values = d->owned.data() + d->offsets[k];
+    auto const* below = d->owned.data() + d->offsets[k - 1];
+    auto const sets = binomials[info.size][3 * k];
+    auto const firsts = binomials[3 * k][k];
+    auto const seconds = binomials[2 * k][k];
+    parallel_for((sets + set_block - 1) / set_block, threads, [&](size_t block) {
+      auto const begin = block * set_block;
+      auto const end = std::min<std::uint64_t>(begin + set_block, sets);
+      auto all = unrank(begin, 3 * k, info.size);
+      for (auto s = begin; s < end; ++s, all = next_set(all)) {
+        auto first_local = (mask_type{1} << k) - 1;
+        for (std::uint64_t r0 = 0; r0 < firsts; ++r0, first_local = next_set(first_local)) {
+          auto const first = scatter(first_local, all);
+          auto const others = all & ~first;
+          auto second_local = (mask_type{1} << k) - 1;
+          for (std::uint64_t r1 = 0; r1 < seconds; ++r1, second_local = next_set(second_local)) {
+            auto const second = scatter(second_local, others);
+            hands_type const h{first, second, others & ~second};
+            auto const i = ((s * firsts + r0) * seconds + r1) * 3;
+            for (unsigned leader = 0; leader < 3; ++leader) {
+              values[i + leader] = solve_trick(info, t, h, leader, k, below);
+            }
+          }
+        }
+      }
+    });
+  }
+  d->values = d->owned.data();
+
+  skat_endgame_table table;
+  table.data_ = std::move(d);
+  return table;
+}
+
+skat_endgame_table::skat_endgame_table(std::string const& path) {
+  auto d = std::make_shared<data>();
+  d->file = mapped_file(path);
+  if (d->file.size() < sizeof(skat_endgame_header)) throw golv::exception("Not an endgame table: " + path);
+  std::memcpy(&d->header, d->file.data(), sizeof(d->header));
+  if (std::memcmp(d->header.magic, skat_endgame_header::magic_string, sizeof(d->header.magic)) != 0) {
+    throw golv::exception("Not an endgame table: " + path);
+  }
+  if (d->header.version != skat_endgame_header::current_version) {
+    throw golv::exception("Unsupported endgame table version: " + std::to_string(d->header.version));
+  }
+  if (d->header.byte_order != skat_endgame_header::byte_order_mark) {
+    throw golv::exception("Endgame table written with a different byte order: " + path);
+  }
+  auto const size = d->header.size;
+  _init(*d);
+  if (d->header.size != size || d->file.size() < sizeof(skat_endgame_header) + size) {
+    throw golv::exception("Truncated endgame table: " + path);
+  }
+  d->values = reinterpret_cast<std::uint8_t const*>(d->file.data() + sizeof(skat_endgame_header));
+  data_ = std::move(d);
+}
+
+void skat_endgame_table::save(std::string const& path) const {
+  auto const tmp_path = path + ".tmp";
+  {
+    auto file = mapped_file::create(tmp_path, sizeof(skat_endgame_header) + size());
+    std::memcpy(file.data(), &data_->header, sizeof(skat_endgame_header));
+    std::memcpy(file.data() + sizeof(skat_endgame_header), data_->values, size());
+    file.flush();
+  }
+  std::filesystem::rename(tmp_path, path);
+}
+
+std::optional<skat_endgame_table::value_type> skat_endgame_table::probe(skat const& game) const {
+  auto const& d = *data_;
+  auto const soloist = game.get_soloist();
+  if (game.get_trump() != d.header.trump_ || soloist >= skat::num_players || game.get_hand(3).size() != 2) {
+    return std::nullopt;
+  }
+  auto const& tricks = game.tricks();
+  if (!tricks.empty() && !tricks.back().cards_.empty()) return std::nullopt;
+  auto const k = static_cast<unsigned>(game.get_hand(0).size());
+  if (k == 0 || k > d.header.max_cards) return std::nullopt;
+
+  hands_type h{};
+  for (skat::player_type p = 0; p < skat::num_players; ++p) {
+    auto const& cards = game.get_hand(p);
+    if (cards.size() != k) return std::nullopt;
+    auto& mask = h[(p + skat::num_players - soloist) % skat::num_players];
+    for (auto const& c : cards) {
+      auto const position = d.positions[c.index()];
+      if (position == no_position) return std::nullopt;
+      mask |= mask_type{1} << position;
+    }
+  }
+  auto const leader = (game.current_player() + skat::num_players - soloist) % skat::num_players;
+  return d.values[d.offsets[k] + position_index(h, leader, k)];
+}
+
+}  // namespace golv
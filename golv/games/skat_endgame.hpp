@@ -0,0 +1,114 @@
+#pragma once
+
+#include <golv/games/skat.hpp>
+#include <golv/util/mapped_file.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace golv {
+
+/**
+ * Binary endgame table format (native byte order, readers reject files with a different byte_order):
+ *
+ *   header
+ *   std::uint8_t values[level 1], ..., values[level max_cards]
+ *
+ * Level k holds the eyes the soloist takes in the last k tricks for every position at the start of a trick
+ * with k cards per player, all of them from the deck of the table.
+ */
+struct skat_endgame_header {
+  constexpr static char magic_string[8] = "GOLVEGT";
+  constexpr static std::uint32_t current_version = 2;
+  constexpr static std::uint32_t byte_order_mark = 0x01020304;
+
+  char magic[8];
+  std::uint32_t version;
+  trump trump_;
+  std::uint64_t deck;  // bits of the card indices
+  std::uint32_t max_cards;
+  std::uint32_t byte_order;  // byte_order_mark as written
+  std::uint64_t size;  // bytes of the values
+};
+
+/**
+ * skat_endgame_table is an EndgameTable for skat (see minimal_window_search and alpha_beta) with the values
+ * of all positions with up to max_cards cards per player for a deck and a trump.
+ *
+ * The players are taken relative to the soloist, i. e. a table serves all soloists. A position of level k is
+ * indexed by the combinatorial rank of its 3k cards among the deck, the ranks of the cards of the soloist and
+ * of the next player among the 3k (resp. 2k) cards and the leader:
+ *
+ *   ((rank(cards) * C(3k, k) + rank(soloist)) * C(2k, k) + rank(next)) * 3 + leader
+ *
+ * Level k has C(n, 3k) * C(3k, k) * C(2k, k) * 3 positions of one byte for a deck of n cards, e. g. 0.25 GB
+ * for k = 2 and 141 GB for k = 3 with all 32 cards, such that k = 3 is meant for smaller decks.
+ *
+ * Tables are generated level by level (each position is the search of one trick on the level below) and
+ * stored as files which are mapped read-only. Copies share the values, so a table can be handed to many
+ * solvers and threads.
+ */
+class skat_endgame_table {
+ public:
+  using value_type = skat::value_type;
+
+  constexpr static size_t max_deck_size = 32;
+
+  /**
+   * Generate the table on a pool of threads (0 for the hardware concurrency).
+   * Throws golv::exception if the deck has more than 32 cards or less than 3 * max_cards.
+   */
+  static skat_endgame_table generate(std::uint64_t deck, trump t, unsigned max_cards, size_t threads = 0);
+
+  /**
+   * Map a table written by save().
+   */
+  explicit skat_endgame_table(std::string const& path);
+
+  /**
+   * Write the table to path (via a temporary file, such that readers never see a partial table).
+   */
+  void save(std::string const& path) const;
+
+  /**
+   * The eyes of the soloist in the remaining tricks, if the game is at the start of a trick with at most
+   * max_cards() cards per player, all of the deck, and the trump is the trump of the table.
+   */
+  std::optional<value_type> probe(skat const& game) const;
+
+  std::uint64_t deck() const { return data_->header.deck; }
+  trump get_trump() const { return data_->header.trump_; }
+  unsigned max_cards() const { return data_->header.max_cards; }
+
+  /**
+   * Number of positions of a level for a deck of deck_size cards.
+   */
+  static std::uint64_t positions(size_t deck_size, unsigned cards);
+
+  /**
+   * Bytes of the values of all levels.
+   */
+  size_t size() const { return data_->header.size; }
+
+ private:
+  struct data {
+    skat_endgame_header header{};
+    std::array<std::uint8_t, 64> positions{};  // of the card indices in the deck, 255 if not in the deck
+    std::vector<std::uint64_t> offsets;        // of the levels, offsets[0] is unused
+    std::vector<std::uint8_t> owned;
+    mapped_file file;
+    std::uint8_t const* values = nullptr;  // owned or the mapping of file
+  };
+
+  skat_endgame_table() = default;
+
+  static void _init(data& d);
+
+  std::shared_ptr<data const> data_;
+};
+
+}  // namespace golv
@@ -0,0 +1,186 @@
+#include <golv/algorithms/mws.hpp>
+#include <golv/games/skat_pimc.hpp>
+#include <golv/util/exception.hpp>
+#include <golv/util/logging.hpp>
+#include <golv/util/parallel_for.hpp>
+
+#include <algorithm>
+
+namespace golv {
+
+namespace {
+
+bool contains(golv::hand const& cards, card c) { return std::find(cards.begin(), cards.end(), c) != cards.end(); }
+
+}  // namespace
+
+skat_view skat_view::of(skat const& game, skat::player_type player) {
+  if (game.get_soloist() >= skat::num_players) throw golv::exception("Soloist not set.");
+  if (game.blinds().size() != 2) throw golv::exception("No view while pushing.");
+  if (player >= skat::num_players) throw golv::exception("Invalid player: " + std::to_string(player));
+
+  auto const blinds = game.blinds();
+  skat_view view;
+  view.player = player;
+  view.soloist = game.get_soloist();
+  view.trump_ = game.get_trump();
+  view.hand = game.get_hand(player);
+  if (player == view.soloist) view.blinds = blinds;
+  view.tricks.assign(game.tricks().begin(), game.tricks().end());
+
+  // the cards in play are public (e. g. a smaller deck), not their owners
+  view.deck.clear();
+  for (skat::player_type p = 0; p < skat::num_players; ++p) {
+    view.deck.insert(view.deck.end(), game.get_hand(p).begin(), game.get_hand(p).end());
+  }
+  view.deck.insert(view.deck.end(), blinds.begin(), blinds.end());
+  for (auto const& t : view.tricks) view.deck.insert(view.deck.end(), t.cards_.begin(), t.cards_.end());
+  return view;
+}
+
+skat::player_type skat_view::current_player() const {
+  if (tricks.empty()) return 0;
+  auto const& t = tricks.back();
+  return static_cast<skat::player_type>((t.leader_ + t.cards_.size()) % skat::num_players);
+}
+
+golv::hand skat_view::hidden_cards() const {
+  golv::hand hidden;
+  auto const played = [this](card c) {
+    return std::any_of(tricks.begin(), tricks.end(), [c](auto const& t) {
+      return std::find(t.cards_.begin(), t.cards_.end(), c) != t.cards_.end();
+    });
+  };
+  std::copy_if(deck.begin(), deck.end(), std::back_inserter(hidden),
+               [&](card c) { return !contains(hand, c) && !contains(blinds, c) && !played(c); });
+  return hidden;
+}
+
+std::uint8_t skat_view::voids(skat::player_type p) const {
+  std::uint8_t bits = 0;
+  for (auto const& t : tricks) {
+    if (t.cards_.empty()) continue;
+    auto const lead = detail::skat_follow_group(t.cards_.front(), trump_);
+    for (size_t i = 1; i < t.cards_.size(); ++i) {
+      if ((t.leader_ + i) % skat::num_players == p && detail::skat_follow_group(t.cards_[i], trump_) != lead) {
+        bits |= static_cast<std::uint8_t>(1 << lead);
+      }
+    }
+  }
+  return bits;
+}
+
+skat skat_view::determinize(skat::internal_state_type const& hands) const {
+  auto full = hands;
+  for (auto const& t : tricks) {
+    for (size_t i = 0; i < t.cards_.size(); ++i) {
+      full[(t.leader_ + i) % skat::num_players].push_back(t.cards_[i]);
+    }
+  }
+  skat game;
+  game.deal(full[0], full[1], full[2], full[3]);
+  game.set_soloist(soloist);
+  game.declare(trump_);
+  for (auto const& c : hands[3]) game.apply_action(c);
+  for (auto const& t : tricks) {
+    for (auto const& c : t.cards_) game.apply_action(c);
+  }
+  return game;
+}
+
+deal_generator skat_view::generator() const {
+  auto const cards_per_player = (deck.size() - 2) / skat::num_players;
+  std::array<size_t, skat::num_players> played{};
+  for (auto const& t : tricks) {
+    for (size_t i = 0; i < t.cards_.size(); ++i) ++played[(t.leader_ + i) % skat::num_players];
+  }
+
+  // the holders of the hidden cards: the other players and the skat if it is unknown
+  deal_spec spec;
+  spec.groups.assign(deal_spec::max_groups, 0);
+  for (auto c : hidden_cards()) {
+    spec.deck |= detail::card_codes[c.index()];
+    spec.groups[detail::skat_follow_group(c, trump_)] |= detail::card_codes[c.index()];
+  }
+  spec.holders.resize(skat::num_players + 1);
+  for (skat::player_type p = 0; p < skat::num_players; ++p) {
+    if (p == player) continue;
+    spec.holders[p].size = static_cast<std::uint8_t>(cards_per_player - played[p]);
+    auto const v = voids(p);
+    for (size_t g = 0; g < deal_spec::max_groups; ++g) {
+      if (v & (1 << g)) spec.holders[p].set_void(g);
+    }
+  }
+  spec.holders[3].size = blinds.empty() ? 2 : 0;
+  return deal_generator(std::move(spec));
+}
+
+skat skat_view::sample(deal_generator const& generator, std::mt19937_64& rng) const {
+  auto const deal = generator.sample(rng);
+  skat::internal_state_type hands;
+  for (size_t h = 0; h < hands.size(); ++h) hands[h] = mask_to_hand(deal[h]);
+  hands[player] = hand;
+  if (!blinds.empty()) hands[3] = blinds;
+  return determinize(hands);
+}
+
+skat skat_view::sample(std::mt19937_64& rng) const { return sample(generator(), rng); }
+
+pimc_result pimc_move(skat_view const& view, size_t samples, size_t threads, std::chrono::milliseconds time_budget,
+                      std::uint64_t seed) {
+  if (view.current_player() != view.player) throw golv::exception("Not the turn of the player of the view");
+
+  auto const generator = view.generator();
+  pimc_result result;
+  {
+    std::mt19937_64 rng(seed);
+    auto const moves = view.sample(generator, rng).legal_actions();
+    result.moves.assign(moves.begin(), moves.end());
+  }
+  if (result.moves.empty()) throw golv::exception("No legal move");
+  result.values.assign(result.moves.size(), 0.0);
+  result.best_move = result.moves.front();
+  if (result.moves.size() == 1) return result;
+
+  auto const deadline = std::chrono::steady_clock::now() + time_budget;
+  auto const expired = [&] { return time_budget.count() > 0 && std::chrono::steady_clock::now() > deadline; };
+  std::vector<std::vector<skat::value_type>> sample_values(samples);
+  parallel_for(samples, threads, [&](size_t i) {
+    std::mt19937_64 rng(seed + i);
+    minimal_window_search mws(view.sample(generator, rng), mws_unordered_table<skat>{});
+    auto& values = sample_values[i];
+    for (auto const& m : result.moves) {
+      // a sample which is not solved for all moves when the budget is used up is dropped
+      if (expired()) {
+        values.clear();
+        return;
+      }
+      mws.game_.apply_action(m);
+      // the eyes won so far are a lower bound, the eyes of the opponents an upper bound
+      auto const lower = static_cast<skat::value_type>(mws.game_.value() - 1);
+      auto const upper = static_cast<skat::value_type>(skat::total_value() - mws.game_.opp_value());
+      values.push_back(mws_binary_search(mws, lower, upper).first);
+      mws.game_.undo_action(m);
+    }
+  });
+
+  // sum up in the order of the samples, such that the result does not depend on the threads
+  for (auto const& values : sample_values) {
+    if (values.empty()) continue;
+    ++result.samples;
+    for (size_t m = 0; m < values.size(); ++m) result.values[m] += values[m];
+  }
+  if (result.samples == 0) return result;
+  for (auto& v : result.values) v /= static_cast<double>(result.samples);
+
+  auto const soloist = view.player == view.soloist;
+  size_t best = 0;
+  for (size_t m = 1; m < result.values.size(); ++m) {
+    if (soloist ? result.values[m] > result.values[best] : result.values[m] < result.values[best]) best = m;
+  }
+  result.best_move = result.moves[best];
+  GOLV_LOG_DEBUG("pimc: " << result.samples << " samples, best move " << result.best_move);
+  return result;
+}
+
+}  // namespace golv
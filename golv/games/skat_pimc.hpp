@@ -0,0 +1,85 @@
+#pragma once
+
+#include <golv/games/deal_generator.hpp>
+#include <golv/games/skat.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace golv {
+
+/**
+ * skat_view is what one player knows about a skat game in the playing phase: the own hand, the played
+ * tricks and the skat (only for the soloist, who pushed it).
+ */
+struct skat_view {
+  skat::player_type player = 0;
+  skat::player_type soloist = 0;
+  trump trump_ = trump::grand;
+  golv::hand hand;
+  golv::hand blinds;                     // the pushed cards if known
+  std::vector<skat::trick> tricks;       // as skat::tricks(), the last one is the current trick
+  golv::hand deck = create_skat_deck();  // all cards of the game (hands and skat)
+
+  /**
+   * The view of a player on a game after pushing.
+   */
+  static skat_view of(skat const& game, skat::player_type player);
+
+  /**
+   * The player whose turn it is.
+   */
+  skat::player_type current_player() const;
+
+  /**
+   * The hidden cards: the deck without the own hand, the played cards and the known skat.
+   */
+  golv::hand hidden_cards() const;
+
+  /**
+   * Bits of the effective suits (suits 0 to 3 without the trumps, 4 for the trumps) in which a player
+   * did not follow.
+   */
+  std::uint8_t voids(skat::player_type p) const;
+
+  /**
+   * A game with the given hands at the current position (and the skat), i. e. the played cards are added
+   * to the hands and the game is replayed up to the current position.
+   */
+  skat determinize(skat::internal_state_type const& hands) const;
+
+  /**
+   * The generator of the hidden cards (holders 0 to 2 are the players, 3 is the skat) which respects the
+   * hand sizes and the voids.
+   */
+  deal_generator generator() const;
+
+  /**
+   * A game with the hidden cards dealt uniformly at random by the generator of the view.
+   */
+  skat sample(deal_generator const& generator, std::mt19937_64& rng) const;
+  skat sample(std::mt19937_64& rng) const;
+};
+
+struct pimc_result {
+  skat::move_type best_move;
+  std::vector<skat::move_type> moves;
+  std::vector<double> values;  // mean eyes of the soloist after each move (0 without samples)
+  size_t samples = 0;          // solved deals, 0 for a single legal move
+};
+
+/**
+ * Perfect information Monte Carlo: sample deals consistent with the view, compute the value of every legal
+ * move in each deal (mws_binary_search after the move, one table per deal) and choose the move with the best
+ * mean for the player of the view. The samples are solved on a pool of threads (0 for the hardware
+ * concurrency), sample i uses a generator seeded with seed + i, such that the result does not depend on the
+ * number of threads. With a time budget the searches stop once it is used up: a sample counts only if all
+ * moves were solved before, i. e. the budget is exceeded by at most one search per thread.
+ */
+pimc_result pimc_move(skat_view const& view, size_t samples, size_t threads = 0,
+                      std::chrono::milliseconds time_budget = std::chrono::milliseconds{0},
+                      std::uint64_t seed = 1);
+
+}  // namespace golv
@@ -79,6 +79,26 @@ tictactoe::state_type tictactoe::state() const {
   return state;
 }
 
+std::uint64_t tictactoe::position_index() const {
+  std::uint64_t index = 0;
+  for (auto it = state_.rbegin(); it != state_.rend(); ++it) {
+    index = 3 * index + static_cast<std::uint64_t>(*it);
+  }
+  return index;
+}
+
+tictactoe tictactoe::from_position_index(std::uint64_t index) {
+  tictactoe game;
+  size_t pieces = 0;
+  for (auto& field : game.state_) {
+    field = static_cast<field_state>(index % 3);
+    index /= 3;
+    if (field != field_state::empty) ++pieces;
+  }
+  game.current_player_ = pieces % 2 == 0 ? player_type::X : player_type::O;
+  return game;
+}
+
 tictactoe::tictactoe() : state_{num_fields, field_state::empty} {}
 
 bool tictactoe::is_max() const { return current_player_ == player_type::X; }
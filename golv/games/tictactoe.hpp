@@ -1,6 +1,9 @@
 #pragma once
 
+#include <golv/util/static_vector.hpp>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace golv {
@@ -14,11 +17,17 @@ class tictactoe
 {
   public:
     using move_type = short;
-    using move_range = std::vector<move_type>;
+    using move_range = static_vector<move_type, 9>;
     using value_type = short;
 
+    constexpr static std::string_view name = "tictactoe";
     constexpr static size_t num_fields = 9;
 
+    /**
+     * Positions of position_index(): the fields in base 3.
+     */
+    constexpr static std::uint64_t num_positions = 19683;
+
     enum class player_type
     {
         X,
@@ -47,6 +56,9 @@ class tictactoe
     state_type state() const;
     bool hash_me() const { return true; }
 
+    std::uint64_t position_index() const;
+    static tictactoe from_position_index(std::uint64_t index);
+
    private:
     player_type current_player_ = player_type::X;
     internal_state_type state_;
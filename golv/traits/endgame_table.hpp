@@ -0,0 +1,34 @@
+#pragma once
+
+#include <golv/traits/game.hpp>
+#include <concepts>
+#include <optional>
+#include <type_traits>
+
+namespace golv {
+
+/**
+ * EndgameTable knows the exact values of (some) positions near the leaves. probe() returns the value which
+ * is still to be gained from the given position on (i. e. relative to game.value()) or nothing, such that
+ * the solvers return it instead of searching.
+ */
+template <class T, class GameT>
+concept EndgameTable = requires(T const t, GameT const g) {
+  { t.probe(g) } -> std::convertible_to<std::optional<typename GameT::value_type>>;
+};
+
+/**
+ * no_endgame_table is the placeholder for solvers without an endgame table.
+ */
+template <Game GameT>
+struct no_endgame_table {
+  constexpr std::optional<typename GameT::value_type> probe(GameT const&) const { return std::nullopt; }
+};
+
+template <class T>
+struct with_endgame_table : public std::true_type {};
+
+template <class GameT>
+struct with_endgame_table<no_endgame_table<GameT>> : public std::false_type {};
+
+}  // namespace golv
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <concepts>
+#include <cstdint>
+#include <string_view>
 
 template <class GameT>
 concept Game = requires(GameT g) {
@@ -34,4 +36,47 @@ concept Game = requires(GameT g) {
                    {
                        g.state()
                        } -> std::convertible_to<typename GameT::state_type>;
-               };
\ No newline at end of file
+               };
+
+/**
+ * Games that can be traversed on the public tree (see cfr::solve_public_tree()). The private information of each
+ * player is one out of num_hands hands, everything else is public. The hands are not dealt, instead the solver
+ * carries them as vectors of reach probabilities.
+ */
+template <class GameT>
+concept PublicTreeGame = Game<GameT> && requires(GameT g, GameT const& cg, int hand) {
+                                           { GameT::num_hands } -> std::convertible_to<int>;
+                                           typename GameT::information_set_type;
+                                           { g.begin_public_tree() };
+                                           { g.is_chance_node() } -> std::convertible_to<bool>;
+                                           {
+                                               cg.information_set(hand)
+                                               } -> std::convertible_to<typename GameT::information_set_type>;
+                                           { cg.hand_possible(hand) } -> std::convertible_to<bool>;
+                                           { GameT::hands_compatible(hand, hand) } -> std::convertible_to<bool>;
+                                           { cg.payoff(hand, hand) } -> std::convertible_to<double>;
+                                       };
+
+/**
+ * Public tree games with public chance nodes (e. g. the flop of leduc).
+ */
+template <class GameT>
+concept PublicChanceGame = PublicTreeGame<GameT> && requires(GameT g, GameT const& cg, int outcome) {
+                                                        { cg.public_outcomes() };
+                                                        { g.deal_public(outcome) };
+                                                        {
+                                                            GameT::public_outcome_probability()
+                                                            } -> std::convertible_to<double>;
+                                                    };
+
+/**
+ * Games whose positions have a perfect hash into [0, num_positions) (see retrograde_table), such that a position
+ * can be restored from its index. The name identifies the game in stored tables.
+ */
+template <class GameT>
+concept IndexedGame = Game<GameT> && requires(GameT const& cg, std::uint64_t index) {
+                                         { GameT::name } -> std::convertible_to<std::string_view>;
+                                         { GameT::num_positions } -> std::convertible_to<std::uint64_t>;
+                                         { cg.position_index() } -> std::convertible_to<std::uint64_t>;
+                                         { GameT::from_position_index(index) } -> std::convertible_to<GameT>;
+                                     };
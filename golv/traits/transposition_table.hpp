@@ -1,6 +1,8 @@
 #pragma once
 
 #include <golv/traits/game.hpp>
+#include <concepts>
+#include <cstddef>
 #include <type_traits>
 
 namespace golv {
@@ -42,4 +44,13 @@ struct with_table : public std::true_type {};
 template <class GameT>
 struct with_table<no_table<GameT>> : public std::false_type {};
 
+/**
+ * Tables which remember the index of the move that caused the last cutoff (e. g. packed_mws_table).
+ */
+template <class T>
+concept with_best_move = requires(T t, std::size_t index) {
+  { t.best_move(typename T::state_type()) } -> std::convertible_to<std::size_t>;
+  { t.update_lower(typename T::state_type(), typename T::value_type(), index) };
+};
+
 }  // namespace golv
\ No newline at end of file
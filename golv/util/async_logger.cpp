@@ -0,0 +1,84 @@
+#include <golv/util/async_logger.hpp>
+#include <golv/util/exception.hpp>
+
+#include <chrono>
+
+namespace golv {
+
+namespace {
+constexpr auto idle_wait = std::chrono::microseconds(200);
+}
+
+async_logger::async_logger(logger& sink, size_t capacity)
+    : sink_(sink), capacity_(capacity), slots_(std::make_unique<slot[]>(capacity)) {
+  if (capacity_ == 0 || (capacity_ & (capacity_ - 1)) != 0) {
+    throw golv::exception("async_logger: capacity must be a power of two");
+  }
+  for (size_t i = 0; i < capacity_; ++i) slots_[i].sequence.store(i, std::memory_order_relaxed);
+  writer_ = std::thread([this] { _run(); });
+}
+
+async_logger::~async_logger() {
+  stop_.store(true, std::memory_order_release);
+  writer_.join();
+}
+
+// bounded queue after D. Vyukov: a slot is free for the producer at position pos if its sequence is pos
+// and ready for the consumer if its sequence is pos + 1
+void async_logger::log(log_level lvl, const std::string& msg) const {
+  if (!enabled(lvl)) return;
+  auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    auto& s = slots_[pos & (capacity_ - 1)];
+    auto const seq = s.sequence.load(std::memory_order_acquire);
+    auto const diff = static_cast<std::int64_t>(seq) - static_cast<std::int64_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        s.level = lvl;
+        s.message = msg;
+        s.sequence.store(pos + 1, std::memory_order_release);
+        return;
+      }
+    } else if (diff < 0) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);  // full
+      return;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool async_logger::_pop(log_level& lvl, std::string& msg) {
+  auto const pos = dequeue_pos_.load(std::memory_order_relaxed);
+  auto& s = slots_[pos & (capacity_ - 1)];
+  if (s.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+  lvl = s.level;
+  msg.swap(s.message);
+  s.sequence.store(pos + capacity_, std::memory_order_release);
+  dequeue_pos_.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+void async_logger::_run() {
+  log_level lvl;
+  std::string msg;
+  for (;;) {
+    bool const stopping = stop_.load(std::memory_order_acquire);
+    bool written = false;
+    while (_pop(lvl, msg)) {
+      sink_.log(lvl, msg);
+      written = true;
+    }
+    if (stopping) break;
+    if (!written) std::this_thread::sleep_for(idle_wait);
+  }
+}
+
+void async_logger::flush() const {
+  auto const target = enqueue_pos_.load(std::memory_order_acquire);
+  while (dequeue_pos_.load(std::memory_order_acquire) < target) {
+    std::this_thread::sleep_for(idle_wait);
+  }
+}
+
+}  // namespace golv
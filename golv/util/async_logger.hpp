@@ -0,0 +1,65 @@
+#pragma once
+
+#include <golv/util/logging.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace golv {
+
+/**
+ * async_logger hands the formatted messages over to a background thread, which writes them to the sink.
+ * Producers never block: the messages go into a bounded lock-free ring buffer (multi-producer,
+ * single-consumer) and are dropped (and counted) if it is full.
+ * The level of the async_logger filters the messages, the level of the sink is checked by the sink itself.
+ */
+class async_logger : public logger {
+ public:
+  explicit async_logger(logger& sink = the_logger::console(), size_t capacity = 4096);
+
+  async_logger(async_logger const&) = delete;
+  async_logger& operator=(async_logger const&) = delete;
+
+  /**
+   * Writes the remaining messages before returning.
+   */
+  ~async_logger() override;
+
+  void log(log_level lvl, const std::string& msg) const override;
+
+  /**
+   * Wait until all messages logged so far are written.
+   */
+  void flush() const;
+
+  /**
+   * Number of messages dropped because the buffer was full.
+   */
+  std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  size_t capacity() const { return capacity_; }
+
+ private:
+  struct slot {
+    std::atomic<std::uint64_t> sequence;
+    log_level level;
+    std::string message;
+  };
+
+  bool _pop(log_level& lvl, std::string& msg);
+  void _run();
+
+  logger& sink_;
+  size_t capacity_;
+  std::unique_ptr<slot[]> slots_;
+  mutable std::atomic<std::uint64_t> enqueue_pos_{0};
+  std::atomic<std::uint64_t> dequeue_pos_{0};
+  mutable std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<bool> stop_{false};
+  std::thread writer_;
+};
+
+}  // namespace golv
@@ -2,4 +2,11 @@
 
 namespace golv {
 void set_log_level(log_level lvl) { the_logger::instance().set_level(lvl); }
-}
\ No newline at end of file
+
+logger& set_logger(logger& l)
+{
+  auto& previous = the_logger::instance();
+  the_logger::current() = &l;
+  return previous;
+}
+}
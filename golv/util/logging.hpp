@@ -3,6 +3,19 @@
 #include <iostream>
 #include <sstream>
 
+/**
+ * GOLV_LOG_MIN_LEVEL is the most verbose level compiled in (0 = fatal, ..., 5 = trace, -1 = no logging at all).
+ * Messages above it compile to nothing; the others are only formatted if the runtime level allows them.
+ * Defaults to trace, or to no logging with NDEBUG (e. g. -DGOLV_LOG_MIN_LEVEL=2 for instrumented release builds).
+ */
+#ifndef GOLV_LOG_MIN_LEVEL
+#ifndef NDEBUG
+#define GOLV_LOG_MIN_LEVEL 5
+#else
+#define GOLV_LOG_MIN_LEVEL -1
+#endif
+#endif
+
 namespace golv {
 enum class log_level
 {
@@ -18,8 +31,12 @@ struct logger
 {
     log_level level_ = log_level::trace;
 
+    virtual ~logger() = default;
+
     virtual void log(log_level lvl, const std::string& msg) const = 0;
     void set_level(log_level lvl) { level_ = lvl; }
+
+    bool enabled(log_level lvl) const { return static_cast<int>(lvl) <= static_cast<int>(level_); }
 };
 
 struct console_logger : public logger
@@ -56,23 +73,46 @@ struct console_logger : public logger
 
 struct the_logger
 {
-    static logger& instance()
+    static logger& instance() { return *current(); }
+
+    static console_logger& console()
     {
         static console_logger _instance;
         return _instance;
     }
+
+    /**
+     * The installed logger (the console logger by default).
+     */
+    static logger*& current()
+    {
+        static logger* _current = &console();
+        return _current;
+    }
 };
 
 void
 set_log_level(log_level lvl);
+
+/**
+ * Install another logger (e. g. an async_logger) and return the previous one.
+ * Not thread-safe: call it before the threads that log are started.
+ */
+logger&
+set_logger(logger& l);
 }
 
-#ifndef NDEBUG
+#if GOLV_LOG_MIN_LEVEL >= 0
 #define _GOLV_LOG(lvl, msg)                                                                                            \
     do {                                                                                                               \
-        std::stringstream ss;                                                                                          \
-        ss << msg << std::endl;                                                                                        \
-        golv::the_logger::instance().log(lvl, ss.str());                                                               \
+        if constexpr (static_cast<int>(lvl) <= GOLV_LOG_MIN_LEVEL) {                                                   \
+            auto const& _golv_logger = golv::the_logger::instance();                                                   \
+            if (_golv_logger.enabled(lvl)) {                                                                           \
+                std::ostringstream ss;                                                                                 \
+                ss << msg << std::endl;                                                                                \
+                _golv_logger.log(lvl, ss.str());                                                                       \
+            }                                                                                                          \
+        }                                                                                                              \
     } while (false)
 #else
 #define _GOLV_LOG(lvl, msg) ;
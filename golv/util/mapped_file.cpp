@@ -0,0 +1,150 @@
+#include <golv/util/exception.hpp>
+#include <golv/util/mapped_file.hpp>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace golv {
+
+mapped_file::mapped_file(std::string const& path, mode m) { _map(path, m, false, 0); }
+
+mapped_file mapped_file::create(std::string const& path, size_t size) {
+  mapped_file file;
+  file._map(path, mode::read_write, true, size);
+  return file;
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept { _swap(other); }
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+  if (this != &other) {
+    close();
+    _swap(other);
+  }
+  return *this;
+}
+
+mapped_file::~mapped_file() { close(); }
+
+void mapped_file::_swap(mapped_file& other) noexcept {
+  std::swap(data_, other.data_);
+  std::swap(size_, other.size_);
+#ifdef _WIN32
+  std::swap(file_, other.file_);
+  std::swap(mapping_, other.mapping_);
+#else
+  std::swap(fd_, other.fd_);
+#endif
+}
+
+#ifdef _WIN32
+
+void mapped_file::_map(std::string const& path, mode m, bool create, size_t size) {
+  DWORD access = m == mode::read_write ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+  HANDLE file = CreateFileA(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                            create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw golv::exception("Cannot open file: " + path);
+  }
+  file_ = file;
+  LARGE_INTEGER file_size;
+  if (create) {
+    file_size.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(file, file_size, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+      close();
+      throw golv::exception("Cannot resize file: " + path);
+    }
+  } else if (!GetFileSizeEx(file, &file_size)) {
+    close();
+    throw golv::exception("Cannot read size of file: " + path);
+  }
+  size_ = static_cast<size_t>(file_size.QuadPart);
+  if (size_ == 0) return;
+
+  DWORD protect = m == mode::read_write ? PAGE_READWRITE : (m == mode::copy_on_write ? PAGE_WRITECOPY : PAGE_READONLY);
+  mapping_ = CreateFileMappingA(file, nullptr, protect, 0, 0, nullptr);
+  if (mapping_ == nullptr) {
+    close();
+    throw golv::exception("Cannot map file: " + path);
+  }
+  DWORD view = m == mode::read_write ? FILE_MAP_WRITE : (m == mode::copy_on_write ? FILE_MAP_COPY : FILE_MAP_READ);
+  data_ = static_cast<std::byte*>(MapViewOfFile(mapping_, view, 0, 0, size_));
+  if (data_ == nullptr) {
+    close();
+    throw golv::exception("Cannot map view of file: " + path);
+  }
+}
+
+void mapped_file::flush() {
+  if (data_ != nullptr) FlushViewOfFile(data_, size_);
+}
+
+void mapped_file::close() {
+  if (data_ != nullptr) UnmapViewOfFile(data_);
+  if (mapping_ != nullptr) CloseHandle(mapping_);
+  if (file_ != nullptr) CloseHandle(file_);
+  data_ = nullptr;
+  mapping_ = nullptr;
+  file_ = nullptr;
+  size_ = 0;
+}
+
+#else
+
+void mapped_file::_map(std::string const& path, mode m, bool create, size_t size) {
+  int flags = m == mode::read_write ? O_RDWR : O_RDONLY;
+  if (create) flags |= O_CREAT | O_TRUNC;
+  fd_ = ::open(path.c_str(), flags, 0644);
+  if (fd_ < 0) {
+    throw golv::exception("Cannot open file: " + path);
+  }
+  if (create) {
+    if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+      close();
+      throw golv::exception("Cannot resize file: " + path);
+    }
+    size_ = size;
+  } else {
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+      close();
+      throw golv::exception("Cannot read size of file: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+  }
+  if (size_ == 0) return;
+
+  int protect = m == mode::read_only ? PROT_READ : (PROT_READ | PROT_WRITE);
+  int share = m == mode::read_write ? MAP_SHARED : MAP_PRIVATE;
+  void* data = ::mmap(nullptr, size_, protect, share, fd_, 0);
+  if (data == MAP_FAILED) {
+    close();
+    throw golv::exception("Cannot map file: " + path);
+  }
+  data_ = static_cast<std::byte*>(data);
+}
+
+void mapped_file::flush() {
+  if (data_ != nullptr) ::msync(data_, size_, MS_SYNC);
+}
+
+void mapped_file::close() {
+  if (data_ != nullptr) ::munmap(data_, size_);
+  if (fd_ >= 0) ::close(fd_);
+  data_ = nullptr;
+  fd_ = -1;
+  size_ = 0;
+}
+
+#endif
+
+}  // namespace golv
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace golv {
+
+/**
+ * mapped_file maps a whole file into memory (mmap on POSIX, file mappings on Windows).
+ * It is the common backend for the binary files of golv (e. g. cfr checkpoints).
+ * Errors are reported by throwing golv::exception.
+ */
+class mapped_file {
+ public:
+  enum class mode
+  {
+    read_only,      // shared read-only mapping
+    read_write,     // changes are written back to the file
+    copy_on_write   // changes stay private to the process
+  };
+
+  mapped_file() = default;
+
+  /**
+   * Map an existing file.
+   */
+  explicit mapped_file(std::string const& path, mode m = mode::read_only);
+
+  /**
+   * Create (or truncate) a file of the given size and map it read_write.
+   */
+  static mapped_file create(std::string const& path, size_t size);
+
+  mapped_file(mapped_file const&) = delete;
+  mapped_file& operator=(mapped_file const&) = delete;
+  mapped_file(mapped_file&& other) noexcept;
+  mapped_file& operator=(mapped_file&& other) noexcept;
+  ~mapped_file();
+
+  std::byte* data() { return data_; }
+  std::byte const* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool is_open() const { return data_ != nullptr; }
+
+  /**
+   * Write changes of a read_write mapping back to disk.
+   */
+  void flush();
+
+  void close();
+
+ private:
+  void _map(std::string const& path, mode m, bool create, size_t size);
+  void _swap(mapped_file& other) noexcept;
+
+  std::byte* data_ = nullptr;
+  size_t size_ = 0;
+#ifdef _WIN32
+  void* file_ = nullptr;
+  void* mapping_ = nullptr;
+#else
+  int fd_ = -1;
+#endif
+};
+
+}  // namespace golv
@@ -0,0 +1,387 @@
+#include <golv/util/simd.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define GOLV_SIMD_AVX2 1
+#define GOLV_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define GOLV_SIMD_AVX2 1
+#define GOLV_TARGET_AVX2
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace golv::simd {
+
+namespace {
+
+void _uniform(double* out, size_t n) { std::fill(out, out + n, 1.0 / static_cast<double>(n)); }
+
+void _scale(double const* in, double* out, size_t n, double factor) {
+  for (size_t i = 0; i < n; ++i) out[i] = in[i] * factor;
+}
+
+void regret_matching_scalar(double const* regrets, double* out, size_t n, double threshold) {
+  double sum = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = std::max(regrets[i], 0.0);
+    sum += out[i];
+  }
+  if (sum > threshold)
+    _scale(out, out, n, 1.0 / sum);
+  else
+    _uniform(out, n);
+}
+
+void normalize_scalar(double const* sums, double* out, size_t n, double threshold) {
+  double sum = 0.0;
+  for (size_t i = 0; i < n; ++i) sum += sums[i];
+  if (sum > threshold)
+    _scale(sums, out, n, 1.0 / sum);
+  else
+    _uniform(out, n);
+}
+
+void accumulate_regrets_scalar(double* regret_sum, double const* util, double node_util, size_t n) {
+  for (size_t i = 0; i < n; ++i) regret_sum[i] += util[i] - node_util;
+}
+
+void accumulate_strategy_scalar(double* strategy_sum, double const* strategy, double weight, size_t n) {
+  for (size_t i = 0; i < n; ++i) strategy_sum[i] += weight * strategy[i];
+}
+
+// the transposed kernels work on blocks of information sets, such that the inner loops run over consecutive values
+constexpr size_t soa_block = 8;
+
+void regret_matching_soa_scalar(double const* regrets, double* out, size_t n, size_t count, size_t stride,
+                                double threshold) {
+  double const uniform = 1.0 / static_cast<double>(n);
+  for (size_t i = 0; i < count; i += soa_block) {
+    auto const width = std::min(soa_block, count - i);
+    std::array<double, soa_block> sum{};
+    for (size_t a = 0; a < n; ++a) {
+      for (size_t l = 0; l < width; ++l) {
+        out[a * stride + i + l] = std::max(regrets[a * stride + i + l], 0.0);
+        sum[l] += out[a * stride + i + l];
+      }
+    }
+    std::array<double, soa_block> factor;
+    for (size_t l = 0; l < width; ++l) factor[l] = 1.0 / sum[l];
+    for (size_t a = 0; a < n; ++a) {
+      for (size_t l = 0; l < width; ++l) {
+        auto& o = out[a * stride + i + l];
+        o = sum[l] > threshold ? o * factor[l] : uniform;
+      }
+    }
+  }
+}
+
+void normalize_soa_scalar(double const* sums, double* out, size_t n, size_t count, size_t stride, double threshold) {
+  double const uniform = 1.0 / static_cast<double>(n);
+  for (size_t i = 0; i < count; i += soa_block) {
+    auto const width = std::min(soa_block, count - i);
+    std::array<double, soa_block> sum{};
+    for (size_t a = 0; a < n; ++a) {
+      for (size_t l = 0; l < width; ++l) sum[l] += sums[a * stride + i + l];
+    }
+    std::array<double, soa_block> factor;
+    for (size_t l = 0; l < width; ++l) factor[l] = 1.0 / sum[l];
+    for (size_t a = 0; a < n; ++a) {
+      for (size_t l = 0; l < width; ++l) {
+        out[a * stride + i + l] = sum[l] > threshold ? sums[a * stride + i + l] * factor[l] : uniform;
+      }
+    }
+  }
+}
+
+void accumulate_regrets_soa_scalar(double* regret_sum, double const* util, double const* node_util, size_t n,
+                                   size_t count, size_t stride) {
+  for (size_t a = 0; a < n; ++a) {
+    for (size_t i = 0; i < count; ++i) regret_sum[a * stride + i] += util[a * stride + i] - node_util[i];
+  }
+}
+
+void accumulate_strategy_soa_scalar(double* strategy_sum, double const* strategy, double const* weight, size_t n,
+                                    size_t count, size_t stride) {
+  for (size_t a = 0; a < n; ++a) {
+    for (size_t i = 0; i < count; ++i) strategy_sum[a * stride + i] += weight[i] * strategy[a * stride + i];
+  }
+}
+
+#ifdef GOLV_SIMD_AVX2
+
+GOLV_TARGET_AVX2 double _hsum(__m256d v) {
+  __m128d lo = _mm256_castpd256_pd128(v);
+  __m128d hi = _mm256_extractf128_pd(v, 1);
+  lo = _mm_add_pd(lo, hi);
+  return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+GOLV_TARGET_AVX2 void _scale_avx2(double const* in, double* out, size_t n, double factor) {
+  __m256d f = _mm256_set1_pd(factor);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(in + i), f));
+  for (; i < n; ++i) out[i] = in[i] * factor;
+}
+
+GOLV_TARGET_AVX2 void regret_matching_avx2(double const* regrets, double* out, size_t n, double threshold) {
+  __m256d zero = _mm256_setzero_pd();
+  __m256d acc = zero;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d v = _mm256_max_pd(_mm256_loadu_pd(regrets + i), zero);
+    _mm256_storeu_pd(out + i, v);
+    acc = _mm256_add_pd(acc, v);
+  }
+  double sum = _hsum(acc);
+  for (; i < n; ++i) {
+    out[i] = std::max(regrets[i], 0.0);
+    sum += out[i];
+  }
+  if (sum > threshold)
+    _scale_avx2(out, out, n, 1.0 / sum);
+  else
+    _uniform(out, n);
+}
+
+GOLV_TARGET_AVX2 void normalize_avx2(double const* sums, double* out, size_t n, double threshold) {
+  __m256d acc = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) acc = _mm256_add_pd(acc, _mm256_loadu_pd(sums + i));
+  double sum = _hsum(acc);
+  for (; i < n; ++i) sum += sums[i];
+  if (sum > threshold)
+    _scale_avx2(sums, out, n, 1.0 / sum);
+  else
+    _uniform(out, n);
+}
+
+GOLV_TARGET_AVX2 void accumulate_regrets_avx2(double* regret_sum, double const* util, double node_util, size_t n) {
+  __m256d u = _mm256_set1_pd(node_util);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d r = _mm256_loadu_pd(regret_sum + i);
+    _mm256_storeu_pd(regret_sum + i, _mm256_add_pd(r, _mm256_sub_pd(_mm256_loadu_pd(util + i), u)));
+  }
+  for (; i < n; ++i) regret_sum[i] += util[i] - node_util;
+}
+
+GOLV_TARGET_AVX2 void accumulate_strategy_avx2(double* strategy_sum, double const* strategy, double weight,
+                                               size_t n) {
+  __m256d w = _mm256_set1_pd(weight);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d s = _mm256_loadu_pd(strategy_sum + i);
+    _mm256_storeu_pd(strategy_sum + i, _mm256_add_pd(s, _mm256_mul_pd(w, _mm256_loadu_pd(strategy + i))));
+  }
+  for (; i < n; ++i) strategy_sum[i] += weight * strategy[i];
+}
+
+// the transposed kernels handle the last (count % 4) information sets with masked loads and stores, such that e. g.
+// the three information sets of a leduc node still take a single vector
+GOLV_TARGET_AVX2 __m256i _lanes(size_t count) {
+  return _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(count)), _mm256_set_epi64x(3, 2, 1, 0));
+}
+
+GOLV_TARGET_AVX2 void _regret_matching_soa_avx2(double const* regrets, double* out, size_t n, size_t stride,
+                                               __m256i lanes, __m256d limit) {
+  __m256d const zero = _mm256_setzero_pd();
+  __m256d sum = zero;
+  for (size_t a = 0; a < n; ++a) {
+    __m256d v = _mm256_max_pd(_mm256_maskload_pd(regrets + a * stride, lanes), zero);
+    _mm256_maskstore_pd(out + a * stride, lanes, v);
+    sum = _mm256_add_pd(sum, v);
+  }
+  __m256d const positive = _mm256_cmp_pd(sum, limit, _CMP_GT_OQ);
+  __m256d const factor = _mm256_div_pd(_mm256_set1_pd(1.0), sum);
+  __m256d const uniform = _mm256_set1_pd(1.0 / static_cast<double>(n));
+  for (size_t a = 0; a < n; ++a) {
+    __m256d v = _mm256_mul_pd(_mm256_maskload_pd(out + a * stride, lanes), factor);
+    _mm256_maskstore_pd(out + a * stride, lanes, _mm256_blendv_pd(uniform, v, positive));
+  }
+}
+
+GOLV_TARGET_AVX2 void regret_matching_soa_avx2(double const* regrets, double* out, size_t n, size_t count,
+                                              size_t stride, double threshold) {
+  __m256d const limit = _mm256_set1_pd(threshold);
+  __m256i const all = _mm256_set1_epi64x(-1);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) _regret_matching_soa_avx2(regrets + i, out + i, n, stride, all, limit);
+  if (i < count) _regret_matching_soa_avx2(regrets + i, out + i, n, stride, _lanes(count - i), limit);
+}
+
+GOLV_TARGET_AVX2 void _normalize_soa_avx2(double const* sums, double* out, size_t n, size_t stride, __m256i lanes,
+                                         __m256d limit) {
+  __m256d sum = _mm256_setzero_pd();
+  for (size_t a = 0; a < n; ++a) sum = _mm256_add_pd(sum, _mm256_maskload_pd(sums + a * stride, lanes));
+  __m256d const positive = _mm256_cmp_pd(sum, limit, _CMP_GT_OQ);
+  __m256d const factor = _mm256_div_pd(_mm256_set1_pd(1.0), sum);
+  __m256d const uniform = _mm256_set1_pd(1.0 / static_cast<double>(n));
+  for (size_t a = 0; a < n; ++a) {
+    __m256d v = _mm256_mul_pd(_mm256_maskload_pd(sums + a * stride, lanes), factor);
+    _mm256_maskstore_pd(out + a * stride, lanes, _mm256_blendv_pd(uniform, v, positive));
+  }
+}
+
+GOLV_TARGET_AVX2 void normalize_soa_avx2(double const* sums, double* out, size_t n, size_t count, size_t stride,
+                                         double threshold) {
+  __m256d const limit = _mm256_set1_pd(threshold);
+  __m256i const all = _mm256_set1_epi64x(-1);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) _normalize_soa_avx2(sums + i, out + i, n, stride, all, limit);
+  if (i < count) _normalize_soa_avx2(sums + i, out + i, n, stride, _lanes(count - i), limit);
+}
+
+GOLV_TARGET_AVX2 void accumulate_regrets_soa_avx2(double* regret_sum, double const* util, double const* node_util,
+                                                  size_t n, size_t count, size_t stride) {
+  size_t const full = count - count % 4;
+  __m256i const tail = _lanes(count - full);
+  for (size_t a = 0; a < n; ++a) {
+    auto* r = regret_sum + a * stride;
+    auto const* u = util + a * stride;
+    for (size_t i = 0; i < full; i += 4) {
+      __m256d d = _mm256_sub_pd(_mm256_loadu_pd(u + i), _mm256_loadu_pd(node_util + i));
+      _mm256_storeu_pd(r + i, _mm256_add_pd(_mm256_loadu_pd(r + i), d));
+    }
+    if (full < count) {
+      __m256d d = _mm256_sub_pd(_mm256_maskload_pd(u + full, tail), _mm256_maskload_pd(node_util + full, tail));
+      _mm256_maskstore_pd(r + full, tail, _mm256_add_pd(_mm256_maskload_pd(r + full, tail), d));
+    }
+  }
+}
+
+GOLV_TARGET_AVX2 void accumulate_strategy_soa_avx2(double* strategy_sum, double const* strategy, double const* weight,
+                                                   size_t n, size_t count, size_t stride) {
+  size_t const full = count - count % 4;
+  __m256i const tail = _lanes(count - full);
+  for (size_t a = 0; a < n; ++a) {
+    auto* s = strategy_sum + a * stride;
+    auto const* p = strategy + a * stride;
+    for (size_t i = 0; i < full; i += 4) {
+      __m256d w = _mm256_mul_pd(_mm256_loadu_pd(weight + i), _mm256_loadu_pd(p + i));
+      _mm256_storeu_pd(s + i, _mm256_add_pd(_mm256_loadu_pd(s + i), w));
+    }
+    if (full < count) {
+      __m256d w = _mm256_mul_pd(_mm256_maskload_pd(weight + full, tail), _mm256_maskload_pd(p + full, tail));
+      _mm256_maskstore_pd(s + full, tail, _mm256_add_pd(_mm256_maskload_pd(s + full, tail), w));
+    }
+  }
+}
+
+bool _cpu_has_avx2() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) return false;
+  __cpuid(info, 1);
+  bool const osxsave = (info[2] & (1 << 27)) != 0;
+  bool const avx = (info[2] & (1 << 28)) != 0;
+  if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+struct kernel_table {
+  instruction_set is;
+  void (*regret_matching)(double const*, double*, size_t, double);
+  void (*normalize)(double const*, double*, size_t, double);
+  void (*accumulate_regrets)(double*, double const*, double, size_t);
+  void (*accumulate_strategy)(double*, double const*, double, size_t);
+  void (*regret_matching_soa)(double const*, double*, size_t, size_t, size_t, double);
+  void (*normalize_soa)(double const*, double*, size_t, size_t, size_t, double);
+  void (*accumulate_regrets_soa)(double*, double const*, double const*, size_t, size_t, size_t);
+  void (*accumulate_strategy_soa)(double*, double const*, double const*, size_t, size_t, size_t);
+};
+
+constexpr kernel_table scalar_kernels{instruction_set::scalar,        regret_matching_scalar,
+                                      normalize_scalar,               accumulate_regrets_scalar,
+                                      accumulate_strategy_scalar,     regret_matching_soa_scalar,
+                                      normalize_soa_scalar,           accumulate_regrets_soa_scalar,
+                                      accumulate_strategy_soa_scalar};
+
+#ifdef GOLV_SIMD_AVX2
+constexpr kernel_table avx2_kernels{instruction_set::avx2,        regret_matching_avx2,
+                                    normalize_avx2,               accumulate_regrets_avx2,
+                                    accumulate_strategy_avx2,     regret_matching_soa_avx2,
+                                    normalize_soa_avx2,           accumulate_regrets_soa_avx2,
+                                    accumulate_strategy_soa_avx2};
+#endif
+
+kernel_table const* _select(instruction_set is) {
+#ifdef GOLV_SIMD_AVX2
+  if (is == instruction_set::avx2 && _cpu_has_avx2()) return &avx2_kernels;
+#endif
+  return is == instruction_set::scalar ? &scalar_kernels : nullptr;
+}
+
+// set_instruction_set() may run while other threads call the kernels, either table is valid for them
+std::atomic<kernel_table const*>& _kernel_table() {
+  static std::atomic<kernel_table const*> kernels{_select(best_instruction_set())};
+  return kernels;
+}
+
+kernel_table const* _kernels() { return _kernel_table().load(std::memory_order_relaxed); }
+
+}  // namespace
+
+instruction_set best_instruction_set() {
+#ifdef GOLV_SIMD_AVX2
+  static bool const has_avx2 = _cpu_has_avx2();
+  if (has_avx2) return instruction_set::avx2;
+#endif
+  return instruction_set::scalar;
+}
+
+instruction_set current_instruction_set() { return _kernels()->is; }
+
+bool set_instruction_set(instruction_set is) {
+  auto const* kernels = _select(is);
+  if (kernels == nullptr) return false;
+  _kernel_table().store(kernels, std::memory_order_relaxed);
+  return true;
+}
+
+void regret_matching(double const* regrets, double* out, size_t n, double threshold) {
+  _kernels()->regret_matching(regrets, out, n, threshold);
+}
+
+void normalize(double const* sums, double* out, size_t n, double threshold) {
+  _kernels()->normalize(sums, out, n, threshold);
+}
+
+void accumulate_regrets(double* regret_sum, double const* util, double node_util, size_t n) {
+  _kernels()->accumulate_regrets(regret_sum, util, node_util, n);
+}
+
+void accumulate_strategy(double* strategy_sum, double const* strategy, double weight, size_t n) {
+  _kernels()->accumulate_strategy(strategy_sum, strategy, weight, n);
+}
+
+void regret_matching_soa(double const* regrets, double* out, size_t n, size_t count, size_t stride, double threshold) {
+  _kernels()->regret_matching_soa(regrets, out, n, count, stride, threshold);
+}
+
+void normalize_soa(double const* sums, double* out, size_t n, size_t count, size_t stride, double threshold) {
+  _kernels()->normalize_soa(sums, out, n, count, stride, threshold);
+}
+
+void accumulate_regrets_soa(double* regret_sum, double const* util, double const* node_util, size_t n, size_t count,
+                            size_t stride) {
+  _kernels()->accumulate_regrets_soa(regret_sum, util, node_util, n, count, stride);
+}
+
+void accumulate_strategy_soa(double* strategy_sum, double const* strategy, double const* weight, size_t n,
+                             size_t count, size_t stride) {
+  _kernels()->accumulate_strategy_soa(strategy_sum, strategy, weight, n, count, stride);
+}
+
+}  // namespace golv::simd
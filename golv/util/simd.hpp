@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+
+namespace golv::simd {
+
+/**
+ * Instruction sets of the kernels. The best supported one is selected at runtime,
+ * set_instruction_set() allows to force the scalar fallback (e. g. for benchmarks).
+ */
+enum class instruction_set
+{
+  scalar,
+  avx2
+};
+
+instruction_set best_instruction_set();
+instruction_set current_instruction_set();
+
+/**
+ * Select the kernels. Returns false (and keeps the current selection) if the CPU does not support it.
+ * Thread-safe: concurrent calls of the kernels use either the previous or the new selection.
+ */
+bool set_instruction_set(instruction_set is);
+
+/**
+ * Regret matching: out[i] = max(regrets[i], 0) / sum, or 1/n if the sum of the positive parts
+ * is not larger than threshold.
+ */
+void regret_matching(double const* regrets, double* out, size_t n, double threshold);
+
+/**
+ * out[i] = sums[i] / sum, or 1/n if the sum is not larger than threshold (average strategy).
+ */
+void normalize(double const* sums, double* out, size_t n, double threshold);
+
+/**
+ * regret_sum[i] += util[i] - node_util
+ */
+void accumulate_regrets(double* regret_sum, double const* util, double node_util, size_t n);
+
+/**
+ * strategy_sum[i] += weight * strategy[i]
+ */
+void accumulate_strategy(double* strategy_sum, double const* strategy, double weight, size_t n);
+
+/**
+ * Batched versions for count information sets with n actions each, stored transposed (structure of arrays): the
+ * value of action a of information set i is at [a * stride + i], with stride >= count. The vector lanes span the
+ * information sets, such that the few actions of e. g. leduc (2 or 3) still fill them.
+ */
+void regret_matching_soa(double const* regrets, double* out, size_t n, size_t count, size_t stride, double threshold);
+void normalize_soa(double const* sums, double* out, size_t n, size_t count, size_t stride, double threshold);
+
+/**
+ * regret_sum[a * stride + i] += util[a * stride + i] - node_util[i]
+ */
+void accumulate_regrets_soa(double* regret_sum, double const* util, double const* node_util, size_t n, size_t count,
+                            size_t stride);
+
+/**
+ * strategy_sum[a * stride + i] += weight[i] * strategy[a * stride + i]
+ */
+void accumulate_strategy_soa(double* strategy_sum, double const* strategy, double const* weight, size_t n,
+                             size_t count, size_t stride);
+
+}  // namespace golv::simd
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <golv/util/exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+
+namespace golv {
+
+/**
+ * static_vector is a vector with a fixed capacity N stored inline, i. e. without heap allocation.
+ * It is the move_range of the card and board games, such that legal_actions() and the sorting
+ * for move ordering do not allocate. Exceeding the capacity throws a golv::exception.
+ * T must be default constructible (all N elements are constructed).
+ */
+template <class T, size_t N>
+class static_vector {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = T const&;
+  using pointer = T*;
+  using const_pointer = T const*;
+  using iterator = T*;
+  using const_iterator = T const*;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  constexpr static_vector() = default;
+
+  template <std::input_iterator InputIt>
+  constexpr static_vector(InputIt first, InputIt last) {
+    if constexpr (std::random_access_iterator<InputIt>) {
+      _check(static_cast<size_t>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) push_back(*first);
+  }
+
+  constexpr static_vector(std::initializer_list<T> init) : static_vector(init.begin(), init.end()) {}
+
+  constexpr static size_type capacity() { return N; }
+  constexpr static size_type max_size() { return N; }
+  constexpr size_type size() const { return _size(); }
+  constexpr bool empty() const { return size_ == 0; }
+
+  constexpr iterator begin() { return data_; }
+  constexpr iterator end() { return data_ + _size(); }
+  constexpr const_iterator begin() const { return data_; }
+  constexpr const_iterator end() const { return data_ + _size(); }
+  constexpr const_iterator cbegin() const { return begin(); }
+  constexpr const_iterator cend() const { return end(); }
+  constexpr reverse_iterator rbegin() { return reverse_iterator(end()); }
+  constexpr reverse_iterator rend() { return reverse_iterator(begin()); }
+  constexpr const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  constexpr const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+  constexpr pointer data() { return data_; }
+  constexpr const_pointer data() const { return data_; }
+
+  constexpr reference operator[](size_type i) { return data_[i]; }
+  constexpr const_reference operator[](size_type i) const { return data_[i]; }
+  constexpr reference front() { return data_[0]; }
+  constexpr const_reference front() const { return data_[0]; }
+  constexpr reference back() { return data_[size_ - 1]; }
+  constexpr const_reference back() const { return data_[size_ - 1]; }
+
+  constexpr void push_back(T const& value) {
+    _check(size_ + 1);
+    data_[size_++] = value;
+  }
+
+  template <class... ArgsT>
+  constexpr reference emplace_back(ArgsT&&... args) {
+    _check(size_ + 1);
+    data_[size_] = T(std::forward<ArgsT>(args)...);
+    return data_[size_++];
+  }
+
+  constexpr void pop_back() { --size_; }
+  constexpr void clear() { size_ = 0; }
+
+  constexpr iterator erase(const_iterator pos) {
+    auto it = begin() + (pos - cbegin());
+    std::move(it + 1, end(), it);
+    --size_;
+    return it;
+  }
+
+  friend constexpr bool operator==(static_vector const& l, static_vector const& r) {
+    return std::equal(l.begin(), l.end(), r.begin(), r.end());
+  }
+
+ private:
+  // tells the optimizer that size_ <= N (otherwise e. g. std::sort triggers -Warray-bounds for small N)
+  constexpr size_type _size() const {
+#if defined(__GNUC__)
+    if (size_ > N) __builtin_unreachable();
+#endif
+    return size_;
+  }
+
+  constexpr static void _check(size_t size) {
+    if (size > N) throw golv::exception("static_vector: capacity exceeded");
+  }
+
+  // the smallest type for the count keeps e. g. the moves of a card game in one cache line
+  using count_type = std::conditional_t<(N <= UINT8_MAX), std::uint8_t,
+                                        std::conditional_t<(N <= UINT16_MAX), std::uint16_t, size_type>>;
+
+  T data_[N]{};
+  count_type size_ = 0;
+};
+
+template <class T, size_t N>
+std::ostream& operator<<(std::ostream& os, static_vector<T, N> const& v) {
+  for (auto const& x : v) os << x << " ";
+  return os;
+}
+
+}  // namespace golv
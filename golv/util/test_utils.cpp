@@ -1,8 +1,15 @@
 #include <algorithm>
 #include <cassert>
+#include <filesystem>
 #include <golv/util/test_utils.hpp>
 #include <random>
 
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
 using namespace golv;
 
 golv::bridge create_game() {
@@ -18,41 +25,96 @@ golv::bridge create_game() {
 }
 
 golv::bridge create_random_game(size_t cards_per_player, int rotate, unsigned seed) {
-  bridge game;
-  std::array<hand, 4> cards;
   auto _deck = golv::create_bridge_deck();
   std::random_device rd;
   std::mt19937 g(rd());
   if (seed != 0) g.seed(seed);
   std::shuffle(_deck.begin(), _deck.end(), g);
+  return deal_bridge_game(_deck, cards_per_player, rotate);
+}
+
+golv::skat create_random_skat_game(size_t cards_per_player, int rotate, unsigned seed) {
+  auto _deck = golv::create_skat_deck();
+  std::random_device rd;
+  std::mt19937 g(rd());
+  if (seed != 0) g.seed(seed);
+  std::shuffle(_deck.begin(), _deck.end(), g);
+  return deal_skat_game(_deck, cards_per_player, rotate);
+}
+
+golv::hand shuffle_deck(golv::hand deck, std::uint64_t seed) {
+  auto next = [&seed]() {
+    std::uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  };
+  for (size_t i = deck.size(); i > 1; --i) {
+    std::swap(deck[i - 1], deck[next() % i]);
+  }
+  return deck;
+}
+
+golv::bridge::internal_state_type deal_bridge_hands(golv::hand const& deck, size_t cards_per_player, int rotate) {
+  assert(deck.size() >= golv::bridge::num_players * cards_per_player);
+  golv::bridge::internal_state_type cards;
   for (size_t i = 0; i < golv::bridge::num_players; ++i) {
-    std::copy(_deck.begin() + (i * cards_per_player), _deck.begin() + (i + 1) * cards_per_player,
+    std::copy(deck.begin() + (i * cards_per_player), deck.begin() + (i + 1) * cards_per_player,
               std::back_inserter(cards[i]));
     std::sort(cards[i].begin(), cards[i].end(), bridge_card_order{});
   }
   std::rotate(cards.begin(), cards.begin() + rotate, cards.end());
-  game.deal(cards);
+  return cards;
+}
+
+golv::bridge deal_bridge_game(golv::hand const& deck, size_t cards_per_player, int rotate) {
+  bridge game;
+  game.deal(deal_bridge_hands(deck, cards_per_player, rotate));
   return game;
 }
 
-golv::skat create_random_skat_game(size_t cards_per_player, int rotate, unsigned seed) {
+golv::skat deal_skat_game(golv::hand const& deck, size_t cards_per_player, int rotate) {
+  assert(deck.size() >= golv::skat::num_players * cards_per_player + 2);
   golv::skat game;
   std::array<hand, golv::skat::num_players + 1> cards;
-  auto _deck = golv::create_skat_deck();
-  std::random_device rd;
-  std::mt19937 g(rd());
-  if (seed != 0) g.seed(seed);
-  std::shuffle(_deck.begin(), _deck.end(), g);
   for (size_t i = 0; i < golv::skat::num_players; ++i) {
-    std::copy(_deck.begin() + (i * cards_per_player), _deck.begin() + (i + 1) * cards_per_player,
+    std::copy(deck.begin() + (i * cards_per_player), deck.begin() + (i + 1) * cards_per_player,
               std::back_inserter(cards[i]));
     std::sort(cards[i].begin(), cards[i].end(), golv::skat_card_order{});
   }
   auto N = golv::skat::num_players * cards_per_player;
-  cards[golv::skat::num_players] = {_deck[N], _deck[N + 1]};
+  cards[golv::skat::num_players] = {deck[N], deck[N + 1]};
   std::rotate(cards.begin(), cards.begin() + rotate, cards.begin() + skat::num_players);
   game.deal(cards[0], cards[1], cards[2], cards[3]);
   game.set_soloist(0);
   game.skip_pushing();
   return game;
-}
\ No newline at end of file
+}
+
+std::vector<golv::bridge> bridge_corpus(size_t cards_per_player, size_t count, std::uint64_t first_seed) {
+  std::vector<golv::bridge> corpus;
+  corpus.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    corpus.push_back(deal_bridge_game(shuffle_deck(golv::create_bridge_deck(), first_seed + i), cards_per_player));
+  }
+  return corpus;
+}
+
+std::vector<golv::skat> skat_corpus(size_t cards_per_player, size_t count, std::uint64_t first_seed) {
+  std::vector<golv::skat> corpus;
+  corpus.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    corpus.push_back(deal_skat_game(shuffle_deck(golv::create_skat_deck(), first_seed + i), cards_per_player));
+  }
+  return corpus;
+}
+
+std::string unique_temp_path(std::string const& name) {
+#ifdef _WIN32
+  auto const pid = _getpid();
+#else
+  auto const pid = getpid();
+#endif
+  auto const file = "golv_" + name + "_" + std::to_string(pid) + ".bin";
+  return (std::filesystem::temp_directory_path() / file).string();
+}
@@ -1,6 +1,37 @@
+#pragma once
+
 #include <golv/games/bridge.hpp>
 #include <golv/games/skat.hpp>
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 golv::bridge create_game();
 golv::bridge create_random_game(size_t cards_per_player, int rotate = 0, unsigned seed = 91189);
-golv::skat create_random_skat_game(size_t cards_per_player = 10, int rotate = 0, unsigned seed = 91189);
\ No newline at end of file
+golv::skat create_random_skat_game(size_t cards_per_player = 10, int rotate = 0, unsigned seed = 91189);
+
+/**
+ * Shuffle with a fixed generator (splitmix64) and Fisher-Yates. Unlike std::shuffle the result
+ * does not depend on the standard library, so seeded deals are the same on every platform.
+ */
+golv::hand shuffle_deck(golv::hand deck, std::uint64_t seed);
+
+/**
+ * Deal the first cards of the deck (cards_per_player to each player, the next two cards into the skat).
+ */
+golv::bridge::internal_state_type deal_bridge_hands(golv::hand const& deck, size_t cards_per_player, int rotate = 0);
+golv::bridge deal_bridge_game(golv::hand const& deck, size_t cards_per_player, int rotate = 0);
+golv::skat deal_skat_game(golv::hand const& deck, size_t cards_per_player, int rotate = 0);
+
+/**
+ * Reproducible deal corpora: the i-th game is dealt from shuffle_deck(deck, first_seed + i).
+ */
+std::vector<golv::bridge> bridge_corpus(size_t cards_per_player, size_t count, std::uint64_t first_seed = 1);
+std::vector<golv::skat> skat_corpus(size_t cards_per_player, size_t count, std::uint64_t first_seed = 1);
+
+/**
+ * A path in the temporary directory that is unique per name and process, such that tests running in
+ * parallel processes (e. g. ctest -j) never share a file.
+ */
+std::string unique_temp_path(std::string const& name);
@@ -1,7 +1,9 @@
 #include <golv/games/cards.hpp>
 #include <golv/util/cyclic_number.hpp>
 #include <golv/games/skat.hpp>
+#include <golv/games/skat_declaration.hpp>
 #include <golv/algorithms/mws.hpp>
+#include <golv/algorithms/packed_mws_table.hpp>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/operators.h>
@@ -16,6 +18,16 @@ std::pair<skat::value_type, skat::move_type> mws_binary_search_skat(skat g)
       g);  // Direkter Aufruf der Template-Spezialisierung für `skat`
 }
 
+/**
+ * Same as mws_binary_search_skat, but reports the counters of the transposition table.
+ */
+std::tuple<skat::value_type, skat::move_type, table_stats> mws_binary_search_stats_skat(skat g, size_t memory_bytes)
+{
+  minimal_window_search mws(g, packed_mws_table<skat, table_counters>(memory_bytes));
+  auto [value, move] = mws_binary_search(mws);
+  return {value, move, mws.table_.stats()};
+}
+
 PYBIND11_MODULE(golv_skat, m)
 {
   m.doc() = "Python bindings for the Skat game implementation in C++";
@@ -45,6 +57,14 @@ PYBIND11_MODULE(golv_skat, m)
       .value("Deuce", kind::deuce)
       .export_values();
 
+  py::enum_<trump>(m, "Trump")
+      .value("Diamonds", trump::diamonds)
+      .value("Hearts", trump::hearts)
+      .value("Spades", trump::spades)
+      .value("Clubs", trump::clubs)
+      .value("Grand", trump::grand)
+      .export_values();
+
   // card Klasse binden
   py::class_<card>(m, "Card")
       .def(py::init<>())              // Standardkonstruktor
@@ -53,8 +73,8 @@ PYBIND11_MODULE(golv_skat, m)
       .def("get_kind", &card::get_kind)
       .def("get_suit", &card::get_suit)
       .def("code", &card::code)
-      .def("__eq__",
-           [](const card &l, const card &r) { return golv::operator==(l, r); })
+      .def("index", &card::index)
+      .def("__eq__", [](const card &l, const card &r) { return l == r; })
       .def("__repr__", [](const card &c) { return golv::to_string(c); });
 
   // Bind the skat_card_order struct
@@ -66,7 +86,8 @@ PYBIND11_MODULE(golv_skat, m)
   // Bind the trick struct
   py::class_<skat::trick>(m, "Trick")
       .def(py::init<>())
-      .def_readwrite("cards_", &skat::trick::cards_)
+      .def_property_readonly("cards_",
+                             [](const skat::trick &t) { return std::vector<card>(t.cards_.begin(), t.cards_.end()); })
       .def_readwrite("leader_", &skat::trick::leader_)
       .def_readwrite("eyes_", &skat::trick::eyes_);
 
@@ -75,11 +96,16 @@ PYBIND11_MODULE(golv_skat, m)
       .def(py::init<>())  // Standardkonstruktor
       .def("hash_me", &skat::hash_me)
       .def("blinds", &skat::blinds)
-      .def("legal_actions", &skat::legal_actions)
+      .def("legal_actions",
+           [](const skat &s) {
+             auto legal = s.legal_actions();
+             return std::vector<card>(legal.begin(), legal.end());
+           })
       .def("value", &skat::value)
       .def("opp_value", &skat::opp_value)
       .def("is_max", &skat::is_max)
       .def("set_soloist", &skat::set_soloist)
+      .def("declare", &skat::declare)
       .def("current_player", &skat::current_player)
       .def("apply_action", &skat::apply_action)
       .def("undo_action", &skat::undo_action)
@@ -92,7 +118,11 @@ PYBIND11_MODULE(golv_skat, m)
                              golv::hand const &, golv::hand const &>(
                &golv::skat::deal),
            "Deal specific hands to the players")
-      .def("tricks", &skat::tricks)
+      .def("tricks",
+           [](const skat &s) {
+             auto const &tricks = s.tricks();
+             return std::vector<skat::trick>(tricks.begin(), tricks.end());
+           })
       .def("__repr__", [](const skat &s) {
         std::ostringstream oss;
         oss << s;
@@ -102,4 +132,37 @@ PYBIND11_MODULE(golv_skat, m)
   // Binding für `mws_binary_search` mit `skat`
   m.def("mws_binary_search", &mws_binary_search_skat,
         "Solves a Skat game using MWS binary search");
+
+  // Counters of the transposition table
+  py::class_<table_stats>(m, "TableStats")
+      .def_readonly("probes", &table_stats::probes)
+      .def_readonly("hits", &table_stats::hits)
+      .def_readonly("exact_cutoffs", &table_stats::exact_cutoffs)
+      .def_readonly("bound_cutoffs", &table_stats::bound_cutoffs)
+      .def_readonly("stores", &table_stats::stores)
+      .def_readonly("overwrites", &table_stats::overwrites)
+      .def_readonly("collisions", &table_stats::collisions)
+      .def_readonly("size", &table_stats::size)
+      .def_readonly("capacity", &table_stats::capacity)
+      .def_readonly("entries_per_depth", &table_stats::entries_per_depth)
+      .def("hit_rate", &table_stats::hit_rate)
+      .def("cutoff_rate", &table_stats::cutoff_rate)
+      .def("fill_ratio", py::overload_cast<>(&table_stats::fill_ratio, py::const_))
+      .def("fill_ratio", py::overload_cast<size_t>(&table_stats::fill_ratio, py::const_))
+      .def("to_json", &table_stats::to_json)
+      .def("__repr__", &table_stats::to_json);
+
+  m.def("mws_binary_search_stats", &mws_binary_search_stats_skat, py::arg("game"),
+        py::arg("memory_bytes") = size_t{16} << 20,
+        "Solves a Skat game using MWS binary search and returns (value, move, TableStats)");
+
+  py::class_<skat_declaration>(m, "SkatDeclaration")
+      .def_readonly("value", &skat_declaration::value)
+      .def_readonly("push", &skat_declaration::push);
+
+  m.def("skat_declaration_table", &skat_declaration_table, py::call_guard<py::gil_scoped_release>(),
+        py::arg("game"), py::arg("threads") = 0,
+        py::arg("memory_bytes") = size_t{16} << 20,
+        "Solves a dealt Skat game (without soloist) for all trumps and soloists, returns "
+        "[trump][soloist] -> SkatDeclaration (value and best pushed cards)");
 }
@@ -0,0 +1,254 @@
+#include <benchmark/benchmark.h>
+
+#include <golv/algorithms/mws_unordered_table.hpp>
+#include <golv/algorithms/packed_mws_table.hpp>
+#include <golv/games/connectfour.hpp>
+#include <golv/games/deal_generator.hpp>
+#include <golv/games/tictactoe.hpp>
+#include <golv/util/logging.hpp>
+#include <golv/util/simd.hpp>
+#include <golv/util/test_utils.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "perf_scope.hpp"
+
+using namespace golv;
+
+/**
+ * Micro benchmarks of the game interface, the transposition tables and the regret matching kernels of cfr.
+ * The bridge and skat positions are the first deal of the seeded corpus with 10 cards per player.
+ */
+namespace {
+
+template <class GameT>
+GameT position() {
+  if constexpr (std::is_same_v<GameT, bridge>) {
+    return bridge_corpus(10, 1).front();
+  } else if constexpr (std::is_same_v<GameT, skat>) {
+    return skat_corpus(10, 1).front();
+  } else {
+    return GameT{};
+  }
+}
+
+template <class GameT>
+void bm_legal_actions(benchmark::State& state) {
+  auto game = position<GameT>();
+  perf_scope perf(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(game.legal_actions());
+  }
+}
+
+template <class GameT>
+void bm_apply_undo(benchmark::State& state) {
+  auto game = position<GameT>();
+  auto const moves = game.legal_actions();
+  perf_scope perf(state);
+  for (auto _ : state) {
+    for (auto const& m : moves) {
+      game.apply_action(m);
+      game.undo_action(m);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * moves.size());
+}
+
+template <class GameT>
+void bm_state(benchmark::State& state) {
+  auto game = position<GameT>();
+  perf_scope perf(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(game.state());
+  }
+}
+
+/**
+ * Keys of the positions reached by playing the first legal move repeatedly from the corpus deals.
+ */
+template <class GameT>
+std::vector<typename GameT::state_type> keys(size_t count) {
+  std::vector<typename GameT::state_type> result;
+  std::vector<GameT> corpus;
+  if constexpr (std::is_same_v<GameT, bridge>) {
+    corpus = bridge_corpus(10, count);
+  } else {
+    corpus = skat_corpus(10, count);
+  }
+  for (auto& game : corpus) {
+    while (!game.is_terminal()) {
+      result.push_back(game.state());
+      game.apply_action(game.legal_actions().front());
+    }
+  }
+  return result;
+}
+
+template <class GameT, class TableT>
+void bm_table_probe(benchmark::State& state) {
+  auto const states = keys<GameT>(64);
+  TableT table = [] {
+    if constexpr (std::is_constructible_v<TableT, size_t>) {
+      return TableT(size_t{1} << 20);
+    } else {
+      return TableT{};
+    }
+  }();
+  // half of the probes hit (the unordered table inserts the others on the first probe)
+  for (size_t i = 0; i < states.size(); i += 2) table.update_lower(states[i], 10);
+  perf_scope perf(state);
+  for (auto _ : state) {
+    for (auto const& s : states) benchmark::DoNotOptimize(table.get(s));
+  }
+  state.SetItemsProcessed(state.iterations() * states.size());
+}
+
+void bm_shuffle_deck(benchmark::State& state) {
+  std::uint64_t seed = 0;
+  perf_scope perf(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(deal_bridge_hands(shuffle_deck(create_bridge_deck(), ++seed), 13));
+  }
+}
+
+/**
+ * Bridge deals without constraints and with 12 to 14 high card points and five hearts for one hand.
+ */
+void bm_deal_generator(benchmark::State& state) {
+  auto spec = deal_spec::bridge();
+  if (state.range(0) == 1) {
+    spec.holders[2].min_points = 12;
+    spec.holders[2].max_points = 14;
+    spec.holders[2].min_length[static_cast<int>(suit::hearts)] = 5;
+  }
+  deal_generator generator(spec);
+  std::mt19937_64 rng(1);
+  perf_scope perf(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(generator.sample(rng));
+  }
+}
+
+/**
+ * Random regrets for the regret matching benchmarks, 2^16 values fit into L2.
+ */
+std::vector<double> const& regrets() {
+  static auto const values = [] {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<> dis(-1.0, 1.0);
+    std::vector<double> v(std::size_t{1} << 16);
+    for (auto& r : v) r = dis(rng);
+    return v;
+  }();
+  return values;
+}
+
+/**
+ * Select the kernels of range 1 (0 scalar, 1 avx2), false (and skipped) if the CPU does not support them.
+ */
+bool select_kernels(benchmark::State& state) {
+  auto const is = state.range(1) == 0 ? simd::instruction_set::scalar : simd::instruction_set::avx2;
+  if (!simd::set_instruction_set(is)) {
+    state.SkipWithError("Instruction set not supported");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Regret matching of information sets with range 0 actions, one call per information set.
+ */
+void bm_regret_matching(benchmark::State& state) {
+  if (!select_kernels(state)) return;
+  auto const n = static_cast<size_t>(state.range(0));
+  auto const& in = regrets();
+  std::vector<double> out(in.size());
+  auto const infosets = in.size() / n;
+  perf_scope perf(state);
+  for (auto _ : state) {
+    for (size_t i = 0; i < infosets; ++i) simd::regret_matching(in.data() + i * n, out.data() + i * n, n, 1e-6);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * infosets);
+  simd::set_instruction_set(simd::best_instruction_set());
+}
+
+/**
+ * Like bm_regret_matching, but with the transposed kernel across groups of range 2 information sets (e. g. the
+ * three deals of a leduc node).
+ */
+void bm_regret_matching_soa(benchmark::State& state) {
+  if (!select_kernels(state)) return;
+  auto const n = static_cast<size_t>(state.range(0));
+  auto const count = static_cast<size_t>(state.range(2));
+  auto const& in = regrets();
+  std::vector<double> out(in.size());
+  auto const groups = in.size() / (n * count);
+  perf_scope perf(state);
+  for (auto _ : state) {
+    for (size_t g = 0; g < groups; ++g) {
+      auto const offset = g * n * count;
+      simd::regret_matching_soa(in.data() + offset, out.data() + offset, n, count, count, 1e-6);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * groups * count);
+  simd::set_instruction_set(simd::best_instruction_set());
+}
+
+}  // namespace
+
+BENCHMARK(bm_legal_actions<tictactoe>)->Name("legal_actions/tictactoe");
+BENCHMARK(bm_legal_actions<connectfour>)->Name("legal_actions/connectfour");
+BENCHMARK(bm_legal_actions<bridge>)->Name("legal_actions/bridge");
+BENCHMARK(bm_legal_actions<skat>)->Name("legal_actions/skat");
+
+BENCHMARK(bm_apply_undo<tictactoe>)->Name("apply_undo/tictactoe");
+BENCHMARK(bm_apply_undo<connectfour>)->Name("apply_undo/connectfour");
+BENCHMARK(bm_apply_undo<bridge>)->Name("apply_undo/bridge");
+BENCHMARK(bm_apply_undo<skat>)->Name("apply_undo/skat");
+
+BENCHMARK(bm_state<tictactoe>)->Name("state/tictactoe");
+BENCHMARK(bm_state<connectfour>)->Name("state/connectfour");
+BENCHMARK(bm_state<bridge>)->Name("state/bridge");
+BENCHMARK(bm_state<skat>)->Name("state/skat");
+
+BENCHMARK(bm_table_probe<bridge, mws_unordered_table<bridge>>)->Name("table_probe/unordered/bridge");
+BENCHMARK(bm_table_probe<bridge, packed_mws_table<bridge>>)->Name("table_probe/packed/bridge");
+BENCHMARK(bm_table_probe<skat, mws_unordered_table<skat>>)->Name("table_probe/unordered/skat");
+BENCHMARK(bm_table_probe<skat, packed_mws_table<skat>>)->Name("table_probe/packed/skat");
+
+BENCHMARK(bm_shuffle_deck)->Name("shuffle_deck/bridge");
+BENCHMARK(bm_deal_generator)->Name("deal_generator/bridge")->Arg(0)->Arg(1);
+
+BENCHMARK(bm_regret_matching)
+    ->Name("regret_matching")
+    ->ArgsProduct({benchmark::CreateDenseRange(2, 16, 1), {0, 1}})
+    ->ArgNames({"actions", "avx2"});
+BENCHMARK(bm_regret_matching_soa)
+    ->Name("regret_matching_soa")
+    ->ArgsProduct({benchmark::CreateDenseRange(2, 16, 1), {0, 1}, {3, 64}})
+    ->ArgNames({"actions", "avx2", "group"});
+
+/**
+ * Additional flag --perf_counters (or GOLV_PERF_COUNTERS=1): report hardware performance counters.
+ */
+int main(int argc, char** argv) {
+  golv::set_log_level(golv::log_level::error);
+  auto const* env = std::getenv("GOLV_PERF_COUNTERS");
+  perf_scope::enabled() = env != nullptr && std::string(env) == "1";
+  auto end = std::remove_if(argv + 1, argv + argc, [](char const* arg) { return std::string(arg) == "--perf_counters"; });
+  if (end != argv + argc) perf_scope::enabled() = true;
+  argc = static_cast<int>(end - argv);
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
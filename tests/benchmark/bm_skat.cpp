@@ -1,6 +1,8 @@
 #include <chrono>
 #include <golv/algorithms/alphabeta.hpp>
 #include <golv/algorithms/mtd_f.hpp>
+#include <golv/algorithms/mws.hpp>
+#include <golv/algorithms/packed_mws_table.hpp>
 #include <golv/util/test_utils.hpp>
 #include <iomanip>
 #include <iostream>
@@ -30,6 +32,41 @@ auto test_mtd_f(skat const& g) {
   return duration;
 }
 
+/**
+ * Bytes per entry of an unordered_map node: key, value, next pointer and cached hash plus the bucket pointer.
+ */
+template <class TableT>
+double unordered_bytes_per_entry(TableT const& table) {
+  using node_type = std::pair<typename TableT::map_type::key_type, typename TableT::map_type::mapped_type>;
+  constexpr size_t node_bytes = sizeof(node_type) + 2 * sizeof(void*);
+  auto const& map = table.map_;
+  if (map.empty()) return 0.0;
+  return static_cast<double>(map.size() * node_bytes + map.bucket_count() * sizeof(void*)) / map.size();
+}
+
+void compare_tables(skat const& g) {
+  minimal_window_search unordered(g, mws_unordered_table<skat, table_counters>{});
+  Timer t;
+  auto [value, bm] = mws_binary_search(unordered);
+  auto dur_unordered = t.stop() / 1000.0;
+
+  minimal_window_search packed(g, packed_mws_table<skat, table_counters>(size_t{16} << 20), no_ordering{},
+                               search_stats{});
+  Timer t2;
+  auto [packed_value, packed_bm] = mws_binary_search(packed);
+  auto dur_packed = t2.stop() / 1000.0;
+
+  auto const& table = packed.table_;
+  std::cout << "unordered: " << dur_unordered << " ms  " << unordered.table_.map_.size() << " entries  "
+            << unordered_bytes_per_entry(unordered.table_) << " bytes/entry" << std::endl;
+  std::cout << "packed:    " << dur_packed << " ms  " << table.size() << " entries  " << table.bytes_per_entry()
+            << " bytes/entry  hit rate " << table.stats().hit_rate() << "  overwrites " << table.stats().overwrites
+            << (packed_value == value ? "" : "  VALUE MISMATCH") << std::endl;
+  std::cout << "unordered stats: " << unordered.table_.stats() << std::endl;
+  std::cout << "packed stats:    " << table.stats() << std::endl;
+  std::cout << "search stats:    " << packed.stats() << std::endl;
+}
+
 int main() {
   int max_n = 10;
   golv::set_log_level(golv::log_level::error);
@@ -48,5 +85,8 @@ int main() {
     std::cout << n << " = " << dur_mtd << std::endl;
   }
 
+  std::cout << "mws_binary_search tables (10 cards):" << std::endl;
+  compare_tables(create_random_skat_game(10));
+
   return 0;
 }
\ No newline at end of file
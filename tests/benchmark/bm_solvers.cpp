@@ -0,0 +1,346 @@
+#include <benchmark/benchmark.h>
+
+#include <golv/algorithms/alphabeta.hpp>
+#include <golv/algorithms/cfr.hpp>
+#include <golv/algorithms/mtd_f.hpp>
+#include <golv/algorithms/mws.hpp>
+#include <golv/algorithms/negamax.hpp>
+#include <golv/algorithms/packed_mws_table.hpp>
+#include <golv/algorithms/retrograde.hpp>
+#include <golv/games/connectfour.hpp>
+#include <golv/games/double_dummy.hpp>
+#include <golv/games/kuhn.hpp>
+#include <golv/games/leduc.hpp>
+#include <golv/games/tictactoe.hpp>
+#include <golv/util/test_utils.hpp>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "perf_scope.hpp"
+
+using namespace golv;
+
+/**
+ * Solver benchmarks: every solver on every game and size, each iteration solves a whole corpus of
+ * seeded deals (see bridge_corpus() and skat_corpus()), so results are comparable between runs.
+ * The node count is taken in a separate (untimed) run with search_stats.
+ */
+namespace {
+
+constexpr size_t corpus_size = 4;
+
+template <class GameT>
+std::vector<GameT> const& corpus(size_t cards_per_player) {
+  static std::map<size_t, std::vector<GameT>> corpora;
+  auto it = corpora.find(cards_per_player);
+  if (it == corpora.end()) {
+    if constexpr (std::is_same_v<GameT, bridge>) {
+      it = corpora.emplace(cards_per_player, bridge_corpus(cards_per_player, corpus_size)).first;
+    } else {
+      it = corpora.emplace(cards_per_player, skat_corpus(cards_per_player, corpus_size)).first;
+    }
+  }
+  return it->second;
+}
+
+/**
+ * Upper end of the value range (tricks of the declarer in bridge, card points in skat).
+ */
+template <class GameT>
+typename GameT::value_type max_value(size_t cards_per_player) {
+  if constexpr (std::is_same_v<GameT, bridge>) {
+    return static_cast<typename GameT::value_type>(cards_per_player + 1);
+  } else {
+    return 120;
+  }
+}
+
+void set_counters(benchmark::State& state, size_t games, std::uint64_t nodes) {
+  state.counters["games"] = benchmark::Counter(games, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["nodes"] = static_cast<double>(nodes);
+  state.counters["nodes_per_second"] = benchmark::Counter(nodes, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+template <class GameT>
+void bm_alphabeta(benchmark::State& state) {
+  auto const& games = corpus<GameT>(state.range(0));
+  std::uint64_t nodes = 0;
+  for (auto const& g : games) {
+    alpha_beta ab(g, no_ordering{}, no_table<GameT>{}, search_stats{});
+    ab.solve();
+    nodes += ab.stats().nodes();
+  }
+  perf_scope perf(state);
+  for (auto _ : state) {
+    for (auto const& g : games) benchmark::DoNotOptimize(alphabeta(g));
+  }
+  set_counters(state, games.size(), nodes);
+}
+
+template <class GameT>
+void bm_alphabeta_with_memory(benchmark::State& state) {
+  auto const& games = corpus<GameT>(state.range(0));
+  std::uint64_t nodes = 0;
+  for (auto const& g : games) {
+    alpha_beta ab(g, std::less<typename GameT::move_type>{}, unordered_table<GameT>{}, search_stats{});
+    ab.solve();
+    nodes += ab.stats().nodes();
+  }
+  perf_scope perf(state);
+  for (auto _ : state) {
+    for (auto const& g : games) benchmark::DoNotOptimize(alphabeta_with_memory(g));
+  }
+  set_counters(state, games.size(), nodes);
+}
+
+template <class GameT>
+void bm_negamax_with_memory(benchmark::State& state) {
+  auto const& games = corpus<GameT>(state.range(0));
+  std::uint64_t nodes = 0;
+  for (auto const& g : games) {
+    nega_max nm(g, std::less<typename GameT::move_type>{}, unordered_table<GameT>{}, search_stats{});
+    nm.solve();
+    nodes += nm.stats().nodes();
+  }
+  perf_scope perf(state);
+  for (auto _ : state) {
+    for (auto const& g : games) benchmark::DoNotOptimize(negamax_with_memory(g));
+  }
+  set_counters(state, games.size(), nodes);
+}
+
+template <class GameT>
+void bm_mtd_f(benchmark::State& state) {
+  auto const& games = corpus<GameT>(state.range(0));
+  std::uint64_t nodes = 0;
+  for (auto const& g : games) {
+    mtd_f<GameT, no_ordering, no_table<GameT>, search_stats> solver(g);
+    solver.solve(0, 0, max_value<GameT>(state.range(0)));
+    nodes += solver.stats().nodes();
+  }
+  perf_scope perf(state);
+  for (auto _ : state) {
+    for (auto const& g : games) benchmark::DoNotOptimize(mtd_f(g).solve(0, 0, max_value<GameT>(state.range(0))));
+  }
+  set_counters(state, games.size(), nodes);
+}
+
+template <class GameT, class TableT>
+TableT make_table() {
+  if constexpr (std::is_constructible_v<TableT, size_t>) {
+    return TableT(size_t{1} << 20);
+  } else {
+    return TableT{};
+  }
+}
+
+template <class GameT, class TableT>
+void bm_mws_binary_search(benchmark::State& state) {
+  auto const& games = corpus<GameT>(state.range(0));
+  std::uint64_t nodes = 0;
+  for (auto const& g : games) {
+    minimal_window_search mws(g, make_table<GameT, TableT>(), no_ordering{}, search_stats{});
+    mws_binary_search(mws, 0, max_value<GameT>(state.range(0)));
+    nodes += mws.stats().nodes();
+  }
+  perf_scope perf(state);
+  for (auto _ : state) {
+    for (auto const& g : games) {
+      minimal_window_search mws(g, make_table<GameT, TableT>());
+      benchmark::DoNotOptimize(mws_binary_search(mws, 0, max_value<GameT>(state.range(0))));
+    }
+  }
+  set_counters(state, games.size(), nodes);
+}
+
+void bm_double_dummy(benchmark::State& state) {
+  auto const cards_per_player = static_cast<size_t>(state.range(0));
+  std::vector<bridge::internal_state_type> deals;
+  for (std::uint64_t seed = 1; seed <= corpus_size; ++seed) {
+    deals.push_back(deal_bridge_hands(shuffle_deck(create_bridge_deck(), seed), cards_per_player));
+  }
+  std::uint64_t nodes = 0;
+  for (auto const& d : deals) {
+    double_dummy_solver solver(strain::notrump);
+    solver.solve(d, 0);
+    nodes += solver.nodes();
+  }
+  perf_scope perf(state);
+  for (auto _ : state) {
+    for (auto const& d : deals) {
+      benchmark::DoNotOptimize(solve_double_dummy(d, 0, strain::notrump));
+    }
+  }
+  set_counters(state, deals.size(), nodes);
+}
+
+/**
+ * Time guard of the double dummy solver on the slowest 13-card no trump deals of the seeds 1 to 20 (the
+ * tail of the solve times): the slowest solve is the counter worst_ms, the run fails above the time limit.
+ */
+void bm_double_dummy_tail(benchmark::State& state) {
+  constexpr double time_limit = 6.0;  // seconds per solve
+  std::vector<std::pair<bridge::internal_state_type, bridge::player_type>> deals;
+  for (std::uint64_t seed : {11, 19}) {
+    auto const deal = deal_bridge_hands(shuffle_deck(create_bridge_deck(), seed), 13);
+    for (bridge::player_type declarer : {0, 3}) deals.emplace_back(deal, declarer);
+  }
+  double worst = 0;
+  perf_scope perf(state);
+  for (auto _ : state) {
+    for (auto const& [deal, declarer] : deals) {
+      auto const start = std::chrono::steady_clock::now();
+      benchmark::DoNotOptimize(solve_double_dummy(deal, declarer, strain::notrump));
+      worst = std::max(worst, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+  }
+  state.counters["worst_ms"] = 1000 * worst;
+  if (worst > time_limit) state.SkipWithError("A double dummy solve exceeds the time limit");
+}
+
+void bm_dd_table(benchmark::State& state) {
+  auto const cards_per_player = static_cast<size_t>(state.range(0));
+  std::vector<bridge::internal_state_type> deals;
+  for (std::uint64_t seed = 1; seed <= corpus_size; ++seed) {
+    deals.push_back(deal_bridge_hands(shuffle_deck(create_bridge_deck(), seed), cards_per_player));
+  }
+  perf_scope perf(state);
+  for (auto _ : state) {
+    for (auto const& d : deals) {
+      benchmark::DoNotOptimize(dd_table(d));
+    }
+  }
+  state.counters["games"] = benchmark::Counter(deals.size(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+template <class GameT>
+void bm_small_game(benchmark::State& state) {
+  perf_scope perf(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(alphabeta_with_memory(GameT{}));
+  }
+}
+
+void bm_connectfour_endgame(benchmark::State& state) {
+  // the first four columns of the scenario of the unit tests
+  connectfour game;
+  for (connectfour::move_type m : {0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 6, 6, 6, 6, 6, 6}) game.apply_action(m);
+  perf_scope perf(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mtd_f(game).solve(0, -1, 1));
+  }
+}
+
+template <class GameT>
+void bm_retrograde(benchmark::State& state) {
+  perf_scope perf(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(retrograde_table<GameT>::generate());
+  }
+}
+
+/**
+ * Information sets of a solved cfr and their approximate heap usage: the map node (key, node and the
+ * red-black tree links) plus its share of the regret and strategy arena.
+ */
+template <class GameT>
+void set_infoset_counters(benchmark::State& state, cfr<GameT> const& solver) {
+  constexpr size_t tree_overhead = 4 * sizeof(void*);
+  size_t bytes = solver.arena_bytes();
+  for (auto const& [info_set, node] : solver.map()) {
+    bytes += sizeof(typename cfr<GameT>::map_type::value_type) + tree_overhead;
+    if (node.actions.capacity() > sizeof(node.actions)) bytes += node.actions.capacity();
+  }
+  auto const infosets = solver.map().size();
+  state.counters["infosets"] = static_cast<double>(infosets);
+  state.counters["bytes_per_infoset"] = infosets == 0 ? 0.0 : static_cast<double>(bytes) / infosets;
+}
+
+template <class GameT>
+void bm_cfr(benchmark::State& state) {
+  auto const iterations = static_cast<int>(state.range(0));
+  {
+    cfr<GameT> solver{GameT{}};
+    solver.solve(iterations);
+    set_infoset_counters(state, solver);
+  }
+  perf_scope perf(state);
+  for (auto _ : state) {
+    cfr<GameT> solver{GameT{}};
+    benchmark::DoNotOptimize(solver.solve(iterations));
+  }
+  state.counters["iterations"] = benchmark::Counter(iterations, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+/**
+ * One iteration of the public tree covers all deals.
+ */
+template <class GameT>
+void bm_cfr_public_tree(benchmark::State& state) {
+  auto const iterations = static_cast<int>(state.range(0));
+  {
+    cfr<GameT> solver{GameT{}};
+    solver.solve_public_tree(iterations);
+    set_infoset_counters(state, solver);
+  }
+  perf_scope perf(state);
+  for (auto _ : state) {
+    cfr<GameT> solver{GameT{}};
+    benchmark::DoNotOptimize(solver.solve_public_tree(iterations));
+  }
+  state.counters["iterations"] = benchmark::Counter(iterations, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+}  // namespace
+
+BENCHMARK(bm_small_game<tictactoe>)->Name("alphabeta_with_memory/tictactoe")->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_connectfour_endgame)->Name("mtd_f/connectfour_endgame")->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_retrograde<tictactoe>)->Name("retrograde/tictactoe")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bm_retrograde<basic_connectfour<5, 4>>)
+    ->Name("retrograde/connectfour_5x4")
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(bm_alphabeta<bridge>)->Name("alphabeta/bridge")->DenseRange(3, 5)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_alphabeta_with_memory<bridge>)
+    ->Name("alphabeta_with_memory/bridge")
+    ->DenseRange(3, 6)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_negamax_with_memory<bridge>)
+    ->Name("negamax_with_memory/bridge")
+    ->DenseRange(3, 6)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_mtd_f<bridge>)->Name("mtd_f/bridge")->DenseRange(3, 6)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_mws_binary_search<bridge, mws_unordered_table<bridge>>)
+    ->Name("mws_binary_search/bridge")
+    ->DenseRange(3, 6)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_mws_binary_search<bridge, packed_mws_table<bridge>>)
+    ->Name("mws_binary_search_packed/bridge")
+    ->DenseRange(3, 6)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(bm_double_dummy)->Name("double_dummy/bridge")->Arg(7)->Arg(10)->Arg(13)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_double_dummy_tail)->Name("double_dummy/bridge_tail")->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_dd_table)->Name("dd_table/bridge")->Arg(10)->Arg(13)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK(bm_alphabeta<skat>)->Name("alphabeta/skat")->DenseRange(3, 5)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_alphabeta_with_memory<skat>)->Name("alphabeta_with_memory/skat")->DenseRange(3, 6)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_mtd_f<skat>)->Name("mtd_f/skat")->DenseRange(3, 6)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_mws_binary_search<skat, mws_unordered_table<skat>>)
+    ->Name("mws_binary_search/skat")
+    ->DenseRange(3, 8)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_mws_binary_search<skat, packed_mws_table<skat>>)
+    ->Name("mws_binary_search_packed/skat")
+    ->DenseRange(3, 8)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(bm_cfr<kuhn>)->Name("cfr/kuhn")->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_cfr<leduc>)->Name("cfr/leduc")->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_cfr_public_tree<kuhn>)->Name("cfr_public_tree/kuhn")->Arg(100)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_cfr_public_tree<leduc>)->Name("cfr_public_tree/leduc")->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
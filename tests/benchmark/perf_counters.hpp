@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * perf_counters reads the hardware performance counters of the calling thread and of the threads it starts
+ * (e. g. the parallel_for pools of dd_table and retrograde_table) via Linux perf_event_open. The counts of a
+ * started thread are added when it exits, i. e. the pools have to be joined before stop().
+ * Every event is opened on its own, so unsupported events (e. g. on virtual machines) are skipped; if none
+ * can be opened (no Linux, perf_event_paranoid, seccomp in containers), available() is false and all
+ * values stay 0. Multiplexed counters are scaled by the time they were actually running.
+ */
+class perf_counters {
+ public:
+  enum event
+  {
+    cycles,
+    instructions,
+    l1d_misses,
+    llc_misses,
+    branch_misses,
+    dtlb_misses,
+    num_events
+  };
+
+  constexpr static std::array<char const*, num_events> names = {"cycles",     "instructions",  "L1D_misses",
+                                                                 "LLC_misses", "branch_misses", "dTLB_misses"};
+
+  perf_counters() {
+    fds_.fill(-1);
+#ifdef __linux__
+    constexpr auto cache_read_miss = [](std::uint64_t cache) {
+      return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    };
+    _open(cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    _open(instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    _open(l1d_misses, PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_L1D));
+    _open(llc_misses, PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_LL));
+    _open(branch_misses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    _open(dtlb_misses, PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_DTLB));
+#endif
+  }
+
+  perf_counters(perf_counters const&) = delete;
+  perf_counters& operator=(perf_counters const&) = delete;
+
+  ~perf_counters() {
+#ifdef __linux__
+    for (auto fd : fds_) {
+      if (fd >= 0) close(fd);
+    }
+#endif
+  }
+
+  bool available() const { return available(cycles) || available(instructions); }
+
+  bool available(event e) const { return fds_[e] >= 0; }
+
+  void start() {
+#ifdef __linux__
+    for (auto fd : fds_) {
+      if (fd < 0) continue;
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  /**
+   * Stop counting and add the counts since start() to the values.
+   */
+  void stop() {
+#ifdef __linux__
+    for (int e = 0; e < num_events; ++e) {
+      if (fds_[e] < 0) continue;
+      ioctl(fds_[e], PERF_EVENT_IOC_DISABLE, 0);
+      std::uint64_t data[3] = {0, 0, 0};  // value, time enabled, time running
+      if (read(fds_[e], data, sizeof(data)) != sizeof(data)) continue;
+      values_[e] += data[2] == 0 ? 0.0 : static_cast<double>(data[0]) * data[1] / data[2];
+    }
+#endif
+  }
+
+  double value(event e) const { return values_[e]; }
+
+ private:
+#ifdef __linux__
+  void _open(event e, std::uint32_t type, std::uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    fds_[e] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+#endif
+
+  std::array<int, num_events> fds_;
+  std::array<double, num_events> values_{};
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <iostream>
+#include <optional>
+
+#include "perf_counters.hpp"
+
+/**
+ * perf_scope counts the hardware events from its construction (right before the benchmark loop)
+ * to its destruction and reports them per iteration next to the other counters of the benchmark.
+ * It does nothing unless enabled by golv_benchmark --perf_counters.
+ */
+class perf_scope {
+ public:
+  static bool& enabled() {
+    static bool enabled = false;
+    return enabled;
+  }
+
+  explicit perf_scope(benchmark::State& state) : state_(state) {
+    if (!enabled()) return;
+    counters_.emplace();
+    if (!counters_->available()) {
+      _warn_once();
+      counters_.reset();
+      return;
+    }
+    counters_->start();
+  }
+
+  perf_scope(perf_scope const&) = delete;
+  perf_scope& operator=(perf_scope const&) = delete;
+
+  ~perf_scope() {
+    if (!counters_) return;
+    counters_->stop();
+    for (int e = 0; e < perf_counters::num_events; ++e) {
+      auto const event = static_cast<perf_counters::event>(e);
+      if (!counters_->available(event)) continue;
+      state_.counters[perf_counters::names[e]] =
+          benchmark::Counter(counters_->value(event), benchmark::Counter::kAvgIterations);
+    }
+    if (counters_->available(perf_counters::cycles) && counters_->available(perf_counters::instructions) &&
+        counters_->value(perf_counters::cycles) > 0) {
+      state_.counters["IPC"] = counters_->value(perf_counters::instructions) / counters_->value(perf_counters::cycles);
+    }
+  }
+
+ private:
+  static void _warn_once() {
+    static bool warned = false;
+    if (warned) return;
+    warned = true;
+    std::cerr << "perf_event_open is not available (check /proc/sys/kernel/perf_event_paranoid or the seccomp "
+                 "profile of the container), running without hardware counters"
+              << std::endl;
+  }
+
+  benchmark::State& state_;
+  std::optional<perf_counters> counters_;
+};
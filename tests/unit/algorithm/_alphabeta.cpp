@@ -93,6 +93,28 @@ TEST_F(_alphabeta, tictactoe_with_memory) {
   ASSERT_EQ(solution, 0);
 }
 
+TEST_F(_alphabeta, tictactoe_table_counters) {
+  golv::tictactoe game;
+  golv::alpha_beta ab(game, std::less<golv::tictactoe::move_type>{},
+                      golv::unordered_table<golv::tictactoe, golv::table_counters>{});
+  ASSERT_EQ(ab.solve(), 0);
+  auto stats = ab.get_table().stats();
+  GOLV_LOG_DEBUG("stats = " << stats);
+  EXPECT_GT(stats.probes, 0);
+  EXPECT_GT(stats.hits, 0);
+  EXPECT_LE(stats.hits, stats.probes);
+  EXPECT_GT(stats.exact_cutoffs + stats.bound_cutoffs, 0);
+  EXPECT_LE(stats.exact_cutoffs + stats.bound_cutoffs, stats.hits);
+  EXPECT_EQ(stats.size, ab.get_table().size());
+  size_t per_depth = 0;
+  for (auto n : stats.entries_per_depth) per_depth += n;
+  EXPECT_EQ(per_depth, stats.size);
+
+  auto plain = golv::alphabeta(game, std::less<golv::tictactoe::move_type>{}, golv::unordered_table<golv::tictactoe>{});
+  EXPECT_EQ(plain.first, 0);
+  EXPECT_EQ(golv::unordered_table<golv::tictactoe>{}.stats().probes, 0);
+}
+
 namespace {
 auto connectfour_ordering = [](golv::connectfour::move_type left, golv::connectfour::move_type right) {
     auto dist_left = std::abs(static_cast<int>(left) - static_cast<int>(golv::connectfour::width / 2));
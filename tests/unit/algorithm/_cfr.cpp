@@ -4,6 +4,7 @@
 #include <functional>
 #include <golv/algorithms/cfr.hpp>
 #include <golv/games/kuhn.hpp>
+#include <golv/games/leduc.hpp>
 #include <golv/games/rps.hpp>
 #include <golv/util/logging.hpp>
 #include <numeric>
@@ -91,4 +92,76 @@ TEST(cfr, kuhn) {
   // plausi check 4: Player 1 calls to Player 2's bet with 1: (y+1)/3
   freqCall1 = solver.map().at("1|xb").avg_strategy()[1];
   EXPECT_NEAR(freqCall1, (y + 1.0) / 3.0, 0.1);
-}
\ No newline at end of file
+}
+
+TEST(cfr, leduc) {
+  golv::set_log_level(golv::log_level::debug);
+  leduc game;
+  cfr solver(game);
+  auto val = solver.solve(100000);
+  GOLV_LOG_DEBUG("val = " << val);
+  // game value for the first player is about -0.0856
+  EXPECT_NEAR(val, -0.0856, 0.05);
+  // 288 information sets when suits are abstracted away
+  EXPECT_EQ(solver.map().size(), 288);
+
+  // plausi check 1: bet a pair of kings in the second round
+  leduc kings;
+  kings.deal(4, 0);
+  kings.apply_action('c');
+  kings.apply_action('c');
+  kings.deal_public(5);
+  EXPECT_GT(solver.map().at(kings.state()).avg_strategy()[1], 0.8);
+
+  // plausi check 2: mostly fold a jack against a raise in the first round
+  leduc jack;
+  jack.deal(4, 0);
+  jack.apply_action('r');
+  EXPECT_GT(solver.map().at(jack.state()).avg_strategy()[0], 0.5);
+}
+
+TEST(cfr, kuhn_public_tree) {
+  kuhn game;
+  cfr solver(game);
+  auto val = solver.solve_public_tree(2000);
+  EXPECT_NEAR(val, -1.0 / 18.0, 0.01);
+  EXPECT_EQ(solver.map().size(), 12);
+
+  // same plausibility checks as above, but much tighter
+  auto y = solver.map().at("2|").avg_strategy()[1];
+  EXPECT_NEAR(solver.map().at("0|").avg_strategy()[1], y / 3, 0.02);
+  EXPECT_NEAR(solver.map().at("1|b").avg_strategy()[1], 1.0 / 3.0, 0.02);
+  EXPECT_NEAR(solver.map().at("0|x").avg_strategy()[1], 1.0 / 3.0, 0.02);
+  EXPECT_NEAR(solver.map().at("1|xb").avg_strategy()[1], (y + 1.0) / 3.0, 0.02);
+}
+
+TEST(cfr, leduc_public_tree) {
+  leduc game;
+  cfr solver(game);
+  auto val = solver.solve_public_tree(3000);
+  EXPECT_NEAR(val, -0.0856, 0.01);
+  EXPECT_EQ(solver.map().size(), 288);
+
+  leduc kings;
+  kings.deal(4, 0);
+  kings.apply_action('c');
+  kings.apply_action('c');
+  kings.deal_public(5);
+  EXPECT_GT(solver.map().at(kings.state()).avg_strategy()[1], 0.8);
+
+  leduc jack;
+  jack.deal(4, 0);
+  jack.apply_action('r');
+  EXPECT_GT(solver.map().at(jack.state()).avg_strategy()[0], 0.5);
+}
+
+TEST(cfr, arena_bytes) {
+  cfr solver(leduc{});
+  EXPECT_EQ(solver.arena_bytes(), 0);
+  solver.solve_public_tree(1);
+  size_t values = 0;
+  for (auto const& [info_set, node] : solver.map()) values += node.size();
+  // regret and strategy sums, the last block of each is partially used
+  EXPECT_GE(solver.arena_bytes(), 2 * values * sizeof(double));
+  EXPECT_LE(solver.arena_bytes(), 2 * (values + 512) * sizeof(double));
+}
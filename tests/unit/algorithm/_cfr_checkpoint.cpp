@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <golv/algorithms/cfr_checkpoint.hpp>
+#include <golv/games/leduc.hpp>
+#include <golv/util/logging.hpp>
+
+#include "../util/temp_file.hpp"
+
+using namespace golv;
+
+class cfr_checkpoint : public temp_file_test {
+ protected:
+  void SetUp() override {
+    temp_file_test::SetUp();
+    golv::set_log_level(golv::log_level::debug);
+  }
+};
+
+TEST_F(cfr_checkpoint, view) {
+  cfr solver(leduc{});
+  solver.solve(1000);
+  save_checkpoint(solver, path_);
+
+  cfr_strategy_view<leduc> view(path_);
+  ASSERT_EQ(view.size(), solver.map().size());
+  ASSERT_EQ(view.iterations(), 1000);
+  for (auto const& [info_set, node] : solver.map()) {
+    ASSERT_TRUE(view.contains(info_set));
+    auto e = view.at(info_set);
+    ASSERT_EQ(e.size(), node.size());
+    auto expected = node.avg_strategy();
+    auto actual = e.avg_strategy();
+    for (size_t i = 0; i < node.size(); ++i) {
+      EXPECT_EQ(e.actions[i], node.actions[i]);
+      EXPECT_DOUBLE_EQ(actual[i], expected[i]);
+    }
+  }
+  EXPECT_FALSE(view.contains(0xffffffff));
+}
+
+TEST_F(cfr_checkpoint, resume) {
+  cfr solver(leduc{});
+  solver.solve(1000);
+  save_checkpoint(solver, path_);
+
+  cfr restored(leduc{});
+  load_checkpoint(restored, path_);
+  ASSERT_EQ(restored.iterations(), 1000);
+  ASSERT_EQ(restored.map().size(), solver.map().size());
+  for (auto const& [info_set, node] : solver.map()) {
+    auto const& other = restored.map().at(info_set);
+    EXPECT_EQ(other.actions, node.actions);
+    for (size_t i = 0; i < node.size(); ++i) {
+      EXPECT_EQ(other.regret_sum[i], node.regret_sum[i]);
+      EXPECT_EQ(other.strategy_sum[i], node.strategy_sum[i]);
+    }
+  }
+  restored.solve(1000);
+  EXPECT_EQ(restored.iterations(), 2000);
+}
+
+TEST_F(cfr_checkpoint, with_stats) {
+  cfr<leduc, search_stats> solver(leduc{});
+  cfr_checkpointer<leduc> checkpointer(path_, 50);
+  solver.solve(100, checkpointer);
+  checkpointer.wait();
+  save_checkpoint(solver, path_);
+  EXPECT_GT(solver.stats().nodes(), 0);
+
+  cfr<leduc, search_stats> restored(leduc{});
+  load_checkpoint(restored, path_);
+  EXPECT_EQ(restored.iterations(), 100);
+  EXPECT_EQ(restored.map().size(), solver.map().size());
+}
+
+TEST_F(cfr_checkpoint, async) {
+  cfr solver(leduc{});
+  {
+    cfr_checkpointer<leduc> checkpointer(path_, 100);
+    solver.solve(1000, checkpointer);
+    checkpointer.wait();
+    EXPECT_EQ(checkpointer.written() + checkpointer.skipped(), 10);
+    EXPECT_GE(checkpointer.written(), 1);
+  }
+  cfr_strategy_view<leduc> view(path_);
+  EXPECT_EQ(view.iterations() % 100, 0);
+  // later snapshots may have been skipped, so the view can lag behind the solver
+  EXPECT_GT(view.size(), 0);
+  EXPECT_LE(view.size(), solver.map().size());
+}
+
+TEST_F(cfr_checkpoint, invalid_file) {
+  {
+    std::ofstream out(path_, std::ios::binary);
+    out << "this is not a checkpoint of golv";
+  }
+  EXPECT_THROW(cfr_strategy_view<leduc>{path_}, golv::exception);
+  EXPECT_THROW(cfr_strategy_view<leduc>{path_ + ".missing"}, golv::exception);
+}
+
+TEST_F(cfr_checkpoint, corrupt_entries) {
+  cfr solver(leduc{});
+  solver.solve(10);
+  save_checkpoint(solver, path_);
+  ASSERT_GE(solver.map().size(), 2);
+
+  auto const entries = static_cast<std::streamoff>(sizeof(cfr_checkpoint_header));
+  auto const patch = [this](std::streamoff pos, auto value) {
+    std::fstream file(path_, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(pos);
+    file.write(reinterpret_cast<char const*>(&value), sizeof(value));
+  };
+  auto const read = [this](std::streamoff pos) {
+    std::ifstream file(path_, std::ios::binary);
+    file.seekg(pos);
+    std::uint64_t value = 0;
+    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+  };
+
+  // the size of the first entry beyond the action arrays
+  auto const size_pos = entries + static_cast<std::streamoff>(offsetof(cfr_checkpoint_entry, size));
+  auto const size = read(size_pos);
+  patch(size_pos, std::uint64_t{1} << 40);
+  EXPECT_THROW(cfr_strategy_view<leduc>{path_}, golv::exception);
+  patch(size_pos, size);
+  EXPECT_NO_THROW(cfr_strategy_view<leduc>{path_});
+
+  // counts which overflow the expected size
+  auto const num_infosets_pos = static_cast<std::streamoff>(offsetof(cfr_checkpoint_header, num_infosets));
+  auto const num_infosets = read(num_infosets_pos);
+  patch(num_infosets_pos, std::uint64_t{1} << 59);
+  EXPECT_THROW(cfr_strategy_view<leduc>{path_}, golv::exception);
+  patch(num_infosets_pos, num_infosets);
+
+  // a file of a machine with the other byte order
+  auto const byte_order_pos = static_cast<std::streamoff>(offsetof(cfr_checkpoint_header, byte_order));
+  patch(byte_order_pos, std::uint32_t{0x04030201});
+  EXPECT_THROW(cfr_strategy_view<leduc>{path_}, golv::exception);
+  patch(byte_order_pos, cfr_checkpoint_header::byte_order_mark);
+  EXPECT_NO_THROW(cfr_strategy_view<leduc>{path_});
+
+  // the second key equal to the first one
+  auto const second_key = entries + static_cast<std::streamoff>(sizeof(cfr_checkpoint_entry));
+  patch(second_key, read(entries));
+  EXPECT_THROW(cfr_strategy_view<leduc>{path_}, golv::exception);
+}
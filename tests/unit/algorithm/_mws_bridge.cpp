@@ -142,7 +142,7 @@ TEST_F(mws_bridge, skat_10cards_binary)
   GOLV_LOG_DEBUG("game = " << game);
 
   auto actions = game.legal_actions();
-  std::sort(actions.begin(), actions.end(), order{});
+  sort_moves(actions, order{});
   GOLV_LOG_DEBUG("actions = " << actions);
 
   auto [value, best_move] =  // mws_binary_search(game);
@@ -159,7 +159,7 @@ TEST_F(mws_bridge, skat_10cards_binary_rot1)
   GOLV_LOG_DEBUG("game = " << game);
 
   auto actions = game.legal_actions();
-  std::sort(actions.begin(), actions.end(), order{});
+  sort_moves(actions, order{});
   GOLV_LOG_DEBUG("actions = " << actions);
 
   auto [value, bm] =  // mws_binary_search(game);
@@ -174,7 +174,7 @@ TEST_F(mws_bridge, skat_10cards_binary_rot2)
   GOLV_LOG_DEBUG("game = " << game);
 
   auto actions = game.legal_actions();
-  std::sort(actions.begin(), actions.end(), order{});
+  sort_moves(actions, order{});
   GOLV_LOG_DEBUG("actions = " << actions);
 
   auto [value, bm] =  // mws_binary_search(game);
@@ -190,7 +190,7 @@ TEST_F(mws_bridge, skat_10cards_binary_with_pushing)
   GOLV_LOG_DEBUG("game = " << game);
 
   auto actions = game.legal_actions();
-  std::sort(actions.begin(), actions.end(), order{});
+  sort_moves(actions, order{});
   GOLV_LOG_DEBUG("actions = " << actions);
 
   auto [value, best_move] =  // mws_binary_search(game);
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <golv/algorithms/mws.hpp>
+#include <golv/algorithms/packed_mws_table.hpp>
+#include <golv/util/logging.hpp>
+#include <golv/util/test_utils.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+
+#include "../util/temp_file.hpp"
+#include "../util/test_games.hpp"
+
+using namespace golv;
+
+namespace {
+
+struct order {
+  skat_card_order skat_order{suit::clubs};
+  bool operator()(const card& left, const card& right) {          //
+    return !operator==(left, right) && !skat_order(left, right);  //
+  }
+};
+
+skat::state_type key(unsigned long long bits) { return skat::state_type{bits}; }
+
+using counted_table = packed_mws_table<skat, table_counters>;
+
+}  // namespace
+
+TEST(packed_mws_table, layout) {
+  using table_type = packed_mws_table<skat>;
+  EXPECT_EQ(sizeof(table_type::entry), 8);
+  EXPECT_EQ(sizeof(table_type::bucket), 64);
+  EXPECT_EQ(alignof(table_type::bucket), 64);
+  // disabled counters take no space
+  EXPECT_LT(sizeof(table_type), sizeof(counted_table));
+
+  table_type table(1 << 20);
+  EXPECT_EQ(table.memory(), 1 << 20);
+  EXPECT_EQ(table.capacity(), (1 << 20) / 8);
+}
+
+TEST(packed_mws_table, bounds) {
+  counted_table table(4096);
+  auto [lower, upper] = table.get(key(7));
+  EXPECT_EQ(lower, std::numeric_limits<skat::value_type>::lowest());
+  EXPECT_EQ(upper, std::numeric_limits<skat::value_type>::max());
+
+  table.update_lower(key(7), 10);
+  table.update_lower(key(7), 5);  // weaker bound is ignored
+  table.update_upper(key(7), 30, 2);
+  std::tie(lower, upper) = table.get(key(7));
+  EXPECT_EQ(lower, 10);
+  EXPECT_EQ(upper, 30);
+  EXPECT_EQ(table.best_move(key(7)), 2);
+  EXPECT_EQ(table.best_move(key(8)), packed_mws_table<skat>::npos);
+
+  // bounds beyond 8 bits are clamped to weaker ones
+  table.update_upper(key(9), 500);
+  table.update_lower(key(9), 500);
+  std::tie(lower, upper) = table.get(key(9));
+  EXPECT_EQ(upper, std::numeric_limits<skat::value_type>::max());
+  EXPECT_EQ(lower, 126);
+
+  EXPECT_EQ(table.size(), 2);
+  EXPECT_EQ(table.stats().probes, 3);
+  EXPECT_EQ(table.stats().hits, 2);
+}
+
+TEST(packed_mws_table, replace_shallow_entries) {
+  // a single bucket: the entry with the fewest cards is replaced
+  counted_table table(64);
+  ASSERT_EQ(table.capacity(), 8);
+  for (unsigned long long i = 0; i < 8; ++i) {
+    table.update_lower(key((1ULL << (i + 2)) - 1), 1);  // i + 2 cards
+  }
+  EXPECT_EQ(table.size(), 8);
+  table.update_lower(key(0xFFFF), 1);
+  EXPECT_EQ(table.stats().overwrites, 1);
+  EXPECT_EQ(table.stats().entries_per_depth[2], 0);
+  EXPECT_EQ(table.stats().entries_per_depth[16], 1);
+  EXPECT_EQ(table.get(key(3)).first, std::numeric_limits<skat::value_type>::lowest());
+  EXPECT_EQ(table.get(key(7)).first, 1);
+  EXPECT_EQ(table.get(key(0xFFFF)).first, 1);
+}
+
+TEST(packed_mws_table, skat_10cards) {
+  golv::set_log_level(golv::log_level::error);
+  auto game = default_skat_game_10();
+  minimal_window_search search(game, counted_table(size_t{8} << 20), order{});
+  auto [value, best_move] = mws_binary_search(search);
+  EXPECT_EQ(value, 24);
+  EXPECT_EQ(best_move, "Ac");
+  auto const stats = search.table_.stats();
+  EXPECT_GT(stats.hit_rate(), 0.0);
+  EXPECT_GT(stats.bound_cutoffs, 0);
+  EXPECT_LE(stats.bound_cutoffs, stats.hits);
+  EXPECT_EQ(stats.size, search.table_.size());
+  EXPECT_GT(stats.fill_ratio(9), 0.0);  // entries at the start of the second trick
+}
+
+TEST(packed_mws_table, skat_7cards_small_table) {
+  // heavy replacement must not change the result
+  golv::set_log_level(golv::log_level::error);
+  auto game = default_skat_game_7(1);
+  minimal_window_search search(game, counted_table(4096), order{});
+  EXPECT_TRUE(search.solve(27));
+  EXPECT_FALSE(search.solve(28));
+  EXPECT_GT(search.table_.stats().overwrites, 0);
+}
+
+TEST(packed_mws_table, bridge_5cards) {
+  auto game = default_game_5();
+  minimal_window_search search(game, packed_mws_table<bridge>(1 << 16));
+  EXPECT_TRUE(search.solve(3));
+  EXPECT_FALSE(search.solve(4));
+}
+
+class packed_mws_table_file : public temp_file_test {
+ protected:
+  void SetUp() override {
+    temp_file_test::SetUp();
+    golv::set_log_level(golv::log_level::error);
+  }
+};
+
+TEST_F(packed_mws_table_file, warm_start) {
+  auto game = default_skat_game_10();
+  constexpr std::uint64_t variant = 42;
+  size_t cold_probes = 0;
+  {
+    minimal_window_search search(game, counted_table(size_t{8} << 20), order{});
+    auto [value, best_move] = mws_binary_search(search);
+    EXPECT_EQ(value, 24);
+    cold_probes = search.table_.stats().probes;
+    search.table_.save(path_, variant);
+  }
+
+  auto table = counted_table::open(path_, variant);
+  EXPECT_TRUE(table.is_mapped());
+  EXPECT_GT(table.size(), 0);
+  minimal_window_search search(game, std::move(table), order{});
+  auto [value, best_move] = mws_binary_search(search);
+  EXPECT_EQ(value, 24);
+  EXPECT_EQ(best_move, "Ac");
+  EXPECT_LT(search.table_.stats().probes, cold_probes / 10);
+}
+
+TEST_F(packed_mws_table_file, read_write) {
+  {
+    packed_mws_table<skat> table(4096);
+    table.save(path_, 0);
+  }
+  {
+    auto table = packed_mws_table<skat>::open(path_, 0, mapped_file::mode::read_write);
+    table.update_lower(key(0xF0), 12);
+    table.flush();
+  }
+  auto table = packed_mws_table<skat>::open(path_, 0);
+  EXPECT_EQ(table.size(), 1);
+  EXPECT_EQ(table.get(key(0xF0)).first, 12);
+}
+
+TEST_F(packed_mws_table_file, mismatch) {
+  packed_mws_table<skat>(4096).save(path_, 1);
+  EXPECT_THROW(packed_mws_table<skat>::open(path_, 2), golv::exception);
+  EXPECT_THROW(packed_mws_table<bridge>::open(path_, 1), golv::exception);
+  EXPECT_THROW(packed_mws_table<skat>::open(path_, 1, mapped_file::mode::read_only), golv::exception);
+  EXPECT_NO_THROW(packed_mws_table<skat>::open(path_, 1));
+
+  // a file of a machine with the other byte order
+  auto const patch_byte_order = [this](std::uint32_t value) {
+    std::fstream file(path_, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(offsetof(packed_table_header, byte_order)));
+    file.write(reinterpret_cast<char const*>(&value), sizeof(value));
+  };
+  patch_byte_order(0x04030201);
+  EXPECT_THROW(packed_mws_table<skat>::open(path_, 1), golv::exception);
+  patch_byte_order(packed_table_header::byte_order_mark);
+  EXPECT_NO_THROW(packed_mws_table<skat>::open(path_, 1));
+
+  std::filesystem::resize_file(path_, packed_table_header::buckets_offset + 64);
+  EXPECT_THROW(packed_mws_table<skat>::open(path_, 1), golv::exception);
+  EXPECT_THROW(packed_mws_table<skat>::open(path_ + ".missing", 1), golv::exception);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <golv/algorithms/alphabeta.hpp>
+#include <golv/algorithms/mws.hpp>
+#include <golv/algorithms/retrograde.hpp>
+#include <golv/games/connectfour.hpp>
+#include <golv/games/tictactoe.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "../util/temp_file.hpp"
+
+using namespace golv;
+
+namespace {
+
+using small_connectfour = basic_connectfour<5, 4>;
+
+/**
+ * Compare the table with alpha-beta along random games, skipping the first moves (to keep the searches short).
+ */
+template <class GameT>
+void expect_like_search(retrograde_table<GameT> const& table, int games, int skip, std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  for (int i = 0; i < games; ++i) {
+    GameT game;
+    for (int move = 0; !game.is_terminal(); ++move) {
+      if (move >= skip) {
+        ASSERT_TRUE(table.get(game).has_value()) << game.state();
+        EXPECT_EQ(*table.get(game), alphabeta_with_memory(game).first) << game.state();
+      }
+      auto const legal = game.legal_actions();
+      game.apply_action(legal[rng() % legal.size()]);
+    }
+    EXPECT_EQ(table.get(game), game.value());
+  }
+}
+
+}  // namespace
+
+TEST(retrograde, tictactoe) {
+  auto const table = retrograde_table<tictactoe>::generate();
+  EXPECT_EQ(table.size(), 5478);
+  EXPECT_EQ(table.memory(), 616 * sizeof(std::uint64_t));
+  EXPECT_EQ(table.get(tictactoe{}), 0);
+  expect_like_search(table, 20, 0, 1);
+
+  // a position that cannot be reached (X has two more pieces than O)
+  EXPECT_FALSE(table.get(tictactoe::from_position_index(1 + 3)).has_value());
+}
+
+TEST(retrograde, independent_of_threads) {
+  auto const single = retrograde_table<tictactoe>::generate(tictactoe{}, 1);
+  auto const pool = retrograde_table<tictactoe>::generate(tictactoe{}, 3);
+  for (std::uint64_t i = 0; i < tictactoe::num_positions; ++i) {
+    auto const game = tictactoe::from_position_index(i);
+    ASSERT_EQ(single.get(game), pool.get(game)) << i;
+  }
+}
+
+TEST(retrograde, connectfour_5x4) {
+  auto const table = retrograde_table<small_connectfour>::generate();
+  EXPECT_EQ(table.get(small_connectfour{}), 0);
+  expect_like_search(table, 5, 8, 2);
+}
+
+TEST(retrograde, solvers_probe_table) {
+  auto const table = retrograde_table<tictactoe>::generate();
+  tictactoe game;
+  game.apply_action(4);
+
+  alpha_beta plain(game, no_ordering{}, no_table<tictactoe>{}, search_stats{});
+  alpha_beta probing(game, no_ordering{}, no_table<tictactoe>{}, search_stats{}, table);
+  EXPECT_EQ(probing.solve(), plain.solve());
+  EXPECT_LT(probing.stats().nodes(), 10);
+
+  minimal_window_search mws(game, no_table<tictactoe>{}, no_ordering{}, no_search_stats{}, table);
+  EXPECT_FALSE(mws.solve(0));
+  EXPECT_TRUE(mws.solve(-1));
+}
+
+using retrograde_file = temp_file_test;
+
+TEST_F(retrograde_file, save_and_open) {
+  auto const table = retrograde_table<tictactoe>::generate();
+  table.save(path_);
+
+  auto const mapped = retrograde_table<tictactoe>::open(path_);
+  EXPECT_EQ(mapped.size(), table.size());
+  for (std::uint64_t i = 0; i < tictactoe::num_positions; ++i) {
+    auto const game = tictactoe::from_position_index(i);
+    ASSERT_EQ(mapped.get(game), table.get(game)) << i;
+  }
+
+  EXPECT_THROW(retrograde_table<small_connectfour>::open(path_), golv::exception);
+
+  auto const patch = [this](size_t offset, auto const& value) {
+    std::fstream file(path_, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(reinterpret_cast<char const*>(&value), sizeof(value));
+  };
+  // a file of a machine with the other byte order
+  patch(offsetof(retrograde_header, byte_order), std::uint32_t{0x04030201});
+  EXPECT_THROW(retrograde_table<tictactoe>::open(path_), golv::exception);
+  patch(offsetof(retrograde_header, byte_order), retrograde_header::byte_order_mark);
+  EXPECT_NO_THROW(retrograde_table<tictactoe>::open(path_));
+  // another game with the same number of positions
+  patch(offsetof(retrograde_header, game), 'T');
+  EXPECT_THROW(retrograde_table<tictactoe>::open(path_), golv::exception);
+  patch(offsetof(retrograde_header, game), 't');
+  EXPECT_NO_THROW(retrograde_table<tictactoe>::open(path_));
+
+  std::filesystem::resize_file(path_, std::filesystem::file_size(path_) - 1);
+  EXPECT_THROW(retrograde_table<tictactoe>::open(path_), golv::exception);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <golv/algorithms/alphabeta.hpp>
+#include <golv/algorithms/cfr.hpp>
+#include <golv/algorithms/mtd_f.hpp>
+#include <golv/algorithms/mws.hpp>
+#include <golv/algorithms/negamax.hpp>
+#include <golv/algorithms/search_stats.hpp>
+#include <golv/games/kuhn.hpp>
+#include <golv/games/tictactoe.hpp>
+#include <golv/util/logging.hpp>
+#include <golv/util/test_utils.hpp>
+
+using namespace golv;
+
+class _search_stats : public ::testing::Test {
+ protected:
+  void SetUp() override { golv::set_log_level(golv::log_level::debug); }
+};
+
+TEST_F(_search_stats, effective_branching_factor) {
+  search_stats stats;
+  // complete binary tree of depth 3
+  for (int d = 0; d <= 3; ++d) {
+    for (int i = 0; i < (1 << d); ++i) stats.node(d);
+  }
+  EXPECT_EQ(stats.nodes(), 15);
+  EXPECT_EQ(stats.depth(), 3);
+  EXPECT_NEAR(stats.effective_branching_factor(), 2.0, 1e-6);
+
+  stats.cutoff(0);
+  stats.cutoff(0);
+  stats.cutoff(2);
+  stats.cutoff(100);
+  EXPECT_EQ(stats.cutoffs(), 4);
+  EXPECT_EQ(stats.cutoffs_per_move[search_stats::max_move_index], 1);
+  EXPECT_DOUBLE_EQ(stats.first_move_cutoff_rate(), 0.5);
+
+  auto json = stats.to_json();
+  EXPECT_NE(json.find("\"nodes\": 15"), std::string::npos);
+  EXPECT_NE(json.find("\"nodes_per_depth\": [1, 2, 4, 8]"), std::string::npos);
+
+  stats.clear();
+  EXPECT_EQ(stats.nodes(), 0);
+  EXPECT_EQ(stats.effective_branching_factor(), 0.0);
+}
+
+TEST_F(_search_stats, alphabeta_tictactoe) {
+  golv::tictactoe game;
+  alpha_beta ab(game, std::less<tictactoe::move_type>{}, unordered_table<tictactoe>{}, search_stats{});
+  ASSERT_EQ(ab.solve(), 0);
+  auto const& stats = ab.stats();
+  GOLV_LOG_DEBUG("stats = " << stats);
+  EXPECT_EQ(stats.nodes_per_depth[0], 1);
+  EXPECT_EQ(stats.nodes_per_depth[1], 9);
+  EXPECT_EQ(stats.depth(), 9);
+  EXPECT_GT(stats.cutoffs(), 0);
+  EXPECT_GT(stats.tt_probes, 0);
+  EXPECT_GT(stats.tt_cutoffs, 0);
+  EXPECT_LE(stats.tt_cutoffs, stats.tt_probes);
+  EXPECT_GT(stats.wall_time.count(), 0);
+
+  // the plain search visits more nodes
+  alpha_beta plain(game, no_ordering{}, no_table<tictactoe>{}, search_stats{});
+  ASSERT_EQ(plain.solve(), 0);
+  EXPECT_GT(plain.stats().nodes(), stats.nodes());
+  EXPECT_EQ(plain.stats().tt_probes, 0);
+}
+
+TEST_F(_search_stats, negamax_tictactoe) {
+  golv::tictactoe game;
+  nega_max nm(game, std::less<tictactoe::move_type>{}, unordered_table<tictactoe>{}, search_stats{});
+  ASSERT_EQ(nm.solve(), 0);
+  EXPECT_EQ(nm.stats().nodes_per_depth[1], 9);
+  EXPECT_GT(nm.stats().cutoffs(), 0);
+  EXPECT_GT(nm.stats().tt_cutoffs, 0);
+}
+
+TEST_F(_search_stats, mtd_f_re_searches) {
+  golv::tictactoe game;
+  mtd_f<tictactoe, no_ordering, no_table<tictactoe>, search_stats> solver(game);
+  ASSERT_EQ(solver.solve(0), 0);
+  GOLV_LOG_DEBUG("stats = " << solver.stats());
+  EXPECT_GE(solver.stats().re_searches, 1);
+  EXPECT_GT(solver.stats().nodes(), 0);
+}
+
+TEST_F(_search_stats, mws_binary_search_skat) {
+  auto game = create_random_skat_game(4, 2);
+  minimal_window_search mws(game, mws_unordered_table<skat>{}, std::less<skat::move_type>{}, search_stats{});
+  auto [value, move] = mws_binary_search(mws);
+  auto const& stats = mws.stats();
+  GOLV_LOG_DEBUG("stats = " << stats);
+  EXPECT_EQ(value, mws_binary_search(game).first);
+  EXPECT_EQ(stats.re_searches, 6);  // binary search on [0, 120]
+  EXPECT_EQ(stats.nodes_per_depth[0], 7);
+  EXPECT_GT(stats.tt_probes, 0);
+  EXPECT_GT(stats.first_move_cutoff_rate(), 0.0);
+}
+
+TEST_F(_search_stats, cfr_kuhn) {
+  cfr<kuhn, search_stats> solver{kuhn{}};
+  solver.solve_public_tree(10);
+  auto const& stats = solver.stats();
+  GOLV_LOG_DEBUG("stats = " << stats);
+  // one walk per player and iteration
+  EXPECT_EQ(stats.nodes_per_depth[0], 20);
+  EXPECT_GT(stats.depth(), 1);
+  EXPECT_EQ(stats.cutoffs(), 0);
+}
@@ -22,6 +22,20 @@ TEST(bridge, create_deck)
   ASSERT_EQ(deck.size(), 13 * 4);
 }
 
+TEST(bridge, compact_card) {
+  static_assert(sizeof(card) == 1);
+  static_assert(card(kind::queen, suit::hearts).get_kind() == kind::queen);
+  static_assert(card(kind::queen, suit::hearts).get_suit() == suit::hearts);
+
+  auto deck = create_bridge_deck();
+  for (auto const& c : deck) {
+    EXPECT_EQ(card::from_index(c.index()), c);
+    EXPECT_EQ(card(to_string(c).c_str()), c);
+    EXPECT_EQ(c.code().count(), 1);
+  }
+  EXPECT_EQ(to_string(card{}), "--");
+}
+
 TEST(bridge, card_order) {
   bridge_card_order less{suit::spades};
 
@@ -43,6 +57,26 @@ TEST(bridge, card_order) {
   ASSERT_TRUE(less(Ac, Ks));
 }
 
+TEST(bridge, card_order_strain) {
+  bridge_card_order hearts{suit::spades, strain::hearts};
+  EXPECT_TRUE(hearts("As", "2h"));  // trump beats the lead suit
+  EXPECT_TRUE(hearts("Kh", "Ah"));
+  EXPECT_TRUE(hearts("Ac", "Ks"));
+  EXPECT_FALSE(hearts("2h", "Ad"));
+
+  // the ranks are a total order on the deck for every strain and lead suit
+  for (int t = 0; t < 5; ++t) {
+    for (int s = 0; s < 4; ++s) {
+      bridge_card_order order{static_cast<suit>(s), static_cast<strain>(t)};
+      auto deck = create_bridge_deck();
+      std::sort(deck.begin(), deck.end(), order);
+      EXPECT_EQ(std::adjacent_find(deck.begin(), deck.end(),
+                                   [&](card l, card r) { return order.rank(l) == order.rank(r); }),
+                deck.end());
+    }
+  }
+}
+
 TEST(bridge, state)
 {
     auto game = create_game();
@@ -213,4 +247,40 @@ TEST(bridge, undo)
     moves.pop_back();
     ASSERT_EQ(game.legal_actions().size(), 3);
     ASSERT_TRUE(game.tricks().size() == 1 && game.tricks().back().cards_.empty());
-}
\ No newline at end of file
+}
+
+TEST(bridge, trick_counts)
+{
+  auto game = default_game_13();
+  ASSERT_EQ(game.total_value(), 13);
+  std::vector<bridge::move_type> moves;
+  while (!game.is_terminal()) {
+    moves.push_back(game.legal_actions().front());
+    game.apply_action(moves.back());
+    // every completed trick is counted for one side
+    ASSERT_EQ(game.value() + game.opp_value(), static_cast<int>(game.tricks().size()) - 1);
+  }
+  ASSERT_EQ(game.value() + game.opp_value(), game.total_value());
+  while (!moves.empty()) {
+    game.undo_action(moves.back());
+    moves.pop_back();
+  }
+  ASSERT_EQ(game.value(), 0);
+  ASSERT_EQ(game.opp_value(), 0);
+}
+
+TEST(bridge, trump_wins_trick)
+{
+  bridge game;
+  game.deal({ hand{ "Kh", "As" }, hand{ "Ac", "Qs" }, hand{ "Ad", "Js" }, hand{ "2c", "Ah" } });
+  game.set_strain(strain::hearts);
+  ASSERT_EQ(game.get_strain(), strain::hearts);
+  for (card c : { "As", "Qs", "Js" })
+    game.apply_action(c);
+  // west is void in spades and may ruff
+  ASSERT_EQ(game.legal_actions().size(), 2);
+  game.apply_action("Ah");
+  ASSERT_EQ(game.current_player(), 3);
+  ASSERT_EQ(game.value(), 0);
+  ASSERT_EQ(game.opp_value(), 1);
+}
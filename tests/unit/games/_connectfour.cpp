@@ -4,6 +4,40 @@
 
 using namespace golv;
 
+namespace {
+
+/**
+ * A row of four from every column that can start one is a win, for yellow in the bottom row and for red
+ * after yellow stacked three pieces in another column.
+ */
+template <class GameT>
+void expect_rows_from_every_start()
+{
+    using move_type = typename GameT::move_type;
+    for (move_type s = 0; s + 4 <= GameT::width; ++s) {
+        GameT yellow;
+        for (move_type m : { s, s, s + 1, s + 1, s + 2, s + 2 }) {
+            yellow.apply_action(m);
+            ASSERT_FALSE(yellow.is_terminal()) << "start = " << s;
+        }
+        yellow.apply_action(s + 3);
+        ASSERT_TRUE(yellow.is_terminal()) << "start = " << s;
+        ASSERT_EQ(yellow.value(), 1) << "start = " << s;
+
+        GameT red;
+        move_type const other = s == 0 ? GameT::width - 1 : 0;
+        for (move_type m : { other, s, other, s + 1, other, s + 2, s }) {
+            red.apply_action(m);
+            ASSERT_FALSE(red.is_terminal()) << "start = " << s;
+        }
+        red.apply_action(s + 3);
+        ASSERT_TRUE(red.is_terminal()) << "start = " << s;
+        ASSERT_EQ(red.value(), -1) << "start = " << s;
+    }
+}
+
+} // namespace
+
 TEST(connectfour, initial_state)
 {
     connectfour game;
@@ -171,4 +205,46 @@ TEST(connectfour, legal_actions)
 }
 
 // TODO!
-TEST(connectfour, tie) { }
\ No newline at end of file
+TEST(connectfour, tie) { }
+TEST(connectfour, terminal_row_off_center)
+{
+    connectfour game;
+    for (connectfour::move_type m : { 1, 1, 2, 2, 3, 3 }) {
+        game.apply_action(m);
+        ASSERT_EQ(game.is_terminal(), false);
+    }
+    game.apply_action(4);
+    ASSERT_EQ(game.is_terminal(), true);
+    ASSERT_EQ(game.value(), 1);
+}
+
+TEST(connectfour, terminal_row_every_start)
+{
+    // the rows of columns 1-4 and 2-5 were missed by the old check of the board halves
+    expect_rows_from_every_start<connectfour>();
+    expect_rows_from_every_start<basic_connectfour<5, 4>>();
+}
+
+TEST(connectfour, small_board)
+{
+    basic_connectfour<5, 4> game;
+    ASSERT_EQ(game.legal_actions().size(), 5);
+    for (basic_connectfour<5, 4>::move_type m : { 0, 0, 1, 1, 2, 2 }) {
+        game.apply_action(m);
+        ASSERT_EQ(game.is_terminal(), false);
+    }
+    game.apply_action(3);
+    ASSERT_EQ(game.is_terminal(), true);
+    ASSERT_EQ(game.value(), 1);
+}
+
+TEST(connectfour, position_index)
+{
+    connectfour game;
+    ASSERT_EQ(game.position_index(), 0x40810204081ULL);  // the height marks of the empty columns
+    for (connectfour::move_type m : { 3, 3, 2, 4, 6, 0, 3 }) game.apply_action(m);
+    auto const copy = connectfour::from_position_index(game.position_index());
+    ASSERT_EQ(copy.state(), game.state());
+    ASSERT_EQ(copy.current_player(), game.current_player());
+    ASSERT_EQ(copy.position_index(), game.position_index());
+}
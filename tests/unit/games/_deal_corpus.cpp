@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <golv/games/deal_corpus.hpp>
+#include <golv/util/test_utils.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+#include "../util/temp_file.hpp"
+
+using namespace golv;
+
+class deal_corpus_file : public temp_file_test {
+ protected:
+  void SetUp() override {
+    temp_file_test::SetUp();
+    results_path_ = path_ + ".results";
+  }
+
+  void TearDown() override {
+    temp_file_test::TearDown();
+    std::filesystem::remove(results_path_);
+  }
+
+  std::string results_path_;
+};
+
+TEST_F(deal_corpus_file, bridge) {
+  std::vector<bridge::internal_state_type> deals;
+  {
+    deal_corpus_writer writer(path_, corpus_game::bridge);
+    for (std::uint64_t seed = 1; seed <= 10; ++seed) {
+      deals.push_back(deal_bridge_hands(shuffle_deck(create_bridge_deck(), seed), 13));
+      writer.append(deals.back());
+    }
+    EXPECT_EQ(writer.size(), 10);
+  }
+  EXPECT_EQ(std::filesystem::file_size(path_), sizeof(deal_corpus_header) + 10 * 13);
+
+  deal_corpus corpus(path_);
+  EXPECT_EQ(corpus.game(), corpus_game::bridge);
+  ASSERT_EQ(corpus.size(), 10);
+  size_t i = 0;
+  for (auto record : corpus) {
+    auto hands = record.bridge_hands();
+    for (size_t p = 0; p < hands.size(); ++p) {
+      EXPECT_EQ(hand_to_mask(hands[p]), hand_to_mask(deals[i][p]));
+    }
+    ++i;
+  }
+  EXPECT_EQ(i, 10);
+  // the ace of spades is the first card of the deck
+  auto const& hands = deals[3];
+  auto const owner = std::find_if(hands.begin(), hands.end(), [](auto const& h) {
+    return std::find(h.begin(), h.end(), card("As")) != h.end();
+  });
+  EXPECT_EQ(corpus[3].owner(0), owner - hands.begin());
+  EXPECT_THROW(corpus[0].skat_hands(), golv::exception);
+  EXPECT_EQ(corpus.at(9).masks(), corpus[9].masks());
+  EXPECT_THROW(corpus.at(10), golv::exception);
+}
+
+TEST_F(deal_corpus_file, skat_from_generator) {
+  deal_generator generator(deal_spec::skat(trump::grand));
+  std::vector<deal_generator::deal_type> deals(100);
+  generator.generate(deals, 1, 2);
+  {
+    deal_corpus_writer writer(path_, corpus_game::skat);
+    for (auto const& d : deals) writer.append(d);
+  }
+  deal_corpus corpus(path_);
+  ASSERT_EQ(corpus.size(), deals.size());
+  for (size_t i = 0; i < deals.size(); ++i) {
+    EXPECT_EQ(corpus[i].masks(), deals[i]);
+    EXPECT_EQ(corpus[i].skat_hands()[3].size(), 2);
+  }
+}
+
+TEST_F(deal_corpus_file, invalid) {
+  {
+    deal_corpus_writer writer(path_, corpus_game::skat);
+    auto deal = deal_generator(deal_spec::skat(trump::grand)).spec().deck;
+    EXPECT_THROW(writer.append(deal_generator::deal_type{deal, deal, 0, 0}), golv::exception);
+    EXPECT_THROW(writer.append(deal_generator::deal_type{deal >> 1, 0, 0, 0}), golv::exception);
+  }
+  EXPECT_EQ(deal_corpus(path_).size(), 0);
+
+  {
+    // a file of a machine with the other byte order
+    std::fstream file(path_, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offsetof(deal_corpus_header, byte_order));
+    std::uint32_t const swapped = 0x04030201;
+    file.write(reinterpret_cast<char const*>(&swapped), sizeof(swapped));
+  }
+  EXPECT_THROW(deal_corpus{path_}, golv::exception);
+
+  {
+    // a count whose size in bytes overflows
+    std::fstream file(path_, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offsetof(deal_corpus_header, byte_order));
+    file.write(reinterpret_cast<char const*>(&deal_corpus_header::byte_order_mark), sizeof(std::uint32_t));
+    file.seekp(offsetof(deal_corpus_header, count));
+    std::uint64_t const count = std::numeric_limits<std::uint64_t>::max() / corpus_record_size(corpus_game::skat) + 1;
+    file.write(reinterpret_cast<char const*>(&count), sizeof(count));
+  }
+  EXPECT_THROW(deal_corpus{path_}, golv::exception);
+
+  std::filesystem::resize_file(path_, 4);
+  EXPECT_THROW(deal_corpus{path_}, golv::exception);
+  EXPECT_THROW(deal_corpus{path_ + ".missing"}, golv::exception);
+}
+
+TEST_F(deal_corpus_file, results) {
+  constexpr size_t rows = 10;
+  {
+    corpus_results_writer writer(results_path_, 4);
+    for (size_t i = 0; i < rows; ++i) {
+      writer.append({static_cast<std::int16_t>(i * 7), card::from_index(static_cast<card::index_type>(i)), i << 40});
+    }
+    writer.append({-1, card{}, 0});
+  }
+  corpus_results results(results_path_);
+  ASSERT_EQ(results.size(), rows + 1);
+  for (size_t i = 0; i < rows; ++i) {
+    EXPECT_EQ(results[i].value, i * 7);
+    EXPECT_EQ(results[i].best_move, card::from_index(static_cast<card::index_type>(i)));
+    EXPECT_EQ(results[i].nodes, i << 40);
+  }
+  EXPECT_EQ(results[rows].value, -1);
+  EXPECT_EQ(results[rows].best_move, card{});
+  EXPECT_EQ(results.at(rows).value, -1);
+  EXPECT_THROW(results.at(rows + 1), golv::exception);
+
+  auto const patch = [this](size_t offset, auto const& value) {
+    std::fstream file(results_path_, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(reinterpret_cast<char const*>(&value), sizeof(value));
+  };
+  // the best move of row 0: behind the nodes and values of the first block of 4 rows
+  auto const move_offset = sizeof(corpus_results_header) + 4 * (sizeof(std::uint64_t) + sizeof(std::int16_t));
+  patch(move_offset, static_cast<std::uint8_t>(detail::no_card + 1));
+  EXPECT_THROW(corpus_results{results_path_}.at(0), golv::exception);
+  patch(move_offset, static_cast<std::uint8_t>(detail::no_card));
+  EXPECT_EQ(corpus_results{results_path_}.at(0).best_move, card{});
+
+  // a count whose blocks (48 bytes per 4 rows) overflow the size in bytes
+  patch(offsetof(corpus_results_header, count), std::uint64_t{1} << 62);
+  EXPECT_THROW(corpus_results{results_path_}, golv::exception);
+
+  std::filesystem::resize_file(results_path_, 64);
+  EXPECT_THROW(corpus_results{results_path_}, golv::exception);
+}
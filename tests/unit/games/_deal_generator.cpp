@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <golv/games/deal_generator.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <map>
+
+using namespace golv;
+
+namespace {
+
+int high_card_points(std::uint64_t cards) {
+  int hcp = 0;
+  for (auto c : mask_to_hand(cards)) {
+    if (c.get_kind() <= kind::jack) hcp += 4 - static_cast<int>(c.get_kind());
+  }
+  return hcp;
+}
+
+int length(std::uint64_t cards, suit s) { return std::popcount(cards & (std::uint64_t{0x1fff} << (13 * static_cast<int>(s)))); }
+
+/**
+ * Two holders of two cards each from four cards.
+ */
+deal_spec small_spec() {
+  deal_spec spec;
+  spec.deck = hand_to_mask(to_hand("AsKsAhKh"));
+  spec.groups = {hand_to_mask(to_hand("AsKs")), hand_to_mask(to_hand("AhKh"))};
+  for (auto c : to_hand("AsAh")) spec.points[c.index()] = 4;
+  for (auto c : to_hand("KsKh")) spec.points[c.index()] = 3;
+  spec.holders.assign(2, deal_spec::holder{.size = 2});
+  return spec;
+}
+
+}  // namespace
+
+TEST(deal_generator, masks) {
+  auto cards = to_hand("AsTh2c");
+  EXPECT_EQ(mask_to_hand(hand_to_mask(cards)), cards);
+  EXPECT_EQ(std::popcount(hand_to_mask(create_bridge_deck())), 52);
+}
+
+TEST(deal_generator, bridge_unconstrained) {
+  deal_generator generator(deal_spec::bridge());
+  EXPECT_NEAR(generator.count(), 5.3644737765488792839237440000e28, 1e14);
+  std::mt19937_64 rng(1);
+  for (int i = 0; i < 100; ++i) {
+    auto deal = generator.sample(rng);
+    std::uint64_t all = 0;
+    for (auto h : deal) {
+      EXPECT_EQ(std::popcount(h), 13);
+      EXPECT_EQ(all & h, 0);
+      all |= h;
+    }
+    EXPECT_EQ(all, generator.spec().deck);
+  }
+}
+
+TEST(deal_generator, bridge_constraints) {
+  auto spec = deal_spec::bridge();
+  spec.holders[0].fixed = hand_to_mask(to_hand("AsKsAh"));
+  spec.holders[1].set_void(static_cast<int>(suit::clubs));
+  spec.holders[2].min_length[static_cast<int>(suit::hearts)] = 5;
+  spec.holders[2].min_points = 12;
+  spec.holders[2].max_points = 14;
+  spec.holders[3].max_points = 3;
+  deal_generator generator(spec);
+  EXPECT_GT(generator.count(), 0);
+  std::mt19937_64 rng(2);
+  for (int i = 0; i < 200; ++i) {
+    auto deal = generator.sample(rng);
+    EXPECT_EQ(deal[0] & spec.holders[0].fixed, spec.holders[0].fixed);
+    EXPECT_EQ(length(deal[1], suit::clubs), 0);
+    EXPECT_GE(length(deal[2], suit::hearts), 5);
+    EXPECT_GE(high_card_points(deal[2]), 12);
+    EXPECT_LE(high_card_points(deal[2]), 14);
+    EXPECT_LE(high_card_points(deal[3]), 3);
+    EXPECT_EQ(deal[0] | deal[1] | deal[2] | deal[3], spec.deck);
+  }
+}
+
+TEST(deal_generator, uniform) {
+  // holder 0 has at least 7 points: 5 of the 6 deals
+  auto spec = small_spec();
+  spec.holders[0].min_points = 7;
+  deal_generator generator(spec);
+  EXPECT_EQ(generator.count(), 5);
+  std::map<std::uint64_t, int> frequencies;
+  std::mt19937_64 rng(3);
+  constexpr int n = 10000;
+  for (int i = 0; i < n; ++i) ++frequencies[generator.sample(rng)[0]];
+  EXPECT_EQ(frequencies.size(), 5);
+  EXPECT_EQ(frequencies.count(hand_to_mask(to_hand("KsKh"))), 0);
+  for (auto [deal, f] : frequencies) EXPECT_NEAR(f, n / 5, 150) << to_string(mask_to_hand(deal));
+
+  // a void in spades: holder 0 gets the hearts
+  spec = small_spec();
+  spec.holders[0].set_void(0);
+  deal_generator forced(spec);
+  EXPECT_EQ(forced.count(), 1);
+  EXPECT_EQ(forced.sample(rng)[0], hand_to_mask(to_hand("AhKh")));
+}
+
+TEST(deal_generator, count_like_enumeration) {
+  // eight honors to four holders of two cards
+  deal_spec spec = deal_spec::bridge();
+  spec.deck = hand_to_mask(to_hand("AsKsQsJsAhKhQhJh"));
+  for (auto& g : spec.groups) g &= spec.deck;
+  spec.holders.assign(4, deal_spec::holder{.size = 2});
+  spec.holders[0].min_points = 5;
+  spec.holders[1].max_length[static_cast<int>(suit::spades)] = 1;
+  spec.holders[2].fixed = hand_to_mask(to_hand("Jh"));
+  deal_generator generator(spec);
+
+  auto const cards = mask_to_hand(spec.deck);
+  auto const satisfies = [&](deal_generator::deal_type const& deal) {
+    return high_card_points(deal[0]) >= 5 && length(deal[1], suit::spades) <= 1 && (deal[2] & spec.holders[2].fixed);
+  };
+  int expected = 0;
+  for (int code = 0; code < (1 << 16); ++code) {
+    deal_generator::deal_type deal{};
+    for (size_t i = 0; i < cards.size(); ++i) deal[(code >> (2 * i)) & 3] |= hand_to_mask({cards[i]});
+    if (std::all_of(deal.begin(), deal.end(), [](auto h) { return std::popcount(h) == 2; }) && satisfies(deal)) {
+      ++expected;
+    }
+  }
+  EXPECT_EQ(generator.count(), expected);
+
+  std::mt19937_64 rng(6);
+  for (int i = 0; i < 100; ++i) EXPECT_TRUE(satisfies(generator.sample(rng)));
+}
+
+TEST(deal_generator, impossible) {
+  auto spec = small_spec();
+  spec.holders[0].set_void(0);
+  spec.holders[1].set_void(0);
+  EXPECT_THROW(deal_generator{spec}, golv::exception);
+  spec = small_spec();
+  spec.holders[0].size = 3;
+  EXPECT_THROW(deal_generator{spec}, golv::exception);
+}
+
+TEST(deal_generator, skat_trumps) {
+  auto spec = deal_spec::skat(trump::hearts);
+  spec.holders[1].set_void(4);
+  deal_generator generator(spec);
+  std::mt19937_64 rng(4);
+  for (int i = 0; i < 100; ++i) {
+    for (auto c : mask_to_hand(generator.sample(rng)[1])) {
+      EXPECT_NE(c.get_kind(), kind::jack);
+      EXPECT_NE(c.get_suit(), suit::hearts);
+    }
+  }
+}
+
+TEST(deal_generator, generate_independent_of_threads) {
+  auto spec = deal_spec::bridge();
+  spec.holders[0].min_points = 15;
+  deal_generator generator(spec);
+  std::vector<deal_generator::deal_type> single(1000), pool(1000);
+  generator.generate(single, 5, 1);
+  generator.generate(pool, 5, 3);
+  EXPECT_EQ(single, pool);
+  for (auto const& deal : single) EXPECT_GE(high_card_points(deal[0]), 15);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <golv/algorithms/alphabeta.hpp>
+#include <golv/games/double_dummy.hpp>
+#include <golv/util/exception.hpp>
+#include <golv/util/logging.hpp>
+#include <golv/util/test_utils.hpp>
+
+using namespace golv;
+
+namespace {
+
+/**
+ * Tricks of the declarer's side computed with the generic solver, the bridge game lets player 0 lead.
+ */
+int alphabeta_tricks(bridge::internal_state_type deal, bridge::player_type declarer, strain s = strain::notrump) {
+  std::rotate(deal.begin(), deal.begin() + (declarer + 1) % 4, deal.end());
+  bridge game;
+  game.deal(deal);
+  game.set_soloist(3);
+  game.set_strain(s);
+  return alphabeta_with_memory(game).first;
+}
+
+bridge::internal_state_type suits_deal() {
+  bridge::internal_state_type deal;
+  for (int s = 0; s < 4; ++s) {
+    for (int k = 0; k < 13; ++k) deal[s].push_back(card{static_cast<kind>(k), static_cast<suit>(s)});
+  }
+  return deal;
+}
+
+}  // namespace
+
+TEST(double_dummy, notrump_like_alphabeta) {
+  for (size_t cards = 3; cards <= 5; ++cards) {
+    for (std::uint64_t seed = 1; seed <= 5; ++seed) {
+      auto deal = deal_bridge_hands(shuffle_deck(create_bridge_deck(), seed), cards);
+      for (bridge::player_type declarer = 0; declarer < 4; ++declarer) {
+        EXPECT_EQ(solve_double_dummy(deal, declarer, strain::notrump), alphabeta_tricks(deal, declarer))
+            << "cards = " << cards << " seed = " << seed << " declarer = " << declarer;
+      }
+    }
+  }
+}
+
+TEST(double_dummy, trumps_like_alphabeta) {
+  for (size_t cards = 3; cards <= 5; ++cards) {
+    for (std::uint64_t seed = 1; seed <= 3; ++seed) {
+      auto deal = deal_bridge_hands(shuffle_deck(create_bridge_deck(), seed), cards);
+      for (auto s : {strain::spades, strain::hearts, strain::diamonds, strain::clubs}) {
+        for (bridge::player_type declarer = 0; declarer < 4; ++declarer) {
+          EXPECT_EQ(solve_double_dummy(deal, declarer, s), alphabeta_tricks(deal, declarer, s))
+              << "cards = " << cards << " seed = " << seed << " strain = " << static_cast<int>(s)
+              << " declarer = " << declarer;
+        }
+      }
+    }
+  }
+}
+
+TEST(double_dummy, trumps) {
+  // north holds all spades, east all hearts, south all diamonds, west all clubs
+  auto deal = suits_deal();
+  EXPECT_EQ(solve_double_dummy(deal, 0, strain::notrump), 0);
+  EXPECT_EQ(solve_double_dummy(deal, 0, strain::spades), 13);
+  EXPECT_EQ(solve_double_dummy(deal, 2, strain::spades), 13);
+  EXPECT_EQ(solve_double_dummy(deal, 0, strain::hearts), 0);
+  EXPECT_EQ(solve_double_dummy(deal, 1, strain::hearts), 13);
+}
+
+TEST(double_dummy, full_deal) {
+  auto deal = deal_bridge_hands(shuffle_deck(create_bridge_deck(), 1), 13);
+  double_dummy_solver solver(strain::notrump);
+  auto tricks = solver.solve(deal, 0);
+  GOLV_LOG_DEBUG("tricks = " << tricks << " nodes = " << solver.nodes() << " table = " << solver.table().size());
+  EXPECT_GE(tricks, 0);
+  EXPECT_LE(tricks, 13);
+  EXPECT_TRUE(solver.can_make(deal, 0, tricks));
+  EXPECT_FALSE(solver.can_make(deal, 0, tricks + 1));
+  // the table is keyed by relative ranks, a warm table gives the same result
+  EXPECT_EQ(solver.solve(deal, 0), tricks);
+  EXPECT_EQ(solve_double_dummy(deal, 0, strain::notrump), tricks);
+}
+
+TEST(double_dummy, small_table) {
+  // a full table drops the entries of the previous searches and the shallow ones, the results stay
+  for (std::uint64_t seed = 1; seed <= 3; ++seed) {
+    auto deal = deal_bridge_hands(shuffle_deck(create_bridge_deck(), seed), 8);
+    for (auto s : {strain::notrump, strain::hearts}) {
+      double_dummy_solver solver(s, 256);
+      for (bridge::player_type declarer = 0; declarer < 4; ++declarer) {
+        EXPECT_EQ(solver.solve(deal, declarer), solve_double_dummy(deal, declarer, s))
+            << "seed = " << seed << " strain = " << static_cast<int>(s) << " declarer = " << declarer;
+        EXPECT_LE(solver.table().size(), solver.table().capacity());
+      }
+    }
+  }
+}
+
+TEST(double_dummy, dd_table_like_solve) {
+  auto deal = deal_bridge_hands(shuffle_deck(create_bridge_deck(), 2), 6);
+  auto result = dd_table(deal, vulnerability::none, 2);
+  for (int s = 0; s < 5; ++s) {
+    for (bridge::player_type declarer = 0; declarer < 4; ++declarer) {
+      EXPECT_EQ(result.tricks[s][declarer], solve_double_dummy(deal, declarer, static_cast<strain>(s)))
+          << "strain = " << s << " declarer = " << declarer;
+    }
+  }
+  EXPECT_EQ(result.par_score, 0);
+
+  // the strains are independent tasks of parallel_for
+  for (size_t threads : {1, 5}) {
+    auto other = dd_table(deal, vulnerability::none, threads);
+    EXPECT_EQ(other.tricks, result.tricks) << "threads = " << threads;
+  }
+}
+
+TEST(double_dummy, par_score) {
+  // north/south make 7S, the sacrifice 7NT doubled costs 3500
+  auto result = dd_table(suits_deal());
+  EXPECT_EQ(result.tricks[static_cast<int>(strain::spades)][0], 13);
+  EXPECT_EQ(result.tricks[static_cast<int>(strain::hearts)][1], 13);
+  EXPECT_EQ(result.par_score, 1510);
+  EXPECT_EQ(par_score(result.tricks, vulnerability::north_south), 2210);
+
+  // north/south make 4S (420), east/west 1H
+  std::array<std::array<int, 4>, 5> tricks{};
+  for (auto& t : tricks) t = {6, 6, 6, 6};
+  tricks[static_cast<int>(strain::spades)] = {10, 3, 10, 3};
+  tricks[static_cast<int>(strain::hearts)] = {6, 7, 6, 7};
+  EXPECT_EQ(par_score(tricks), 420);
+  // east/west make 3H and sacrifice in 5H doubled down two
+  tricks[static_cast<int>(strain::hearts)] = {4, 9, 4, 9};
+  EXPECT_EQ(par_score(tricks), 300);
+  EXPECT_EQ(par_score(tricks, vulnerability::east_west), 420);
+  // no side makes a contract
+  for (auto& t : tricks) t = {6, 6, 6, 6};
+  EXPECT_EQ(par_score(tricks), 0);
+}
+
+TEST(double_dummy, invalid_deal) {
+  auto deal = suits_deal();
+  deal[0].pop_back();
+  EXPECT_THROW(solve_double_dummy(deal, 0, strain::notrump), golv::exception);
+  deal[0].push_back(deal[1].front());
+  EXPECT_THROW(solve_double_dummy(deal, 0, strain::notrump), golv::exception);
+  EXPECT_THROW(solve_double_dummy(suits_deal(), 4, strain::notrump), golv::exception);
+  EXPECT_THROW(dd_table(deal), golv::exception);
+}
@@ -152,4 +152,21 @@ TEST(kuhn_, value_all) {
       test_value_calculation(card1, card2, "xbc", 1, card1 > card2 ? -2 : 2);  // Player 1 calls
     }
   }
-}
\ No newline at end of file
+}
+TEST(kuhn_, public_tree) {
+  for (std::string actions : {"xx", "bf", "xbf", "bc", "xbc"}) {
+    kuhn game;
+    game.begin_public_tree();
+    for (auto a : actions) game.apply_action(a);
+    ASSERT_TRUE(game.is_terminal());
+    for (int card1 = 0; card1 < kuhn::num_hands; ++card1) {
+      for (int card2 = 0; card2 < kuhn::num_hands; ++card2) {
+        if (!kuhn::hands_compatible(card1, card2)) continue;
+        kuhn dealt;
+        dealt.deal(card1, card2);
+        for (auto a : actions) dealt.apply_action(a);
+        EXPECT_EQ(game.payoff(card1, card2), dealt.value()) << actions;
+      }
+    }
+  }
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <golv/games/leduc.hpp>
+#include <set>
+
+using namespace golv;
+
+TEST(leduc_, initial_state) {
+  leduc game;
+  EXPECT_TRUE(game.is_chance_node());
+  EXPECT_FALSE(game.is_terminal());
+  EXPECT_THROW(game.legal_actions(), std::logic_error);
+}
+
+TEST(leduc_, handle_chance_node) {
+  leduc game;
+  game.handle_chance_node();
+  EXPECT_FALSE(game.is_chance_node());
+  EXPECT_EQ(game.current_player(), 0);
+  EXPECT_NE(game.private_card(0), game.private_card(1));
+  EXPECT_EQ(game.legal_actions(), "cr");
+}
+
+TEST(leduc_, first_round) {
+  leduc game;
+  game.deal(0, 5);
+  game.apply_action('r');
+  EXPECT_EQ(game.current_player(), 1);
+  EXPECT_EQ(game.pot(0), 3);
+  EXPECT_EQ(game.legal_actions(), "fcr");
+  game.apply_action('r');
+  EXPECT_EQ(game.pot(1), 5);
+  EXPECT_EQ(game.legal_actions(), "fc");  // at most two raises
+  game.apply_action('c');
+  EXPECT_TRUE(game.is_chance_node());
+  EXPECT_EQ(game.round(), 1);
+  EXPECT_EQ(game.pot(0), 5);
+}
+
+TEST(leduc_, public_card) {
+  leduc game;
+  game.deal(0, 5);
+  game.apply_action('c');
+  game.apply_action('c');
+  ASSERT_TRUE(game.is_chance_node());
+  EXPECT_THROW(game.deal_public(5), golv::exception);
+  for (int i = 0; i < 100; ++i) {
+    game.handle_chance_node();
+    EXPECT_NE(game.public_card(), 0);
+    EXPECT_NE(game.public_card(), 5);
+    EXPECT_EQ(game.current_player(), 0);
+    // undo of the last action of the first round removes the public card again
+    game.undo_action('c');
+    EXPECT_EQ(game.public_card(), -1);
+    game.apply_action('c');
+  }
+}
+
+TEST(leduc_, second_round_bet_size) {
+  leduc game;
+  game.deal(0, 5);
+  game.apply_action('c');
+  game.apply_action('c');
+  game.deal_public(2);
+  game.apply_action('c');
+  game.apply_action('r');
+  EXPECT_EQ(game.pot(1), 5);
+  game.apply_action('r');
+  EXPECT_EQ(game.pot(0), 9);
+  game.apply_action('c');
+  EXPECT_TRUE(game.is_terminal());
+  // K beats J
+  EXPECT_EQ(game.value(), -9);
+  game.set_max(1);
+  EXPECT_EQ(game.value(), 9);
+}
+
+TEST(leduc_, value_fold) {
+  leduc game;
+  game.deal(4, 0);
+  game.apply_action('r');
+  game.apply_action('f');
+  EXPECT_TRUE(game.is_terminal());
+  EXPECT_EQ(game.value(), 1);
+  game.set_max(1);
+  EXPECT_EQ(game.value(), -1);
+}
+
+TEST(leduc_, value_pair) {
+  leduc game;
+  game.deal(0, 5);
+  game.apply_action('c');
+  game.apply_action('c');
+  game.deal_public(1);  // J pairs with the public card and beats K
+  game.apply_action('c');
+  game.apply_action('c');
+  EXPECT_TRUE(game.is_terminal());
+  EXPECT_EQ(game.value(), 1);
+}
+
+TEST(leduc_, value_tie) {
+  leduc game;
+  game.deal(2, 3);
+  game.apply_action('c');
+  game.apply_action('c');
+  game.deal_public(0);
+  game.apply_action('r');
+  game.apply_action('c');
+  EXPECT_TRUE(game.is_terminal());
+  EXPECT_EQ(game.value(), 0);
+}
+
+TEST(leduc_, undo_action) {
+  leduc game;
+  game.deal(1, 2);
+  auto const before = game.state();
+  game.apply_action('r');
+  EXPECT_THROW(game.undo_action('c'), golv::exception);
+  game.undo_action('r');
+  EXPECT_EQ(game.state(), before);
+  EXPECT_EQ(game.current_player(), 0);
+  EXPECT_EQ(game.pot(0), 1);
+}
+
+TEST(leduc_, invalid_action) {
+  leduc game;
+  game.deal(0, 1);
+  EXPECT_THROW(game.apply_action('f'), golv::exception);
+  EXPECT_THROW(game.apply_action('z'), golv::exception);
+}
+
+TEST(leduc_, information_set) {
+  leduc game;
+  game.deal(0, 2);
+  // suits are not part of the information set
+  EXPECT_EQ(game.information_set(0), game.information_set(1));
+  EXPECT_NE(game.information_set(0), game.information_set(2));
+
+  std::set<leduc::information_set_type> seen{game.state()};
+  game.apply_action('c');
+  EXPECT_TRUE(seen.insert(game.state()).second);
+  game.apply_action('r');
+  EXPECT_TRUE(seen.insert(game.state()).second);
+  game.apply_action('c');
+  game.deal_public(4);
+  EXPECT_TRUE(seen.insert(game.state()).second);
+}
+
+TEST(leduc_, chance_node_state) {
+  leduc game;
+  auto const initial = game.state();
+  game.deal(0, 2);
+  auto const first = game.state();
+  EXPECT_NE(initial, first);
+  game.apply_action('c');
+  game.apply_action('c');
+  ASSERT_TRUE(game.is_chance_node());
+  // differs from the information sets of all private cards in the same public state
+  for (int card = 0; card < leduc::num_cards; ++card) EXPECT_NE(game.state(), game.information_set(card));
+  EXPECT_NE(game.state(), initial);
+}
+
+TEST(leduc_, public_tree) {
+  leduc game;
+  game.begin_public_tree();
+  EXPECT_FALSE(game.is_chance_node());
+  EXPECT_EQ(game.current_player(), 0);
+  game.apply_action('c');
+  game.apply_action('c');
+  ASSERT_TRUE(game.is_chance_node());
+  EXPECT_EQ(game.public_outcomes().size(), 6);
+  game.deal_public(1);
+  EXPECT_FALSE(game.hand_possible(1));
+  EXPECT_TRUE(game.hand_possible(0));
+  EXPECT_EQ(game.information_set(0), game.information_set(1));
+  game.apply_action('r');
+  game.apply_action('c');
+  ASSERT_TRUE(game.is_terminal());
+  EXPECT_EQ(game.payoff(0, 5), 5);   // pair of jacks
+  EXPECT_EQ(game.payoff(5, 2), 5);   // king high
+  EXPECT_EQ(game.payoff(2, 3), 0);
+}
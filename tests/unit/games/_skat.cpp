@@ -1,9 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <golv/games/skat.hpp>
 #include <golv/util/logging.hpp>
 #include <golv/util/test_utils.hpp>
 #include <iostream>
+#include <sstream>
+#include <unordered_map>
 
 #include "../util/test_games.hpp"
 
@@ -115,12 +118,60 @@ TEST(skat, trick_winner) {
   ASSERT_EQ(game.value(), 10);
 }
 
+TEST(skat, undo_restores_hands) {
+  skat game = default_skat_game_10(0, 0, false);
+  game.declare(trump::hearts);
+  std::stringstream before;
+  before << game;
+
+  std::vector<card> moves;
+  while (!game.is_terminal()) {
+    moves.push_back(game.legal_actions().back());
+    game.apply_action(moves.back());
+  }
+  ASSERT_EQ(game.tricks().size(), 11);
+  for (auto it = moves.rbegin(); it != moves.rend(); ++it) game.undo_action(*it);
+
+  std::stringstream after;
+  after << game;
+  EXPECT_EQ(after.str(), before.str());
+  EXPECT_EQ(game.value(), 0);
+  EXPECT_EQ(game.opp_value(), 0);
+  EXPECT_THROW(game.undo_action(moves.front()), golv::exception);
+}
+
+TEST(skat, card_order) {
+  skat_card_order grand{suit::hearts};
+  EXPECT_TRUE(grand("Ah", "Jd"));  // jacks are trump
+  EXPECT_TRUE(grand("Jd", "Jc"));
+  EXPECT_TRUE(grand("Ac", "7h"));  // lead suit
+  EXPECT_TRUE(grand("Kh", "Th"));
+  EXPECT_TRUE(grand("Th", "Ah"));
+  EXPECT_TRUE(grand("Ad", "7c"));  // neither trump nor lead suit
+
+  skat_card_order spades{suit::hearts, trump::spades};
+  EXPECT_TRUE(spades("Ah", "7s"));
+  EXPECT_TRUE(spades("As", "Jd"));
+  EXPECT_FALSE(spades("7s", "Ah"));
+
+  // the ranks are a total order on the skat deck
+  for (int t = 0; t < 5; ++t) {
+    for (int s = 0; s < 4; ++s) {
+      skat_card_order order{static_cast<suit>(s), static_cast<trump>(t)};
+      auto deck = create_skat_deck();
+      std::sort(deck.begin(), deck.end(), order);
+      EXPECT_EQ(std::adjacent_find(deck.begin(), deck.end(),
+                                   [&](card l, card r) { return order.rank(l) == order.rank(r); }),
+                deck.end());
+    }
+  }
+}
+
 TEST(skat, trick_1) {
   golv::skat game = default_skat_game_10(1, 0);
   GOLV_LOG_DEBUG("game = " << game);
   game.apply_action("Ad");
   game.apply_action("Qd");
-  auto moves = game.legal_actions();
   game.apply_action("9d");
   auto winner = game.tricks().back().leader_;
   ASSERT_EQ(winner, 0);
@@ -136,7 +187,6 @@ TEST(skat, trick_1) {
 
 TEST(skat, legal_1) {
   golv::skat game = default_skat_game_10();
-  auto moves = game.legal_actions();
   GOLV_LOG_DEBUG("game = " << game);
   game.apply_action("Ac");
   auto legal = game.legal_actions();
@@ -152,7 +202,6 @@ TEST(skat, legal_1) {
 
 TEST(skat, legal_jack) {
   golv::skat game = default_skat_game_10(1);
-  auto moves = game.legal_actions();
   GOLV_LOG_DEBUG("game = " << game);
   game.apply_action("Jh");
   auto legal = game.legal_actions();
@@ -162,4 +211,134 @@ TEST(skat, legal_jack) {
   game.apply_action("Jd");
   legal = game.legal_actions();
   ASSERT_EQ(legal.size(), 10);
-}
\ No newline at end of file
+}
+
+namespace {
+
+/**
+ * A game with two cards per player, the soloist 0 pushes the skat (7d 8d) and leads.
+ */
+skat two_card_game(trump t, hand const& first, hand const& second, hand const& third) {
+  skat game;
+  game.deal(first, second, third, hand{"7d", "8d"});
+  game.set_soloist(0);
+  game.declare(t);
+  game.apply_action("7d");
+  game.apply_action("8d");
+  return game;
+}
+
+}  // namespace
+
+TEST(skat, trick_winner_suit_game) {
+  auto game = two_card_game(trump::hearts, {"Ac", "Jd"}, {"7h", "9s"}, {"Tc", "Jc"});
+  game.apply_action("Ac");
+  ASSERT_EQ(game.legal_actions().size(), 2);  // no clubs
+  game.apply_action("7h");
+  auto legal = game.legal_actions();
+  ASSERT_EQ(legal.size(), 1);  // the jack of the lead suit is a trump
+  EXPECT_EQ(legal.front(), "Tc");
+  game.apply_action("Tc");
+  EXPECT_EQ(game.tricks().back().leader_, 1);  // the trump suit beats the lead suit
+  EXPECT_EQ(game.opp_value(), 21);
+
+  game.apply_action("9s");
+  legal = game.legal_actions();
+  ASSERT_EQ(legal.size(), 1);
+  EXPECT_EQ(legal.front(), "Jc");
+  game.apply_action("Jc");
+  game.apply_action("Jd");
+  EXPECT_EQ(game.tricks().back().leader_, 2);
+  EXPECT_TRUE(game.is_terminal());
+
+  // in a grand, the lead suit wins the first trick
+  auto grand = two_card_game(trump::grand, {"Ac", "Jd"}, {"7h", "9s"}, {"Tc", "Jc"});
+  grand.apply_action("Ac");
+  grand.apply_action("7h");
+  grand.apply_action("Tc");
+  EXPECT_EQ(grand.tricks().back().leader_, 0);
+  EXPECT_EQ(grand.value(), 21);
+}
+
+TEST(skat, jack_against_trump_suit) {
+  // a led jack has to be followed with a card of the trump suit if there is no jack
+  auto game = two_card_game(trump::hearts, {"Jd", "Ah"}, {"7h", "Ac"}, {"Jc", "8s"});
+  game.apply_action("Jd");
+  auto legal = game.legal_actions();
+  ASSERT_EQ(legal.size(), 1);
+  EXPECT_EQ(legal.front(), "7h");
+  game.apply_action("7h");
+  legal = game.legal_actions();
+  ASSERT_EQ(legal.size(), 1);
+  EXPECT_EQ(legal.front(), "Jc");
+  game.apply_action("Jc");
+  EXPECT_EQ(game.tricks().back().leader_, 2);
+
+  // and a led card of the trump suit with a jack
+  auto suit_lead = two_card_game(trump::hearts, {"Ah", "Jd"}, {"Jc", "Ac"}, {"7h", "8s"});
+  suit_lead.apply_action("Ah");
+  legal = suit_lead.legal_actions();
+  ASSERT_EQ(legal.size(), 1);
+  EXPECT_EQ(legal.front(), "Jc");
+  suit_lead.apply_action("Jc");
+  suit_lead.apply_action("7h");
+  EXPECT_EQ(suit_lead.tricks().back().leader_, 1);
+}
+
+TEST(skat, undo_to_pushing) {
+  // undoing the first trick leaves an empty trick, which must not make the pushing positions new tricks
+  skat game;
+  game.deal(hand{"Ac", "Jd"}, hand{"7h", "9s"}, hand{"Tc", "Jc"}, hand{"7d", "8d"});
+  game.set_soloist(0);
+  auto const before = game.state();
+  game.apply_action("7d");
+  game.apply_action("8d");
+  auto const after_pushing = game.state();
+  for (auto c : {"Ac", "7h", "Tc"}) game.apply_action(c);
+  EXPECT_TRUE(game.hash_me());
+  for (auto c : {"Tc", "7h", "Ac"}) game.undo_action(c);
+  EXPECT_EQ(game.state(), after_pushing);
+
+  game.undo_action("8d");
+  EXPECT_FALSE(game.hash_me());
+  EXPECT_EQ(game.current_player(), 0);
+  EXPECT_EQ(game.legal_actions().size(), 3);
+  game.undo_action("7d");
+  EXPECT_FALSE(game.hash_me());
+  EXPECT_EQ(game.state(), before);
+  EXPECT_EQ(game.legal_actions().size(), 4);
+}
+
+namespace {
+
+/**
+ * Minimax value, checking that equal states at the start of a trick have equal remaining values.
+ */
+int checked_minimax(skat& game, std::unordered_map<skat::state_type, int>& remaining) {
+  if (game.is_terminal()) return game.value();
+  int best = game.is_max() ? -1 : 1000;
+  for (auto m : game.legal_actions()) {
+    game.apply_action(m);
+    int v = checked_minimax(game, remaining);
+    game.undo_action(m);
+    best = game.is_max() ? std::max(best, v) : std::min(best, v);
+  }
+  if (game.hash_me()) {
+    auto [it, inserted] = remaining.emplace(game.state(), best - game.value());
+    EXPECT_EQ(it->second, best - game.value()) << game;
+  }
+  return best;
+}
+
+}  // namespace
+
+TEST(skat, state_with_pushing) {
+  // the state tells the current player apart also if the same cards are left after different pushings
+  auto deck = shuffle_deck(create_skat_deck(), 3);
+  skat game;
+  game.deal(hand(deck.begin(), deck.begin() + 3), hand(deck.begin() + 3, deck.begin() + 6),
+            hand(deck.begin() + 6, deck.begin() + 9), hand{deck[9], deck[10]});
+  game.set_soloist(1);
+  std::unordered_map<skat::state_type, int> remaining;
+  EXPECT_EQ(checked_minimax(game, remaining), 35);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <golv/algorithms/mws.hpp>
+#include <golv/games/skat_declaration.hpp>
+#include <golv/util/test_utils.hpp>
+
+using namespace golv;
+
+namespace {
+
+skat deal_small_game(std::uint64_t seed, size_t cards_per_player) {
+  auto deck = shuffle_deck(create_skat_deck(), seed);
+  std::array<hand, skat::num_players + 1> hands;
+  for (size_t i = 0; i < skat::num_players; ++i) {
+    hands[i] = hand(deck.begin() + i * cards_per_player, deck.begin() + (i + 1) * cards_per_player);
+  }
+  auto const n = skat::num_players * cards_per_player;
+  hands[3] = {deck[n], deck[n + 1]};
+  skat game;
+  game.deal(hands[0], hands[1], hands[2], hands[3]);
+  return game;
+}
+
+/**
+ * Value after pushing two given cards.
+ */
+skat::value_type pushed_value(skat game, skat::player_type soloist, trump t, card first, card second) {
+  game.set_soloist(soloist);
+  game.declare(t);
+  game.apply_action(first);
+  game.apply_action(second);
+  return mws_binary_search(game).first;
+}
+
+}  // namespace
+
+TEST(skat_declaration, like_all_pushes) {
+  auto game = deal_small_game(3, 3);
+  auto table = skat_declaration_table(game, 2);
+  for (int t = 0; t < 5; ++t) {
+    for (skat::player_type soloist = 0; soloist < skat::num_players; ++soloist) {
+      skat g = game;
+      g.set_soloist(soloist);
+      auto const cards = g.legal_actions();
+      skat::value_type best = 0;
+      for (size_t i = 0; i < cards.size(); ++i) {
+        for (size_t j = 0; j < cards.size(); ++j) {
+          if (i == j) continue;
+          best = std::max(best, pushed_value(game, soloist, static_cast<trump>(t), cards[i], cards[j]));
+        }
+      }
+      auto const& d = table[t][soloist];
+      EXPECT_EQ(d.value, best) << "trump = " << t << " soloist = " << soloist;
+      EXPECT_EQ(pushed_value(game, soloist, static_cast<trump>(t), d.push[0], d.push[1]), best)
+          << "trump = " << t << " soloist = " << soloist;
+    }
+  }
+}
+
+TEST(skat_declaration, trumps_differ) {
+  // the soloist holds all clubs
+  skat game;
+  game.deal(to_hand("AcTcKcQc"), to_hand("AsTsKsQs"), to_hand("AhThKhQh"), to_hand("9c8c"));
+  auto table = skat_declaration_table(game, 1);
+  auto const clubs = static_cast<int>(trump::clubs);
+  auto const spades = static_cast<int>(trump::spades);
+  // in clubs the soloist ruffs and takes all eyes
+  EXPECT_EQ(table[clubs][0].value, 84);
+  EXPECT_LT(table[spades][0].value, table[clubs][0].value);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <golv/algorithms/alphabeta.hpp>
+#include <golv/algorithms/mws.hpp>
+#include <golv/games/deal_generator.hpp>
+#include <golv/games/skat_endgame.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "../util/temp_file.hpp"
+
+using namespace golv;
+
+namespace {
+
+// 12 cards, such that the table of 3 cards per player is small
+auto const small_deck = to_hand("JcJsAcTcKcAsTsKsAhTh7d8d");
+
+/**
+ * Deal three hands of k cards of the small deck at random, the skat is pushed right away (it is not in the deck).
+ */
+skat random_game(std::mt19937_64& rng, unsigned k, skat::player_type soloist, trump t) {
+  auto deck = small_deck;
+  std::shuffle(deck.begin(), deck.end(), rng);
+  skat game;
+  game.deal(hand(deck.begin(), deck.begin() + k), hand(deck.begin() + k, deck.begin() + 2 * k),
+            hand(deck.begin() + 2 * k, deck.begin() + 3 * k), to_hand("9dQd"));
+  game.set_soloist(soloist);
+  game.declare(t);
+  for (auto c : to_hand("9dQd")) game.apply_action(c);
+  return game;
+}
+
+}  // namespace
+
+TEST(skat_endgame, positions) {
+  EXPECT_EQ(skat_endgame_table::positions(32, 1), 4960 * 3 * 2 * 3);
+  EXPECT_EQ(skat_endgame_table::positions(32, 2), 906192ULL * 15 * 6 * 3);
+  EXPECT_EQ(skat_endgame_table::positions(12, 3), 220ULL * 84 * 20 * 3);
+
+  auto const table = skat_endgame_table::generate(hand_to_mask(small_deck), trump::hearts, 2, 2);
+  EXPECT_EQ(table.size(), skat_endgame_table::positions(12, 1) + skat_endgame_table::positions(12, 2));
+  EXPECT_EQ(table.max_cards(), 2);
+  EXPECT_THROW(skat_endgame_table::generate(hand_to_mask(small_deck), trump::hearts, 5), golv::exception);
+}
+
+TEST(skat_endgame, probe_like_search) {
+  std::mt19937_64 rng(1);
+  for (auto t : {trump::hearts, trump::grand}) {
+    auto const table = skat_endgame_table::generate(hand_to_mask(small_deck), t, 3);
+    for (int i = 0; i < 30; ++i) {
+      auto game = random_game(rng, 3, static_cast<skat::player_type>(i % 3), t);
+      auto const value = table.probe(game);
+      ASSERT_TRUE(value.has_value());
+      EXPECT_EQ(*value, alphabeta(game).first) << game;
+
+      // no value within a trick, after the trick the leader can be any player
+      auto const first = alphabeta(game).second;
+      game.apply_action(first);
+      EXPECT_FALSE(table.probe(game).has_value());
+      for (int j = 0; j < 2; ++j) game.apply_action(game.legal_actions().front());
+      ASSERT_TRUE(table.probe(game).has_value());
+      EXPECT_EQ(*table.probe(game), alphabeta(game).first) << game;
+    }
+  }
+}
+
+TEST(skat_endgame, probe_outside_table) {
+  auto const table = skat_endgame_table::generate(hand_to_mask(small_deck), trump::grand, 2);
+  std::mt19937_64 rng(2);
+  EXPECT_FALSE(table.probe(random_game(rng, 3, 0, trump::grand)).has_value());  // too many cards
+  EXPECT_FALSE(table.probe(random_game(rng, 2, 0, trump::clubs)).has_value());  // another trump
+  EXPECT_TRUE(table.probe(random_game(rng, 2, 0, trump::grand)).has_value());
+
+  skat game;
+  game.deal(to_hand("JcAc"), to_hand("Ks9s"), to_hand("AhTh"), to_hand("7d8d"));  // 9s is not in the deck
+  game.set_soloist(1);
+  game.declare(trump::grand);
+  EXPECT_FALSE(table.probe(game).has_value());  // pushing
+  for (auto c : to_hand("7d8d")) game.apply_action(c);
+  EXPECT_FALSE(table.probe(game).has_value());
+}
+
+TEST(skat_endgame, solvers_probe_table) {
+  auto const table = skat_endgame_table::generate(hand_to_mask(small_deck), trump::clubs, 2);
+  std::mt19937_64 rng(3);
+  for (int i = 0; i < 10; ++i) {
+    auto const game = random_game(rng, 4, static_cast<skat::player_type>(i % 3), trump::clubs);
+    alpha_beta plain(game, no_ordering{}, no_table<skat>{}, search_stats{});
+    alpha_beta probing(game, no_ordering{}, no_table<skat>{}, search_stats{}, table);
+    auto const value = plain.solve();
+    EXPECT_EQ(probing.solve(), value);
+    EXPECT_LT(probing.stats().nodes(), plain.stats().nodes());
+
+    minimal_window_search mws(game, mws_unordered_table<skat>{}, no_ordering{}, no_search_stats{}, table);
+    EXPECT_EQ(mws_binary_search(mws).first, game.value() + value);
+  }
+}
+
+using skat_endgame_file = temp_file_test;
+
+TEST_F(skat_endgame_file, save_and_open) {
+  auto const table = skat_endgame_table::generate(hand_to_mask(small_deck), trump::spades, 2);
+  table.save(path_);
+
+  skat_endgame_table const mapped(path_);
+  EXPECT_EQ(mapped.deck(), table.deck());
+  EXPECT_EQ(mapped.get_trump(), trump::spades);
+  EXPECT_EQ(mapped.size(), table.size());
+  std::mt19937_64 rng(4);
+  for (int i = 0; i < 20; ++i) {
+    auto const game = random_game(rng, 2, static_cast<skat::player_type>(i % 3), trump::spades);
+    EXPECT_EQ(mapped.probe(game), table.probe(game));
+  }
+
+  {
+    // a file of a machine with the other byte order
+    std::fstream file(path_, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offsetof(skat_endgame_header, byte_order));
+    std::uint32_t const swapped = 0x04030201;
+    file.write(reinterpret_cast<char const*>(&swapped), sizeof(swapped));
+  }
+  EXPECT_THROW(skat_endgame_table{path_}, golv::exception);
+  table.save(path_);
+
+  std::filesystem::resize_file(path_, std::filesystem::file_size(path_) - 1);
+  EXPECT_THROW(skat_endgame_table{path_}, golv::exception);
+  EXPECT_THROW(skat_endgame_table{path_ + ".missing"}, golv::exception);
+}
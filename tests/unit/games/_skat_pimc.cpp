@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <golv/algorithms/mws.hpp>
+#include <golv/games/skat_pimc.hpp>
+#include <golv/util/test_utils.hpp>
+
+using namespace golv;
+
+namespace {
+
+/**
+ * Three cards per player in a grand of player 0, the first trick shows that player 1 has no spades.
+ */
+skat game_after_first_trick() {
+  skat game;
+  game.deal(to_hand("As9sAh"), to_hand("KcKhQh"), to_hand("TsQsKs"), to_hand("7d8d"));
+  game.set_soloist(0);
+  game.declare(trump::grand);
+  game.apply_action(to_hand("7d")[0]);
+  game.apply_action(to_hand("8d")[0]);
+  for (auto c : to_hand("AsKcTs")) game.apply_action(c);
+  return game;
+}
+
+}  // namespace
+
+TEST(skat_pimc, view_of_game) {
+  auto game = game_after_first_trick();
+  auto view = skat_view::of(game, 2);
+  EXPECT_EQ(view.current_player(), 0);
+  EXPECT_EQ(view.hand.size(), 2);
+  EXPECT_TRUE(view.blinds.empty());
+  EXPECT_EQ(view.deck.size(), 11);
+  EXPECT_EQ(view.hidden_cards().size(), 6);
+  EXPECT_EQ(view.voids(1), 1 << static_cast<int>(suit::spades));
+  EXPECT_EQ(view.voids(2), 0);
+
+  // the soloist knows the skat
+  EXPECT_EQ(skat_view::of(game, 0).hidden_cards().size(), 4);
+
+  skat pushing;
+  pushing.deal(to_hand("As9sAh"), to_hand("KcKhQh"), to_hand("TsQsKs"), to_hand("7d8d"));
+  pushing.set_soloist(0);
+  EXPECT_THROW(skat_view::of(pushing, 0), golv::exception);
+}
+
+TEST(skat_pimc, samples_respect_voids) {
+  auto view = skat_view::of(game_after_first_trick(), 2);
+  std::mt19937_64 rng(1);
+  for (int i = 0; i < 50; ++i) {
+    auto g = view.sample(rng);
+    EXPECT_EQ(g.current_player(), 0);
+    EXPECT_EQ(g.tricks().front().cards_, view.tricks.front().cards_);
+    EXPECT_EQ(g.get_hand(2), view.hand);
+    for (auto c : g.get_hand(1)) EXPECT_NE(c.get_suit(), suit::spades);
+    EXPECT_EQ(g.get_hand(0).size() + g.get_hand(1).size() + g.blinds().size(), 6);
+  }
+}
+
+TEST(skat_pimc, unique_deal_is_exact) {
+  // player 1 has no spades: the hidden cards of the soloist's view are determined
+  auto game = game_after_first_trick();
+  auto result = pimc_move(skat_view::of(game, 0), 6, 2);
+  EXPECT_EQ(result.samples, 6);
+  ASSERT_EQ(result.moves.size(), 2);
+  for (size_t m = 0; m < result.moves.size(); ++m) {
+    skat g = game;
+    g.apply_action(result.moves[m]);
+    EXPECT_EQ(result.values[m], mws_binary_search(g).first) << result.moves[m];
+  }
+  EXPECT_EQ(result.values[0] >= result.values[1] ? result.moves[0] : result.moves[1], result.best_move);
+}
+
+TEST(skat_pimc, independent_of_threads) {
+  auto game = game_after_first_trick();
+  game.apply_action(to_hand("Ah")[0]);
+  auto view = skat_view::of(game, 1);
+  auto single = pimc_move(view, 10, 1);
+  auto pool = pimc_move(view, 10, 3);
+  EXPECT_EQ(single.samples, 10);
+  EXPECT_EQ(single.moves, pool.moves);
+  EXPECT_EQ(single.values, pool.values);
+  EXPECT_EQ(single.best_move, pool.best_move);
+}
+
+TEST(skat_pimc, time_budget) {
+  // full hands: the budget is used up during the first search, the incomplete samples are dropped
+  auto view = skat_view::of(skat_corpus(10, 1).front(), 0);
+  auto result = pimc_move(view, 100, 1, std::chrono::milliseconds{1});
+  EXPECT_EQ(result.samples, 0);
+  EXPECT_EQ(result.values, std::vector<double>(result.moves.size(), 0.0));
+  EXPECT_EQ(result.best_move, result.moves.front());
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+// instrumented build: keep all levels regardless of NDEBUG
+#undef GOLV_LOG_MIN_LEVEL
+#define GOLV_LOG_MIN_LEVEL 5
+
+#include <golv/util/async_logger.hpp>
+#include <golv/util/exception.hpp>
+#include <golv/util/logging.hpp>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace golv;
+
+namespace {
+
+/**
+ * Counts how often it is formatted.
+ */
+struct formatted {
+  int* count;
+};
+
+std::ostream& operator<<(std::ostream& os, formatted const& f) {
+  ++*f.count;
+  return os << "formatted";
+}
+
+struct capture_logger : public logger {
+  mutable std::mutex mutex;
+  mutable std::vector<std::string> messages;
+
+  void log(log_level lvl, const std::string& msg) const override {
+    if (!enabled(lvl)) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    messages.push_back(msg);
+  }
+};
+
+/**
+ * Installs a logger for the scope of a test.
+ */
+struct scoped_logger {
+  logger& previous;
+  explicit scoped_logger(logger& l) : previous(set_logger(l)) {}
+  ~scoped_logger() { set_logger(previous); }
+};
+
+}  // namespace
+
+TEST(logging, level_checked_before_formatting) {
+  capture_logger capture;
+  scoped_logger installed(capture);
+  capture.set_level(log_level::error);
+
+  int count = 0;
+  GOLV_LOG_TRACE(formatted{&count});
+  GOLV_LOG_DEBUG(formatted{&count});
+  EXPECT_EQ(count, 0);
+  EXPECT_TRUE(capture.messages.empty());
+
+  GOLV_LOG_ERROR(formatted{&count});
+  EXPECT_EQ(count, 1);
+  ASSERT_EQ(capture.messages.size(), 1);
+  EXPECT_EQ(capture.messages[0], "formatted\n");
+}
+
+TEST(logging, compile_time_min_level) {
+  capture_logger capture;
+  scoped_logger installed(capture);
+  capture.set_level(log_level::trace);
+
+  int count = 0;
+#undef GOLV_LOG_MIN_LEVEL
+#define GOLV_LOG_MIN_LEVEL 2  // warn
+  GOLV_LOG_TRACE(formatted{&count});
+  GOLV_LOG_INFO(formatted{&count});
+  GOLV_LOG_WARN(formatted{&count});
+#undef GOLV_LOG_MIN_LEVEL
+#define GOLV_LOG_MIN_LEVEL 5
+  EXPECT_EQ(count, 1);
+  EXPECT_EQ(capture.messages.size(), 1);
+}
+
+TEST(logging, async_logger) {
+  capture_logger capture;
+  constexpr int num_threads = 4;
+  constexpr int num_messages = 500;
+  {
+    async_logger async(capture, 4096);
+    scoped_logger installed(async);
+    async.set_level(log_level::debug);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([t] {
+        for (int i = 0; i < num_messages; ++i) {
+          GOLV_LOG_DEBUG(t << " " << i);
+          GOLV_LOG_TRACE("filtered");
+        }
+      });
+    }
+    for (auto& t : threads) t.join();
+    async.flush();
+    EXPECT_EQ(capture.messages.size() + async.dropped(), num_threads * num_messages);
+  }
+
+  // messages of one thread keep their order
+  std::vector<int> last(num_threads, -1);
+  for (auto const& msg : capture.messages) {
+    int t = 0, i = 0;
+    ASSERT_EQ(std::sscanf(msg.c_str(), "%d %d", &t, &i), 2);
+    EXPECT_GT(i, last[t]);
+    last[t] = i;
+  }
+}
+
+TEST(logging, async_logger_drops_when_full) {
+  capture_logger capture;
+  async_logger async(capture, 4);
+  async.set_level(log_level::trace);
+  for (int i = 0; i < 10000; ++i) async.log(log_level::info, "message\n");
+  async.flush();
+  EXPECT_EQ(capture.messages.size() + async.dropped(), 10000);
+  EXPECT_THROW({ async_logger invalid(capture, 3); }, golv::exception);
+}
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <golv/util/parallel_for.hpp>
+#include <stdexcept>
+#include <vector>
+
+using namespace golv;
+
+TEST(parallel_for, every_index_once) {
+  for (size_t threads : {0, 1, 3, 8}) {
+    std::vector<std::atomic<int>> calls(20);
+    parallel_for(calls.size(), threads, [&](size_t i) { ++calls[i]; });
+    for (auto const& c : calls) EXPECT_EQ(c, 1) << "threads = " << threads;
+  }
+  parallel_for(0, 4, [](size_t) { FAIL(); });
+}
+
+TEST(parallel_for, rethrow) {
+  std::atomic<int> calls{0};
+  EXPECT_THROW(parallel_for(10, 3,
+                            [&](size_t i) {
+                              ++calls;
+                              if (i == 4) throw std::runtime_error("task");
+                            }),
+               std::runtime_error);
+  // the other tasks still run
+  EXPECT_EQ(calls, 10);
+}
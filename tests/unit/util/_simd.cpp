@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <golv/util/simd.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace golv;
+
+namespace {
+
+constexpr double threshold = 1e-6;
+
+std::vector<double> reference_regret_matching(std::vector<double> const& regrets) {
+  std::vector<double> out(regrets.size());
+  double sum = 0.0;
+  for (size_t i = 0; i < regrets.size(); ++i) {
+    out[i] = std::max(regrets[i], 0.0);
+    sum += out[i];
+  }
+  for (auto& o : out) o = sum > threshold ? o / sum : 1.0 / regrets.size();
+  return out;
+}
+
+std::vector<double> random_values(size_t n, std::mt19937& gen) {
+  std::uniform_real_distribution<> dis(-1.0, 1.0);
+  std::vector<double> values(n);
+  for (auto& v : values) v = dis(gen);
+  return values;
+}
+
+/**
+ * Run the test body for all instruction sets supported by the CPU.
+ */
+template <class FunctionT>
+void for_each_instruction_set(FunctionT&& f) {
+  auto const before = simd::current_instruction_set();
+  for (auto is : {simd::instruction_set::scalar, simd::instruction_set::avx2}) {
+    if (!simd::set_instruction_set(is)) continue;
+    SCOPED_TRACE(static_cast<int>(is));
+    f();
+  }
+  simd::set_instruction_set(before);
+}
+
+}  // namespace
+
+TEST(simd, set_instruction_set) {
+  EXPECT_TRUE(simd::set_instruction_set(simd::instruction_set::scalar));
+  EXPECT_EQ(simd::current_instruction_set(), simd::instruction_set::scalar);
+  EXPECT_TRUE(simd::set_instruction_set(simd::best_instruction_set()));
+  EXPECT_EQ(simd::current_instruction_set(), simd::best_instruction_set());
+}
+
+TEST(simd, regret_matching) {
+  std::mt19937 gen(42);
+  for_each_instruction_set([&gen] {
+    for (size_t n = 1; n <= 17; ++n) {
+      auto regrets = random_values(n, gen);
+      std::vector<double> out(n);
+      simd::regret_matching(regrets.data(), out.data(), n, threshold);
+      auto expected = reference_regret_matching(regrets);
+      for (size_t i = 0; i < n; ++i) EXPECT_NEAR(out[i], expected[i], 1e-12);
+    }
+  });
+}
+
+TEST(simd, regret_matching_uniform) {
+  for_each_instruction_set([] {
+    std::vector<double> regrets{-1.0, 0.0, -2.0, -0.5, -3.0};
+    std::vector<double> out(regrets.size());
+    simd::regret_matching(regrets.data(), out.data(), regrets.size(), threshold);
+    for (auto o : out) EXPECT_DOUBLE_EQ(o, 0.2);
+  });
+}
+
+TEST(simd, normalize) {
+  for_each_instruction_set([] {
+    std::vector<double> sums{1.0, 3.0, 0.0, 2.0, 2.0, 0.0, 1.0, 1.0, 0.0};
+    std::vector<double> out(sums.size());
+    simd::normalize(sums.data(), out.data(), sums.size(), threshold);
+    for (size_t i = 0; i < sums.size(); ++i) EXPECT_DOUBLE_EQ(out[i], sums[i] / 10.0);
+    std::vector<double> zeros(3, 0.0);
+    simd::normalize(zeros.data(), out.data(), zeros.size(), threshold);
+    EXPECT_DOUBLE_EQ(out[2], 1.0 / 3.0);
+  });
+}
+
+TEST(simd, accumulate) {
+  std::mt19937 gen(7);
+  for_each_instruction_set([&gen] {
+    for (size_t n = 1; n <= 11; ++n) {
+      auto util = random_values(n, gen);
+      std::vector<double> regret_sum(n, 1.0);
+      simd::accumulate_regrets(regret_sum.data(), util.data(), 0.25, n);
+      for (size_t i = 0; i < n; ++i) EXPECT_DOUBLE_EQ(regret_sum[i], 1.0 + (util[i] - 0.25));
+      std::vector<double> strategy_sum(n, 1.0);
+      simd::accumulate_strategy(strategy_sum.data(), util.data(), 0.5, n);
+      for (size_t i = 0; i < n; ++i) EXPECT_DOUBLE_EQ(strategy_sum[i], 1.0 + 0.5 * util[i]);
+    }
+  });
+}
+
+// count infosets with n actions, transposed with padding that must not be written
+TEST(simd, regret_matching_soa) {
+  std::mt19937 gen(3);
+  for_each_instruction_set([&gen] {
+    for (size_t n : {1, 2, 3, 5}) {
+      for (size_t count : {1, 3, 4, 6, 9}) {
+        auto const stride = count + 2;
+        auto regrets = random_values(n * stride, gen);
+        for (size_t a = 0; a < n; ++a) regrets[a * stride + count / 2] = -1.0;  // uniform
+        std::vector<double> out(n * stride, 7.0);
+        simd::regret_matching_soa(regrets.data(), out.data(), n, count, stride, threshold);
+        std::vector<double> sums(n * stride, 7.0);
+        simd::normalize_soa(out.data(), sums.data(), n, count, stride, threshold);
+        for (size_t i = 0; i < stride; ++i) {
+          std::vector<double> infoset(n);
+          for (size_t a = 0; a < n; ++a) infoset[a] = regrets[a * stride + i];
+          auto expected = reference_regret_matching(infoset);
+          for (size_t a = 0; a < n; ++a) {
+            if (i < count) {
+              EXPECT_NEAR(out[a * stride + i], expected[a], 1e-12);
+              EXPECT_NEAR(sums[a * stride + i], expected[a], 1e-12);
+            } else {
+              EXPECT_EQ(out[a * stride + i], 7.0);
+              EXPECT_EQ(sums[a * stride + i], 7.0);
+            }
+          }
+        }
+      }
+    }
+  });
+}
+
+TEST(simd, accumulate_soa) {
+  std::mt19937 gen(5);
+  for_each_instruction_set([&gen] {
+    for (size_t n : {1, 2, 3, 4}) {
+      for (size_t count : {2, 4, 7}) {
+        auto const stride = count + 1;
+        auto const values = random_values(n * stride, gen);
+        auto const scalars = random_values(stride, gen);
+        std::vector<double> regret_sums(n * stride, 1.0);
+        std::vector<double> strategy_sums(n * stride, 1.0);
+        simd::accumulate_regrets_soa(regret_sums.data(), values.data(), scalars.data(), n, count, stride);
+        simd::accumulate_strategy_soa(strategy_sums.data(), values.data(), scalars.data(), n, count, stride);
+        for (size_t a = 0; a < n; ++a) {
+          for (size_t i = 0; i < stride; ++i) {
+            auto const j = a * stride + i;
+            EXPECT_DOUBLE_EQ(regret_sums[j], i < count ? 1.0 + (values[j] - scalars[i]) : 1.0);
+            EXPECT_DOUBLE_EQ(strategy_sums[j], i < count ? 1.0 + scalars[i] * values[j] : 1.0);
+          }
+        }
+      }
+    }
+  });
+}
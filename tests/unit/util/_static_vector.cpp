@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <golv/games/cards.hpp>
+#include <golv/util/exception.hpp>
+#include <golv/util/static_vector.hpp>
+#include <sstream>
+#include <vector>
+
+using namespace golv;
+
+TEST(static_vector, push_back)
+{
+  static_vector<int, 4> v;
+  EXPECT_TRUE(v.empty());
+  EXPECT_EQ(v.capacity(), 4);
+  v.push_back(3);
+  v.push_back(1);
+  v.emplace_back(2);
+  ASSERT_EQ(v.size(), 3);
+  EXPECT_EQ(v.front(), 3);
+  EXPECT_EQ(v.back(), 2);
+  std::sort(v.begin(), v.end());
+  EXPECT_EQ(v, (static_vector<int, 4>{1, 2, 3}));
+  v.pop_back();
+  EXPECT_EQ(v.size(), 2);
+  v.clear();
+  EXPECT_TRUE(v.empty());
+}
+
+TEST(static_vector, range)
+{
+  std::vector<int> source = {5, 6, 7, 8};
+  static_vector<int, 4> v(source.begin() + 1, source.end());
+  ASSERT_EQ(v.size(), 3);
+  EXPECT_TRUE(std::equal(v.begin(), v.end(), source.begin() + 1));
+  v.erase(v.begin());
+  EXPECT_EQ(v, (static_vector<int, 4>{7, 8}));
+  EXPECT_EQ(std::vector<int>(v.rbegin(), v.rend()), (std::vector<int>{8, 7}));
+}
+
+TEST(static_vector, capacity_exceeded)
+{
+  std::vector<int> source = {1, 2, 3};
+  EXPECT_THROW((static_vector<int, 2>(source.begin(), source.end())), golv::exception);
+  static_vector<int, 2> v = {1, 2};
+  EXPECT_THROW(v.push_back(3), golv::exception);
+}
+
+TEST(static_vector, cards)
+{
+  hand h = to_hand("Ac Kc Qc");
+  static_vector<card, 13> v(h.begin(), h.end());
+  std::ostringstream os;
+  os << v;
+  EXPECT_EQ(os.str(), to_string(h));
+  static_assert(sizeof(static_vector<card, 13>) == 13 * sizeof(card) + 1);  // one byte for the size
+}
+
+TEST(static_vector, size_type)
+{
+  static_assert(sizeof(static_vector<std::uint8_t, 255>) == 256);
+  static_assert(sizeof(static_vector<std::uint8_t, 256>) == 258);
+  static_assert(sizeof(static_vector<std::uint32_t, 70000>) == 70000 * 4 + sizeof(size_t));
+  static_vector<int, 300> v;
+  for (int i = 0; i < 300; ++i) v.push_back(i);
+  EXPECT_EQ(v.size(), 300);
+  EXPECT_EQ(v.back(), 299);
+}
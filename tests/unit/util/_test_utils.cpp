@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <golv/util/test_utils.hpp>
+
+using namespace golv;
+
+TEST(test_utils, shuffle_deck_is_portable)
+{
+  // pinned, such that the deal corpora of the benchmarks are the same on every platform
+  auto deck = shuffle_deck(create_skat_deck(), 1);
+  ASSERT_EQ(deck.size(), 32);
+  EXPECT_EQ(to_string(hand(deck.begin(), deck.begin() + 5)), to_string(hand{"Kc", "9h", "Qs", "Th", "Ac"}));
+
+  auto sorted = deck;
+  auto expected = create_skat_deck();
+  auto less = [](card const& l, card const& r) { return l.code().to_ullong() < r.code().to_ullong(); };
+  std::sort(sorted.begin(), sorted.end(), less);
+  std::sort(expected.begin(), expected.end(), less);
+  EXPECT_EQ(to_string(sorted), to_string(expected));
+}
+
+TEST(test_utils, corpus_is_reproducible)
+{
+  auto first = skat_corpus(5, 3);
+  auto second = skat_corpus(5, 3);
+  ASSERT_EQ(first.size(), 3);
+  for (size_t i = 0; i < first.size(); ++i) {
+    EXPECT_EQ(first[i].state(), second[i].state());
+  }
+  EXPECT_NE(first[0].state(), first[1].state());
+  // the corpus continues with the next seeds
+  EXPECT_EQ(skat_corpus(5, 1, 2).front().state(), first[1].state());
+
+  auto bridges = bridge_corpus(4, 2);
+  EXPECT_EQ(bridges[0].state(), bridge_corpus(4, 1).front().state());
+  EXPECT_NE(bridges[0].state(), bridges[1].state());
+}
+
+TEST(test_utils, unique_temp_path)
+{
+  auto const path = unique_temp_path("name");
+  EXPECT_NE(path.find("golv_name_"), std::string::npos);
+  EXPECT_EQ(path, unique_temp_path("name"));
+  EXPECT_NE(path, unique_temp_path("other"));
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <golv/util/test_utils.hpp>
+#include <string>
+
+/**
+ * temp_file_test gives every test its own file path (see unique_temp_path()) built from the names of the
+ * suite and the test. The file and the temporary file of an interrupted write (path + ".tmp") are removed
+ * after the test.
+ */
+class temp_file_test : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto const* info = ::testing::UnitTest::GetInstance()->current_test_info();
+    path_ = unique_temp_path(std::string(info->test_suite_name()) + "_" + info->name());
+  }
+
+  void TearDown() override {
+    std::filesystem::remove(path_);
+    std::filesystem::remove(path_ + ".tmp");
+  }
+
+  std::string path_;
+};